@@ -36,6 +36,7 @@
 
 #pragma GCC system_header
 
+#include <bits/char_set_search.h>
 #include <debug/debug.h>
 #include <ext/alloc_traits.h>
 #include <ext/atomicity.h>
@@ -826,6 +827,24 @@ public:
   void
   resize(size_type __n) { this->resize(__n, _CharT()); }
 
+#if __cplusplus >= 201103L
+  /**
+       *  @brief  Resize the %string and let @a __op write its contents.
+       *  @param  __n  Number of characters @a __op may write.
+       *  @param  __op  Callable invoked as @c __op(data(), __n).
+       *  @throw  std::length_error  If @a __n exceeds @c max_size().
+       *
+       *  Ensures capacity() is at least @a __n without initializing the
+       *  characters past size(), then calls @a __op with a pointer to the
+       *  buffer and @a __n.  The value returned by @a __op, which must not
+       *  exceed @a __n, becomes the new size().  The first size() characters
+       *  are preserved on entry, so @a __op may also read them.
+       */
+  template <typename _Operation>
+  void
+  resize_and_overwrite(size_type __n, _Operation __op);
+#endif
+
 #if __cplusplus >= 201103L
   ///  A non-binding request to reduce capacity() to size().
   void
@@ -2826,6 +2845,23 @@ basic_string(basic_string_view<_CharT, _Traits>,
 _GLIBCXX_END_NAMESPACE_CXX11
 #endif
 
+// Builds __lhs followed by __rhs with a single allocation, using a copy
+// of __a as a copy of the left operand would.
+template <typename _Str>
+_Str
+__str_concat(const typename _Str::value_type* __lhs,
+             typename _Str::size_type __lhs_len,
+             const typename _Str::value_type* __rhs,
+             typename _Str::size_type __rhs_len,
+             const typename _Str::allocator_type& __a) {
+  typedef __gnu_cxx::__alloc_traits<typename _Str::allocator_type> _Alloc_traits;
+  _Str __str(_Alloc_traits::_S_select_on_copy(__a));
+  __str.reserve(__lhs_len + __rhs_len);
+  __str.append(__lhs, __lhs_len);
+  __str.append(__rhs, __rhs_len);
+  return __str;
+}
+
 // operator+
 /**
    *  @brief  Concatenate two strings.
@@ -2837,9 +2873,10 @@ template <typename _CharT, typename _Traits, typename _Alloc>
 basic_string<_CharT, _Traits, _Alloc>
 operator+(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
           const basic_string<_CharT, _Traits, _Alloc>& __rhs) {
-  basic_string<_CharT, _Traits, _Alloc> __str(__lhs);
-  __str.append(__rhs);
-  return __str;
+  typedef basic_string<_CharT, _Traits, _Alloc> _Str;
+  return std::__str_concat<_Str>(__lhs.c_str(), __lhs.size(),
+                                 __rhs.c_str(), __rhs.size(),
+                                 __lhs.get_allocator());
 }
 
 /**
@@ -2873,9 +2910,11 @@ template <typename _CharT, typename _Traits, typename _Alloc>
 inline basic_string<_CharT, _Traits, _Alloc>
 operator+(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
           const _CharT* __rhs) {
-  basic_string<_CharT, _Traits, _Alloc> __str(__lhs);
-  __str.append(__rhs);
-  return __str;
+  __glibcxx_requires_string(__rhs);
+  typedef basic_string<_CharT, _Traits, _Alloc> _Str;
+  return std::__str_concat<_Str>(__lhs.c_str(), __lhs.size(),
+                                 __rhs, _Traits::length(__rhs),
+                                 __lhs.get_allocator());
 }
 
 /**
@@ -2887,11 +2926,10 @@ operator+(const basic_string<_CharT, _Traits, _Alloc>& __lhs,
 template <typename _CharT, typename _Traits, typename _Alloc>
 inline basic_string<_CharT, _Traits, _Alloc>
 operator+(const basic_string<_CharT, _Traits, _Alloc>& __lhs, _CharT __rhs) {
-  typedef basic_string<_CharT, _Traits, _Alloc> __string_type;
-  typedef typename __string_type::size_type __size_type;
-  __string_type __str(__lhs);
-  __str.append(__size_type(1), __rhs);
-  return __str;
+  typedef basic_string<_CharT, _Traits, _Alloc> _Str;
+  return std::__str_concat<_Str>(__lhs.c_str(), __lhs.size(),
+                                 &__rhs, 1,
+                                 __lhs.get_allocator());
 }
 
 #if __cplusplus >= 201103L
@@ -301,6 +301,30 @@ void basic_string<_CharT, _Traits, _Alloc>::
     this->_M_set_length(__n);
 }
 
+#if __cplusplus >= 201103L
+template <typename _CharT, typename _Traits, typename _Alloc>
+template <typename _Operation>
+void basic_string<_CharT, _Traits, _Alloc>::
+    resize_and_overwrite(size_t __n, _Operation __op) {
+  if (__n > this->capacity()) {
+    _M_check_length(this->size(), __n, "basic_string::resize_and_overwrite");
+    this->reserve(__n);
+  }
+
+  // Keep the string well-formed if __op throws: its contents are then
+  // unspecified, so drop them rather than expose uninitialized characters.
+  struct _Terminator {
+    ~_Terminator() { _M_this->_M_set_length(_M_r); }
+    basic_string* _M_this;
+    size_t _M_r;
+  };
+  _Terminator __term{this, 0};
+  const size_t __r = std::move(__op)(_M_data(), __n);
+  __glibcxx_assert(__r <= __n);
+  __term._M_r = __r;
+}
+#endif
+
 template <typename _CharT, typename _Traits, typename _Alloc>
 basic_string<_CharT, _Traits, _Alloc>&
 basic_string<_CharT, _Traits, _Alloc>::
@@ -1122,6 +1146,8 @@ typename basic_string<_CharT, _Traits, _Alloc>::size_t
 basic_string<_CharT, _Traits, _Alloc>::
     find_first_of(const _CharT* __s, size_t __pos, size_t __n) const noexcept {
   __glibcxx_requires_string_len(__s, __n);
+  if (__char_set_search<_Traits>::_S_usable(this->size()))
+    return __char_set_search<_Traits>::_S_find_first(this->data(), this->size(), __pos, __s, __n, true);
   for (; __n && __pos < this->size(); ++__pos) {
     const _CharT* __p = traits_type::find(__s, __n, _M_data()[__pos]);
     if (__p)
@@ -1135,6 +1161,8 @@ typename basic_string<_CharT, _Traits, _Alloc>::size_t
 basic_string<_CharT, _Traits, _Alloc>::
     find_last_of(const _CharT* __s, size_t __pos, size_t __n) const noexcept {
   __glibcxx_requires_string_len(__s, __n);
+  if (__char_set_search<_Traits>::_S_usable(this->size()))
+    return __char_set_search<_Traits>::_S_find_last(this->data(), this->size(), __pos, __s, __n, true);
   size_t __size = this->size();
   if (__size && __n) {
     if (--__size > __pos)
@@ -1152,6 +1180,8 @@ typename basic_string<_CharT, _Traits, _Alloc>::size_t
 basic_string<_CharT, _Traits, _Alloc>::
     find_first_not_of(const _CharT* __s, size_t __pos, size_t __n) const noexcept {
   __glibcxx_requires_string_len(__s, __n);
+  if (__char_set_search<_Traits>::_S_usable(this->size()))
+    return __char_set_search<_Traits>::_S_find_first(this->data(), this->size(), __pos, __s, __n, false);
   for (; __pos < this->size(); ++__pos)
     if (!traits_type::find(__s, __n, _M_data()[__pos]))
       return __pos;
@@ -1173,6 +1203,8 @@ typename basic_string<_CharT, _Traits, _Alloc>::size_t
 basic_string<_CharT, _Traits, _Alloc>::
     find_last_not_of(const _CharT* __s, size_t __pos, size_t __n) const noexcept {
   __glibcxx_requires_string_len(__s, __n);
+  if (__char_set_search<_Traits>::_S_usable(this->size()))
+    return __char_set_search<_Traits>::_S_find_last(this->data(), this->size(), __pos, __s, __n, false);
   size_t __size = this->size();
   if (__size) {
     if (--__size > __pos)
@@ -0,0 +1,306 @@
+// Substring search over bytes -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/byte_search.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{algorithm}
+ */
+
+#ifndef _BYTE_SEARCH_H
+#define _BYTE_SEARCH_H 1
+
+#pragma GCC system_header
+
+#include <bits/c++config.h>
+
+#if (defined __x86_64__ || defined __i386__) && defined __SSE2__ \
+    && !defined _GLIBCXX_NO_SIMD_CHAR_TRAITS
+#define _GLIBCXX_SIMD_BYTE_SEARCH 1
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default) {
+
+  /**
+   *  Crochemore-Perrin Two-Way matcher.  After O(m) preprocessing it finds
+   *  the first occurrence of the pattern in O(n + m) time with constant
+   *  extra space, whatever the input.
+   */
+  struct __two_way_matcher {
+    const unsigned char* _M_pat;
+    size_t _M_len;
+    size_t _M_suffix; // Start of the right half of the critical factorization.
+    size_t _M_period; // Period of the pattern, or the shift for non-periodic ones.
+    bool _M_periodic;
+
+    __two_way_matcher(const unsigned char* __p, size_t __m)
+        : _M_pat(__p), _M_len(__m), _M_suffix(0), _M_period(1), _M_periodic(false) {
+      if (__m < 2)
+        return;
+      size_t __period, __period_rev;
+      const size_t __ms = _S_max_suffix(__p, __m, __period, false);
+      const size_t __ms_rev = _S_max_suffix(__p, __m, __period_rev, true);
+      // The later of the two maximal suffixes gives a critical
+      // factorization.  size_t(-1) stands for "before the start".
+      if (__ms_rev + 1 < __ms + 1) {
+        _M_suffix = __ms + 1;
+      } else {
+        _M_suffix = __ms_rev + 1;
+        __period = __period_rev;
+      }
+      if (__builtin_memcmp(__p, __p + __period, _M_suffix) == 0) {
+        _M_period = __period;
+        _M_periodic = true;
+      } else {
+        const size_t __right = __m - _M_suffix;
+        _M_period = (_M_suffix > __right ? _M_suffix : __right) + 1;
+      }
+    }
+
+    // Position before the maximal suffix of [__p, __p + __m) under the
+    // byte order (or its reverse), and the period of that suffix.
+    static size_t
+    _S_max_suffix(const unsigned char* __p, size_t __m, size_t& __period, bool __reverse) {
+      size_t __ms = size_t(-1);
+      size_t __j = 0, __k = 1;
+      __period = 1;
+      while (__j + __k < __m) {
+        const unsigned char __a = __p[__j + __k];
+        const unsigned char __b = __p[__ms + __k];
+        if (__reverse ? __a > __b : __a < __b) {
+          __j += __k;
+          __k = 1;
+          __period = __j - __ms;
+        } else if (__a == __b) {
+          if (__k != __period)
+            ++__k;
+          else {
+            __j += __period;
+            __k = 1;
+          }
+        } else {
+          __ms = __j++;
+          __k = __period = 1;
+        }
+      }
+      return __ms;
+    }
+
+    // First occurrence in [__h, __h + __n), or null.  Requires _M_len >= 2.
+    const unsigned char*
+    _M_search(const unsigned char* __h, size_t __n) const {
+      const unsigned char* const __p = _M_pat;
+      const size_t __m = _M_len;
+      if (__n < __m)
+        return 0;
+      const size_t __last = __n - __m;
+      size_t __j = 0;
+      if (_M_periodic) {
+        // A mismatch in the left half only shifts by the period, so
+        // remember how much of the right half is known to match.
+        size_t __memory = 0;
+        while (__j <= __last) {
+          size_t __i = _M_suffix > __memory ? _M_suffix : __memory;
+          while (__i < __m && __p[__i] == __h[__i + __j])
+            ++__i;
+          if (__i < __m) {
+            __j += __i - _M_suffix + 1;
+            __memory = 0;
+            continue;
+          }
+          __i = _M_suffix;
+          while (__i > __memory && __p[__i - 1] == __h[__i - 1 + __j])
+            --__i;
+          if (__i <= __memory)
+            return __h + __j;
+          __j += _M_period;
+          __memory = __m - _M_period;
+        }
+      } else {
+        while (__j <= __last) {
+          size_t __i = _M_suffix;
+          while (__i < __m && __p[__i] == __h[__i + __j])
+            ++__i;
+          if (__i < __m) {
+            __j += __i - _M_suffix + 1;
+            continue;
+          }
+          __i = _M_suffix;
+          while (__i > 0 && __p[__i - 1] == __h[__i - 1 + __j])
+            --__i;
+          if (__i == 0)
+            return __h + __j;
+          __j += _M_period;
+        }
+      }
+      return 0;
+    }
+  };
+
+  // Patterns up to this length are located with the first/last byte
+  // prefilter; longer ones go straight to Two-Way.
+  const size_t __byte_search_prefilter_max = 64;
+
+  // Verification work the prefilter may spend before handing over to
+  // Two-Way, given that it has examined __i positions.  Keeps the total
+  // linear in the haystack length.
+  inline bool
+  __byte_search_over_budget(size_t __cost, size_t __i, size_t __m) { return __cost > 2 * __i + 32 * __m; }
+
+#ifdef _GLIBCXX_SIMD_BYTE_SEARCH
+  typedef char __byte_search_v16 __attribute__((__vector_size__(16)));
+
+  // Compare 16 candidate positions at once against the first and last
+  // byte of the pattern and verify only those that match both.  Stops at
+  // a match, when fewer than 16 positions remain, or when over budget;
+  // __i is then the first position not yet examined.
+  inline const unsigned char*
+  __byte_prefilter_sse2(const unsigned char* __h, size_t __n,
+                        const unsigned char* __p, size_t __m,
+                        size_t& __i, size_t& __cost) {
+    __byte_search_v16 __vf, __vl;
+    __builtin_memset(&__vf, __p[0], 16);
+    __builtin_memset(&__vl, __p[__m - 1], 16);
+    for (; __i + __m - 1 + 16 <= __n; __i += 16) {
+      __byte_search_v16 __a, __b;
+      __builtin_memcpy(&__a, __h + __i, 16);
+      __builtin_memcpy(&__b, __h + __i + __m - 1, 16);
+      unsigned __mask = __builtin_ia32_pmovmskb128((__byte_search_v16)((__a == __vf) & (__b == __vl)));
+      for (; __mask; __mask &= __mask - 1) {
+        const size_t __j = __i + __builtin_ctz(__mask);
+        __cost += __m;
+        if (__builtin_memcmp(__h + __j + 1, __p + 1, __m - 2) == 0)
+          return __h + __j;
+      }
+      if (__byte_search_over_budget(__cost, __i + 16, __m)) {
+        __i += 16;
+        break;
+      }
+    }
+    return 0;
+  }
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+  typedef char __byte_search_v32 __attribute__((__vector_size__(32)));
+
+  // As __byte_prefilter_sse2, 32 positions at a time.
+  inline const unsigned char*
+  __byte_prefilter_avx2(const unsigned char* __h, size_t __n,
+                        const unsigned char* __p, size_t __m,
+                        size_t& __i, size_t& __cost) {
+    __byte_search_v32 __vf, __vl;
+    __builtin_memset(&__vf, __p[0], 32);
+    __builtin_memset(&__vl, __p[__m - 1], 32);
+    for (; __i + __m - 1 + 32 <= __n; __i += 32) {
+      __byte_search_v32 __a, __b;
+      __builtin_memcpy(&__a, __h + __i, 32);
+      __builtin_memcpy(&__b, __h + __i + __m - 1, 32);
+      unsigned __mask = __builtin_ia32_pmovmskb256((__byte_search_v32)((__a == __vf) & (__b == __vl)));
+      for (; __mask; __mask &= __mask - 1) {
+        const size_t __j = __i + __builtin_ctz(__mask);
+        __cost += __m;
+        if (__builtin_memcmp(__h + __j + 1, __p + 1, __m - 2) == 0)
+          return __h + __j;
+      }
+      if (__byte_search_over_budget(__cost, __i + 32, __m)) {
+        __i += 32;
+        break;
+      }
+    }
+    return 0;
+  }
+
+#pragma GCC pop_options
+#endif // _GLIBCXX_SIMD_BYTE_SEARCH
+
+  /**
+   *  First/last byte prefilter for patterns of 2 to
+   *  __byte_search_prefilter_max bytes.  Returns the first match, or null
+   *  with __i set to where the search must continue: past the last
+   *  candidate position if the haystack was exhausted, otherwise the
+   *  position from which Two-Way has to take over because verification
+   *  became too expensive.
+   */
+  inline const unsigned char*
+  __byte_prefilter(const unsigned char* __h, size_t __n,
+                   const unsigned char* __p, size_t __m, size_t& __i) {
+    size_t __cost = 0;
+    __i = 0;
+#ifdef _GLIBCXX_SIMD_BYTE_SEARCH
+    const unsigned char* __r = 0;
+    if (__n >= __m + 64 && __builtin_cpu_supports("avx2"))
+      __r = std::__byte_prefilter_avx2(__h, __n, __p, __m, __i, __cost);
+    else
+      __r = std::__byte_prefilter_sse2(__h, __n, __p, __m, __i, __cost);
+    if (__r)
+      return __r;
+#endif
+    const unsigned char __first = __p[0];
+    const unsigned char __last = __p[__m - 1];
+    for (; __i + __m <= __n; ++__i) {
+      if (__byte_search_over_budget(__cost, __i, __m))
+        return 0;
+      if (__h[__i] == __first && __h[__i + __m - 1] == __last) {
+        __cost += __m;
+        if (__builtin_memcmp(__h + __i + 1, __p + 1, __m - 2) == 0)
+          return __h + __i;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   *  First occurrence of [__p, __p + __m) in [__h, __h + __n), or null.
+   *  Uses memchr for single bytes, the prefilter for short patterns and
+   *  Two-Way otherwise; worst-case time is O(n + m).  @a __tw, if not
+   *  null, is a matcher already built for the pattern.
+   */
+  inline const unsigned char*
+  __byte_search(const unsigned char* __h, size_t __n,
+                const unsigned char* __p, size_t __m,
+                const __two_way_matcher* __tw = 0) {
+    if (__m == 0)
+      return __h;
+    if (__m > __n)
+      return 0;
+    if (__m == 1)
+      return static_cast<const unsigned char*>(__builtin_memchr(__h, __p[0], __n));
+    if (__m <= __byte_search_prefilter_max) {
+      size_t __i;
+      if (const unsigned char* __r = std::__byte_prefilter(__h, __n, __p, __m, __i))
+        return __r;
+      if (__i + __m > __n)
+        return 0;
+      __h += __i;
+      __n -= __i;
+    }
+    if (__tw)
+      return __tw->_M_search(__h, __n);
+    return __two_way_matcher(__p, __m)._M_search(__h, __n);
+  }
+
+} // namespace )
+
+#endif // _BYTE_SEARCH_H
@@ -0,0 +1,278 @@
+// Character set search for find_first_of and friends -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/char_set_search.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{string}
+ */
+
+#ifndef _CHAR_SET_SEARCH_H
+#define _CHAR_SET_SEARCH_H 1
+
+#pragma GCC system_header
+
+#include <bits/stringfwd.h>
+
+#if (defined __x86_64__ || defined __i386__) && !defined _GLIBCXX_NO_SIMD_CHAR_TRAITS
+#define _GLIBCXX_SIMD_CHAR_SET 1
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default) {
+
+  /**
+   *  Membership set of single-byte characters.  The 256-bit bitmap serves
+   *  scalar lookups.  The same set is also kept as two 16-byte rows for
+   *  pshufb: byte @a c is a member iff bit <tt>(c >> 4) & 7</tt> of
+   *  <tt>_M_rows[c >> 7][c & 15]</tt> is set.
+   */
+  struct __char_set {
+    unsigned long long _M_bits[4];
+    unsigned char _M_rows[2][16];
+
+    __char_set(const char* __s, size_t __n) {
+      __builtin_memset(this, 0, sizeof(*this));
+      for (; __n; ++__s, --__n) {
+        const unsigned char __c = *__s;
+        _M_bits[__c >> 6] |= 1ULL << (__c & 63);
+        _M_rows[__c >> 7][__c & 15] |= 1 << ((__c >> 4) & 7);
+      }
+    }
+
+    bool
+    _M_test(char __c) const {
+      const unsigned char __u = __c;
+      return (_M_bits[__u >> 6] >> (__u & 63)) & 1;
+    }
+
+    // Index of the first character in [__s, __s + __n) whose membership
+    // equals __match, or __n if there is none.
+    size_t
+    _M_find(const char* __s, size_t __n, bool __match) const;
+
+    // Index of the last such character, or __n if there is none.
+    size_t
+    _M_rfind(const char* __s, size_t __n, bool __match) const;
+
+    size_t
+    _M_find_scalar(const char* __s, size_t __n, size_t __i, bool __match) const {
+      for (; __i < __n; ++__i)
+        if (_M_test(__s[__i]) == __match)
+          return __i;
+      return __n;
+    }
+
+    size_t
+    _M_rfind_scalar(const char* __s, size_t __n, size_t __i, bool __match) const {
+      while (__i--)
+        if (_M_test(__s[__i]) == __match)
+          return __i;
+      return __n;
+    }
+  };
+
+#ifdef _GLIBCXX_SIMD_CHAR_SET
+#pragma GCC push_options
+#pragma GCC target("ssse3")
+
+  typedef char __char_set_v16 __attribute__((__vector_size__(16)));
+  typedef unsigned short __char_set_v8hu __attribute__((__vector_size__(16)));
+
+  // Bit i of the result is set iff __p[i] is a member of __set.
+  __attribute__((__always_inline__)) inline unsigned
+  __char_set_mask_ssse3(const __char_set& __set, const char* __p) {
+    const __char_set_v16 __bit = {1, 2, 4, 8, 16, 32, 64, -128,
+                                  1, 2, 4, 8, 16, 32, 64, -128};
+    __char_set_v16 __v, __row0, __row1;
+    __builtin_memcpy(&__v, __p, 16);
+    __builtin_memcpy(&__row0, __set._M_rows[0], 16);
+    __builtin_memcpy(&__row1, __set._M_rows[1], 16);
+    const __char_set_v16 __lo = __v & 0x0f;
+    const __char_set_v16 __hi = (__char_set_v16)((__char_set_v8hu)__v >> 4) & 0x0f;
+    const __char_set_v16 __upper = (__char_set_v16)(__hi > 7);
+    const __char_set_v16 __row = (__builtin_ia32_pshufb128(__row0, __lo) & ~__upper)
+                                 | (__builtin_ia32_pshufb128(__row1, __lo) & __upper);
+    const __char_set_v16 __hit = (__char_set_v16)((__row & __builtin_ia32_pshufb128(__bit, __hi)) != 0);
+    return __builtin_ia32_pmovmskb128(__hit);
+  }
+
+  inline size_t
+  __char_set_find_ssse3(const __char_set& __set, const char* __s, size_t __n, bool __match) {
+    const unsigned __flip = __match ? 0 : 0xffff;
+    size_t __i = 0;
+    for (; __i + 16 <= __n; __i += 16)
+      if (const unsigned __m = __char_set_mask_ssse3(__set, __s + __i) ^ __flip)
+        return __i + __builtin_ctz(__m);
+    if (__i == __n)
+      return __n;
+    // Finish with a block overlapping the part already searched.
+    __i = __n - 16;
+    const unsigned __m = __char_set_mask_ssse3(__set, __s + __i) ^ __flip;
+    return __m ? __i + __builtin_ctz(__m) : __n;
+  }
+
+  inline size_t
+  __char_set_rfind_ssse3(const __char_set& __set, const char* __s, size_t __n, bool __match) {
+    const unsigned __flip = __match ? 0 : 0xffff;
+    size_t __i = __n;
+    for (; __i >= 16; __i -= 16)
+      if (const unsigned __m = __char_set_mask_ssse3(__set, __s + __i - 16) ^ __flip)
+        return __i - 1 - (__builtin_clz(__m) - 16);
+    if (__i == 0)
+      return __n;
+    const unsigned __m = __char_set_mask_ssse3(__set, __s) ^ __flip;
+    return __m ? 31 - __builtin_clz(__m) : __n;
+  }
+
+#pragma GCC target("avx2")
+
+  typedef char __char_set_v32 __attribute__((__vector_size__(32)));
+  typedef unsigned short __char_set_v16hu __attribute__((__vector_size__(32)));
+
+  // As __char_set_mask_ssse3 for 32 bytes.  vpshufb looks up within each
+  // 16-byte lane, so the rows are repeated in both lanes.
+  __attribute__((__always_inline__)) inline unsigned
+  __char_set_mask_avx2(const __char_set& __set, const char* __p) {
+    const __char_set_v32 __bit = {1, 2, 4, 8, 16, 32, 64, -128,
+                                  1, 2, 4, 8, 16, 32, 64, -128,
+                                  1, 2, 4, 8, 16, 32, 64, -128,
+                                  1, 2, 4, 8, 16, 32, 64, -128};
+    __char_set_v32 __v, __row0, __row1;
+    __builtin_memcpy(&__v, __p, 32);
+    __builtin_memcpy(&__row0, __set._M_rows[0], 16);
+    __builtin_memcpy(reinterpret_cast<char*>(&__row0) + 16, __set._M_rows[0], 16);
+    __builtin_memcpy(&__row1, __set._M_rows[1], 16);
+    __builtin_memcpy(reinterpret_cast<char*>(&__row1) + 16, __set._M_rows[1], 16);
+    const __char_set_v32 __lo = __v & 0x0f;
+    const __char_set_v32 __hi = (__char_set_v32)((__char_set_v16hu)__v >> 4) & 0x0f;
+    const __char_set_v32 __upper = (__char_set_v32)(__hi > 7);
+    const __char_set_v32 __row = (__builtin_ia32_pshufb256(__row0, __lo) & ~__upper)
+                                 | (__builtin_ia32_pshufb256(__row1, __lo) & __upper);
+    const __char_set_v32 __hit = (__char_set_v32)((__row & __builtin_ia32_pshufb256(__bit, __hi)) != 0);
+    return __builtin_ia32_pmovmskb256(__hit);
+  }
+
+  inline size_t
+  __char_set_find_avx2(const __char_set& __set, const char* __s, size_t __n, bool __match) {
+    const unsigned __flip = __match ? 0 : ~0u;
+    size_t __i = 0;
+    for (; __i + 32 <= __n; __i += 32)
+      if (const unsigned __m = __char_set_mask_avx2(__set, __s + __i) ^ __flip)
+        return __i + __builtin_ctz(__m);
+    if (__i == __n)
+      return __n;
+    __i = __n - 32;
+    const unsigned __m = __char_set_mask_avx2(__set, __s + __i) ^ __flip;
+    return __m ? __i + __builtin_ctz(__m) : __n;
+  }
+
+  inline size_t
+  __char_set_rfind_avx2(const __char_set& __set, const char* __s, size_t __n, bool __match) {
+    const unsigned __flip = __match ? 0 : ~0u;
+    size_t __i = __n;
+    for (; __i >= 32; __i -= 32)
+      if (const unsigned __m = __char_set_mask_avx2(__set, __s + __i - 32) ^ __flip)
+        return __i - 1 - __builtin_clz(__m);
+    if (__i == 0)
+      return __n;
+    const unsigned __m = __char_set_mask_avx2(__set, __s) ^ __flip;
+    return __m ? 31 - __builtin_clz(__m) : __n;
+  }
+
+#pragma GCC pop_options
+#endif // _GLIBCXX_SIMD_CHAR_SET
+
+  inline size_t
+  __char_set::_M_find(const char* __s, size_t __n, bool __match) const {
+#ifdef _GLIBCXX_SIMD_CHAR_SET
+    if (__n >= 32 && __builtin_cpu_supports("avx2"))
+      return std::__char_set_find_avx2(*this, __s, __n, __match);
+    if (__n >= 16 && __builtin_cpu_supports("ssse3"))
+      return std::__char_set_find_ssse3(*this, __s, __n, __match);
+#endif
+    return _M_find_scalar(__s, __n, 0, __match);
+  }
+
+  inline size_t
+  __char_set::_M_rfind(const char* __s, size_t __n, bool __match) const {
+#ifdef _GLIBCXX_SIMD_CHAR_SET
+    if (__n >= 32 && __builtin_cpu_supports("avx2"))
+      return std::__char_set_rfind_avx2(*this, __s, __n, __match);
+    if (__n >= 16 && __builtin_cpu_supports("ssse3"))
+      return std::__char_set_rfind_ssse3(*this, __s, __n, __match);
+#endif
+    return _M_rfind_scalar(__s, __n, __n, __match);
+  }
+
+  /**
+   *  Fast path for the find_first_of family of basic_string and
+   *  basic_string_view.  Only char_traits<char>, whose eq is plain byte
+   *  equality, can use it; for other traits _S_usable is false and the
+   *  callers keep their generic loops.
+   */
+  template <typename _Traits>
+  struct __char_set_search {
+    static bool
+    _S_usable(size_t) { return false; }
+
+    template <typename _CharT>
+    static size_t
+    _S_find_first(const _CharT*, size_t, size_t, const _CharT*, size_t, bool) { return size_t(-1); }
+
+    template <typename _CharT>
+    static size_t
+    _S_find_last(const _CharT*, size_t, size_t, const _CharT*, size_t, bool) { return size_t(-1); }
+  };
+
+  template <>
+  struct __char_set_search<char_traits<char> > {
+    // For shorter strings building the set costs more than it saves.
+    static bool
+    _S_usable(size_t __len) { return __len >= 16; }
+
+    // First position at or after __pos in [__s, __s + __len) whose
+    // membership in [__set, __set + __n) equals __match, or npos.
+    static size_t
+    _S_find_first(const char* __s, size_t __len, size_t __pos,
+                  const char* __set, size_t __n, bool __match) {
+      if (__pos >= __len)
+        return size_t(-1);
+      const size_t __i = __char_set(__set, __n)._M_find(__s + __pos, __len - __pos, __match);
+      return __i == __len - __pos ? size_t(-1) : __pos + __i;
+    }
+
+    // Last such position at or before __pos, or npos.
+    static size_t
+    _S_find_last(const char* __s, size_t __len, size_t __pos,
+                 const char* __set, size_t __n, bool __match) {
+      if (__len == 0)
+        return size_t(-1);
+      const size_t __end = __pos < __len ? __pos + 1 : __len;
+      const size_t __i = __char_set(__set, __n)._M_rfind(__s, __end, __match);
+      return __i == __end ? size_t(-1) : __i;
+    }
+  };
+
+} // namespace )
+
+#endif // _CHAR_SET_SEARCH_H
@@ -533,6 +533,7 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 #if __cplusplus >= 201103L
 
 #include <cstdint>
+#include <bits/simd_char_traits.h>
 
 namespace std _GLIBCXX_VISIBILITY(default) {
 
@@ -561,6 +562,10 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static constexpr int
     compare(const char_type* __s1, const char_type* __s2, size_t __n) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      if (!__builtin_is_constant_evaluated())
+        return std::__simd_char_compare(__s1, __s2, __n);
+#endif
       for (size_t __i = 0; __i < __n; ++__i)
         if (lt(__s1[__i], __s2[__i]))
           return -1;
@@ -571,6 +576,10 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static constexpr size_t
     length(const char_type* __s) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      if (!__builtin_is_constant_evaluated())
+        return std::__simd_char_length(__s);
+#endif
       size_t __i = 0;
       while (!eq(__s[__i], char_type()))
         ++__i;
@@ -579,6 +588,10 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static constexpr const char_type*
     find(const char_type* __s, size_t __n, const char_type& __a) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      if (!__builtin_is_constant_evaluated())
+        return std::__simd_char_find(__s, __n, __a);
+#endif
       for (size_t __i = 0; __i < __n; ++__i)
         if (eq(__s[__i], __a))
           return __s + __i;
@@ -601,9 +614,13 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static char_type*
     assign(char_type* __s, size_t __n, char_type __a) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      return std::__simd_char_assign(__s, __n, __a);
+#else
       for (size_t __i = 0; __i < __n; ++__i)
         assign(__s[__i], __a);
       return __s;
+#endif
     }
 
     static constexpr char_type
@@ -647,6 +664,10 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static constexpr int
     compare(const char_type* __s1, const char_type* __s2, size_t __n) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      if (!__builtin_is_constant_evaluated())
+        return std::__simd_char_compare(__s1, __s2, __n);
+#endif
       for (size_t __i = 0; __i < __n; ++__i)
         if (lt(__s1[__i], __s2[__i]))
           return -1;
@@ -657,6 +678,10 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static constexpr size_t
     length(const char_type* __s) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      if (!__builtin_is_constant_evaluated())
+        return std::__simd_char_length(__s);
+#endif
       size_t __i = 0;
       while (!eq(__s[__i], char_type()))
         ++__i;
@@ -665,6 +690,10 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static constexpr const char_type*
     find(const char_type* __s, size_t __n, const char_type& __a) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      if (!__builtin_is_constant_evaluated())
+        return std::__simd_char_find(__s, __n, __a);
+#endif
       for (size_t __i = 0; __i < __n; ++__i)
         if (eq(__s[__i], __a))
           return __s + __i;
@@ -687,9 +716,13 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     static char_type*
     assign(char_type* __s, size_t __n, char_type __a) {
+#ifdef _GLIBCXX_SIMD_CHAR_TRAITS
+      return std::__simd_char_assign(__s, __n, __a);
+#else
       for (size_t __i = 0; __i < __n; ++__i)
         assign(__s[__i], __a);
       return __s;
+#endif
     }
 
     static constexpr char_type
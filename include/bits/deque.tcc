@@ -1051,6 +1051,133 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       return __result;
     }
 
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _OI>
+    _OI
+    copy(_Deque_iterator<_Tp, _Ref, _Ptr> __first,
+	 _Deque_iterator<_Tp, _Ref, _Ptr> __last, _OI __result)
+    {
+      typedef typename _Deque_iterator<_Tp, _Ref, _Ptr>::_Self _Self;
+      typedef typename _Self::difference_type difference_type;
+
+      difference_type __len = __last - __first;
+      while (__len > 0)
+	{
+	  const difference_type __clen
+	    = std::min(__len, __first._M_last - __first._M_cur);
+	  __result = std::copy(__first._M_cur, __first._M_cur + __clen,
+			       __result);
+	  __first += __clen;
+	  __len -= __clen;
+	}
+      return __result;
+    }
+
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _Up>
+    _Deque_iterator<_Tp, _Ref, _Ptr>
+    find(_Deque_iterator<_Tp, _Ref, _Ptr> __first,
+	 _Deque_iterator<_Tp, _Ref, _Ptr> __last, const _Up& __val)
+    {
+      typedef typename _Deque_iterator<_Tp, _Ref, _Ptr>::_Self _Self;
+      typedef typename _Self::difference_type difference_type;
+      typedef typename _Self::_Elt_pointer _Elt_pointer;
+
+      difference_type __len = __last - __first;
+      while (__len > 0)
+	{
+	  const difference_type __clen
+	    = std::min(__len, __first._M_last - __first._M_cur);
+	  const _Elt_pointer __end = __first._M_cur + __clen;
+	  for (_Elt_pointer __cur = __first._M_cur; __cur != __end; ++__cur)
+	    if (*__cur == __val)
+	      {
+		__first._M_cur = __cur;
+		return __first;
+	      }
+	  __first += __clen;
+	  __len -= __clen;
+	}
+      return __first;
+    }
+
+  template<typename _Tp, typename _Ref, typename _Ptr,
+	   typename _Function>
+    _Function
+    for_each(_Deque_iterator<_Tp, _Ref, _Ptr> __first,
+	     _Deque_iterator<_Tp, _Ref, _Ptr> __last, _Function __f)
+    {
+      typedef typename _Deque_iterator<_Tp, _Ref, _Ptr>::_Self _Self;
+      typedef typename _Self::difference_type difference_type;
+      typedef typename _Self::_Elt_pointer _Elt_pointer;
+
+      difference_type __len = __last - __first;
+      while (__len > 0)
+	{
+	  const difference_type __clen
+	    = std::min(__len, __first._M_last - __first._M_cur);
+	  const _Elt_pointer __end = __first._M_cur + __clen;
+	  for (_Elt_pointer __cur = __first._M_cur; __cur != __end; ++__cur)
+	    __f(static_cast<_Ref>(*__cur));
+	  __first += __clen;
+	  __len -= __clen;
+	}
+      return __f;
+    }
+
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _II>
+    bool
+    equal(_Deque_iterator<_Tp, _Ref, _Ptr> __first1,
+	  _Deque_iterator<_Tp, _Ref, _Ptr> __last1, _II __first2)
+    {
+      typedef typename _Deque_iterator<_Tp, _Ref, _Ptr>::_Self _Self;
+      typedef typename _Self::difference_type difference_type;
+      typedef typename _Self::_Elt_pointer _Elt_pointer;
+
+      // __first2 may be a single-pass iterator, so it is only ever
+      // incremented, never copied and advanced again.
+      difference_type __len = __last1 - __first1;
+      while (__len > 0)
+	{
+	  const difference_type __clen
+	    = std::min(__len, __first1._M_last - __first1._M_cur);
+	  const _Elt_pointer __end = __first1._M_cur + __clen;
+	  for (_Elt_pointer __cur = __first1._M_cur; __cur != __end;
+	       ++__cur, (void)++__first2)
+	    if (!(*__cur == *__first2))
+	      return false;
+	  __first1 += __clen;
+	  __len -= __clen;
+	}
+      return true;
+    }
+
+  template<typename _Tp, typename _Ref1, typename _Ptr1,
+	   typename _Ref2, typename _Ptr2>
+    bool
+    equal(_Deque_iterator<_Tp, _Ref1, _Ptr1> __first1,
+	  _Deque_iterator<_Tp, _Ref1, _Ptr1> __last1,
+	  _Deque_iterator<_Tp, _Ref2, _Ptr2> __first2)
+    {
+      typedef typename _Deque_iterator<_Tp, _Ref1, _Ptr1>::_Self _Self;
+      typedef typename _Self::difference_type difference_type;
+
+      // Both ranges are segmented: compare the longest run that is
+      // contiguous in both, which lets std::equal use memcmp.
+      difference_type __len = __last1 - __first1;
+      while (__len > 0)
+	{
+	  const difference_type __clen
+	    = std::min(__len, std::min(__first1._M_last - __first1._M_cur,
+				       __first2._M_last - __first2._M_cur));
+	  if (!std::equal(__first1._M_cur, __first1._M_cur + __clen,
+			  __first2._M_cur))
+	    return false;
+	  __first1 += __clen;
+	  __first2 += __clen;
+	  __len -= __clen;
+	}
+      return true;
+    }
+
 #if __cplusplus >= 201103L
   template<typename _Tp>
     _Deque_iterator<_Tp, _Tp&, _Tp*>
@@ -1113,6 +1240,27 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	}
       return __result;
     }
+
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _OI>
+    _OI
+    move(_Deque_iterator<_Tp, _Ref, _Ptr> __first,
+	 _Deque_iterator<_Tp, _Ref, _Ptr> __last, _OI __result)
+    {
+      typedef typename _Deque_iterator<_Tp, _Ref, _Ptr>::_Self _Self;
+      typedef typename _Self::difference_type difference_type;
+
+      difference_type __len = __last - __first;
+      while (__len > 0)
+	{
+	  const difference_type __clen
+	    = std::min(__len, __first._M_last - __first._M_cur);
+	  __result = std::move(__first._M_cur, __first._M_cur + __clen,
+			       __result);
+	  __first += __clen;
+	  __len -= __clen;
+	}
+      return __result;
+    }
 #endif
 
 _GLIBCXX_END_NAMESPACE_CONTAINER
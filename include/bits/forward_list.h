@@ -38,6 +38,7 @@
 #include <bits/stl_algobase.h>
 #include <bits/stl_function.h>
 #include <bits/allocator.h>
+#include <bits/node_sort.h>
 #include <ext/alloc_traits.h>
 #include <ext/aligned_buffer.h>
 
@@ -421,6 +421,27 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	if (!__list)
 	  return;
 
+	// Sort through a buffer of node pointers when one can be had, see
+	// _Node_sort_buffer, and fall back to merging the list in place.
+	ptrdiff_t __n = 0;
+	for (_Node_base* __cur = __list; __cur; __cur = __cur->_M_next)
+	  ++__n;
+	{
+	  _Node_sort_buffer<_Node> __buf(__n);
+	  if (_Node** __p
+		= __buf._M_sort(__list, __gnu_cxx::__ops::__iter_comp_iter(__comp)))
+	    {
+	      _Node_base* __prev = &this->_M_impl._M_head;
+	      for (ptrdiff_t __i = 0; __i < __n; ++__i)
+		{
+		  __prev->_M_next = __p[__i];
+		  __prev = __p[__i];
+		}
+	      __prev->_M_next = nullptr;
+	      return;
+	    }
+	}
+
 	unsigned long __insize = 1;
 
 	while (1)
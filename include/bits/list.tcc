@@ -481,6 +481,34 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	  }
       }
 
+  template<typename _Tp, typename _Alloc>
+    template<typename _Compare>
+      bool
+      list<_Tp, _Alloc>::
+      _M_sort_nodes(_Compare __comp)
+      {
+	typedef __detail::_List_node_base _Node_base;
+	_Node_base* const __head = &this->_M_impl._M_node;
+	const size_type __n = this->_M_node_count();
+
+	_Node_sort_buffer<_Node> __buf(__n);
+	_Node** const __p
+	  = __buf._M_sort(static_cast<_Node*>(__head->_M_next), __comp);
+	if (!__p)
+	  return false;
+
+	_Node_base* __prev = __head;
+	for (size_type __i = 0; __i < __n; ++__i)
+	  {
+	    __prev->_M_next = __p[__i];
+	    __p[__i]->_M_prev = __prev;
+	    __prev = __p[__i];
+	  }
+	__prev->_M_next = __head;
+	__head->_M_prev = __prev;
+	return true;
+      }
+
   template<typename _Tp, typename _Alloc>
     void
     list<_Tp, _Alloc>::
@@ -490,6 +518,9 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
       if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
 	  && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
       {
+	if (_M_sort_nodes(__gnu_cxx::__ops::__iter_less_iter()))
+	  return;
+
         list __carry;
         list __tmp[64];
         list * __fill = __tmp;
@@ -588,6 +619,9 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 	if (this->_M_impl._M_node._M_next != &this->_M_impl._M_node
 	    && this->_M_impl._M_node._M_next->_M_next != &this->_M_impl._M_node)
 	  {
+	    if (_M_sort_nodes(__gnu_cxx::__ops::__iter_comp_iter(__comp)))
+	      return;
+
 	    list __carry;
 	    list __tmp[64];
 	    list * __fill = __tmp;
@@ -0,0 +1,164 @@
+// Sorting list nodes through a pointer buffer -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/node_sort.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly.
+ *  @headername{list,forward_list}
+ */
+
+#ifndef _NODE_SORT_H
+#define _NODE_SORT_H 1
+
+#pragma GCC system_header
+
+#include <bits/stl_algobase.h>
+#include <bits/stl_tempbuf.h>
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Adapts a comparison of iterators over elements, as made by the
+  /// helpers in predefined_ops.h, to one of the nodes holding them.
+  template<typename _Node, typename _Compare>
+    struct _Node_ptr_compare
+    {
+      _Compare _M_comp;
+
+      explicit
+      _Node_ptr_compare(_Compare __comp)
+      : _M_comp(__comp) { }
+
+      bool
+      operator()(_Node* __x, _Node* __y)
+      { return _M_comp(__x->_M_valptr(), __y->_M_valptr()); }
+    };
+
+  /**
+   *  Scratch space for sorting the nodes of a linked list.
+   *
+   *  The node pointers are gathered into a contiguous array and merge
+   *  sorted there, so the comparisons walk an array instead of chasing
+   *  list links, and the caller relinks the nodes once at the end.  The
+   *  buffer comes from get_temporary_buffer; when not enough memory can
+   *  be had, _M_sort() does nothing and returns null so the caller can
+   *  use its in-place merge sort instead.
+   *
+   *  Nothing is relinked before the sort completes, so an exception from
+   *  the comparison leaves the list untouched.
+  */
+  template<typename _Node>
+    class _Node_sort_buffer
+    {
+      pair<_Node**, ptrdiff_t> _M_buf;
+      ptrdiff_t _M_len;
+
+      _Node_sort_buffer(const _Node_sort_buffer&);
+      _Node_sort_buffer& operator=(const _Node_sort_buffer&);
+
+      enum { _S_chunk_size = 7 };
+
+      // Sorts runs of _S_chunk_size pointers in place, then merges runs
+      // of doubling length back and forth between __p and __q, and
+      // returns whichever of them holds the result.
+      template<typename _Compare>
+	static _Node**
+	_S_merge_sort(_Node** __p, _Node** __q, ptrdiff_t __len,
+		      _Compare& __comp)
+	{
+	  for (ptrdiff_t __i = 0; __i < __len; __i += _S_chunk_size)
+	    {
+	      const ptrdiff_t __end
+		= std::min<ptrdiff_t>(__i + _S_chunk_size, __len);
+	      for (ptrdiff_t __j = __i + 1; __j < __end; ++__j)
+		{
+		  _Node* const __x = __p[__j];
+		  ptrdiff_t __k = __j;
+		  for (; __k > __i && __comp(__x, __p[__k - 1]); --__k)
+		    __p[__k] = __p[__k - 1];
+		  __p[__k] = __x;
+		}
+	    }
+	  for (ptrdiff_t __step = _S_chunk_size; __step < __len; __step *= 2)
+	    {
+	      for (ptrdiff_t __i = 0; __i < __len; __i += 2 * __step)
+		{
+		  const ptrdiff_t __mid = std::min(__i + __step, __len);
+		  const ptrdiff_t __end = std::min(__mid + __step, __len);
+		  ptrdiff_t __a = __i, __b = __mid, __o = __i;
+		  while (__a != __mid && __b != __end)
+		    {
+		      // Equal elements are taken from the left run first.
+		      if (__comp(__p[__b], __p[__a]))
+			__q[__o++] = __p[__b++];
+		      else
+			__q[__o++] = __p[__a++];
+		    }
+		  while (__a != __mid)
+		    __q[__o++] = __p[__a++];
+		  while (__b != __end)
+		    __q[__o++] = __p[__b++];
+		}
+	      std::swap(__p, __q);
+	    }
+	  return __p;
+	}
+
+    public:
+      // Room for __len node pointers plus as many for the merge passes.
+      explicit
+      _Node_sort_buffer(ptrdiff_t __len)
+      : _M_buf(std::get_temporary_buffer<_Node*>(2 * __len)), _M_len(__len)
+      { }
+
+      ~_Node_sort_buffer()
+      { std::return_temporary_buffer(_M_buf.first); }
+
+      /**
+       *  Stably sorts the _M_len nodes starting at @a __first, which must
+       *  all be reachable through _M_next, and returns the array of
+       *  pointers to them in sorted order.
+      */
+      template<typename _Compare>
+	_Node**
+	_M_sort(_Node* __first, _Compare __comp)
+	{
+	  if (_M_buf.second < 2 * _M_len)
+	    return 0;
+	  _Node** const __p = _M_buf.first;
+	  for (ptrdiff_t __i = 0; __i < _M_len; ++__i)
+	    {
+	      __p[__i] = __first;
+	      __first = static_cast<_Node*>(__first->_M_next);
+	    }
+	  _Node_ptr_compare<_Node, _Compare> __c(__comp);
+	  return _S_merge_sort(__p, __p + _M_len, _M_len, __c);
+	}
+    };
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#endif // _NODE_SORT_H
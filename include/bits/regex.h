@@ -42,7 +42,11 @@ _GLIBCXX_END_NAMESPACE_CXX11
 
 namespace __detail
 {
-  enum class _RegexExecutorPolicy : int { _S_auto, _S_alternate };
+  // _S_nfa is _S_auto without the lazy DFA.
+  enum class _RegexExecutorPolicy : int { _S_auto, _S_alternate, _S_nfa };
+
+  template<typename, typename>
+    struct _Match_context;
 
   template<typename _BiIter, typename _Alloc,
 	   typename _CharT, typename _TraitsT,
@@ -53,7 +57,23 @@ namespace __detail
 		      _BiIter			      __e,
 		      match_results<_BiIter, _Alloc>&      __m,
 		      const basic_regex<_CharT, _TraitsT>& __re,
-		      regex_constants::match_flag_type     __flags);
+		      regex_constants::match_flag_type     __flags,
+		      size_t			      __max_steps = size_t(-1),
+		      _Match_context<_BiIter, _Alloc>*     __ctx = nullptr);
+
+  template<typename _BiIter, typename _CharT, typename _TraitsT,
+	   bool __match_mode>
+    bool
+    __regex_algo_test(_BiIter				   __s,
+		      _BiIter				   __e,
+		      const basic_regex<_CharT, _TraitsT>& __re,
+		      regex_constants::match_flag_type     __flags,
+		      size_t				   __max_steps = size_t(-1));
+
+  template<typename _BiIter, typename _Alloc>
+    void
+    __regex_iter_rebase(match_results<_BiIter, _Alloc>& __m,
+			_BiIter __begin, _BiIter __prefix_first);
 
   template<typename, typename, typename, bool>
     class _Executor;
@@ -765,7 +785,13 @@ _GLIBCXX_BEGIN_NAMESPACE_CXX11
 	friend bool
 	__detail::__regex_algo_impl(_Bp, _Bp, match_results<_Bp, _Ap>&,
 				    const basic_regex<_Cp, _Rp>&,
-				    regex_constants::match_flag_type);
+				    regex_constants::match_flag_type, size_t,
+				    __detail::_Match_context<_Bp, _Ap>*);
+
+      template<typename _Bp, typename _Cp, typename _Rp, bool>
+	friend bool
+	__detail::__regex_algo_test(_Bp, _Bp, const basic_regex<_Cp, _Rp>&,
+				    regex_constants::match_flag_type, size_t);
 
       template<typename, typename, typename, bool>
 	friend class __detail::_Executor;
@@ -1940,7 +1966,12 @@ _GLIBCXX_BEGIN_NAMESPACE_CXX11
 	friend bool
 	__detail::__regex_algo_impl(_Bp, _Bp, match_results<_Bp, _Ap>&,
 				    const basic_regex<_Cp, _Rp>&,
-				    regex_constants::match_flag_type);
+				    regex_constants::match_flag_type, size_t,
+				    __detail::_Match_context<_Bp, _Ap>*);
+
+      template<typename _Bp, typename _Ap>
+	friend void
+	__detail::__regex_iter_rebase(match_results<_Bp, _Ap>&, _Bp, _Bp);
 
       void
       _M_resize(unsigned int __size)
@@ -2089,8 +2120,45 @@ _GLIBCXX_END_NAMESPACE_CXX11
 		regex_constants::match_flag_type __flags
 		= regex_constants::match_default)
     {
-      match_results<_Bi_iter> __what;
-      return regex_match(__first, __last, __what, __re, __flags);
+      return __detail::__regex_algo_test<_Bi_iter, _Ch_type, _Rx_traits, true>
+	(__first, __last, __re, __flags);
+    }
+
+  /**
+   * @brief As regex_match above, but gives up after @p __max_steps steps.
+   *
+   * A step is one visit of a state of the automaton, so the limit bounds
+   * the time taken by patterns that backtrack exponentially.  This is a
+   * GNU extension.
+   *
+   * @throws regex_error with code regex_constants::error_complexity if the
+   *         limit is reached before the matching is decided.
+   */
+  template<typename _Bi_iter, typename _Alloc,
+	   typename _Ch_type, typename _Rx_traits>
+    inline bool
+    regex_match(_Bi_iter				 __s,
+		_Bi_iter				 __e,
+		match_results<_Bi_iter, _Alloc>&	 __m,
+		const basic_regex<_Ch_type, _Rx_traits>& __re,
+		regex_constants::match_flag_type	 __flags,
+		size_t					 __max_steps)
+    {
+      return __detail::__regex_algo_impl<_Bi_iter, _Alloc, _Ch_type, _Rx_traits,
+	__detail::_RegexExecutorPolicy::_S_auto, true>
+	  (__s, __e, __m, __re, __flags, __max_steps);
+    }
+
+  /// As above, without the match results.  This is a GNU extension.
+  template<typename _Bi_iter, typename _Ch_type, typename _Rx_traits>
+    inline bool
+    regex_match(_Bi_iter __first, _Bi_iter __last,
+		const basic_regex<_Ch_type, _Rx_traits>& __re,
+		regex_constants::match_flag_type __flags,
+		size_t __max_steps)
+    {
+      return __detail::__regex_algo_test<_Bi_iter, _Ch_type, _Rx_traits, true>
+	(__first, __last, __re, __flags, __max_steps);
     }
 
   /**
@@ -2243,8 +2311,43 @@ _GLIBCXX_END_NAMESPACE_CXX11
 		 regex_constants::match_flag_type __flags
 		 = regex_constants::match_default)
     {
-      match_results<_Bi_iter> __what;
-      return regex_search(__first, __last, __what, __re, __flags);
+      return __detail::__regex_algo_test<_Bi_iter, _Ch_type, _Rx_traits, false>
+	(__first, __last, __re, __flags);
+    }
+
+  /**
+   * @brief As regex_search above, but gives up after @p __max_steps steps.
+   *
+   * A step is one visit of a state of the automaton, counted over all the
+   * positions tried.  This is a GNU extension.
+   *
+   * @throws regex_error with code regex_constants::error_complexity if the
+   *         limit is reached before the search is decided.
+   */
+  template<typename _Bi_iter, typename _Alloc,
+	   typename _Ch_type, typename _Rx_traits>
+    inline bool
+    regex_search(_Bi_iter __s, _Bi_iter __e,
+		 match_results<_Bi_iter, _Alloc>& __m,
+		 const basic_regex<_Ch_type, _Rx_traits>& __re,
+		 regex_constants::match_flag_type __flags,
+		 size_t __max_steps)
+    {
+      return __detail::__regex_algo_impl<_Bi_iter, _Alloc, _Ch_type, _Rx_traits,
+	__detail::_RegexExecutorPolicy::_S_auto, false>
+	  (__s, __e, __m, __re, __flags, __max_steps);
+    }
+
+  /// As above, without the match results.  This is a GNU extension.
+  template<typename _Bi_iter, typename _Ch_type, typename _Rx_traits>
+    inline bool
+    regex_search(_Bi_iter __first, _Bi_iter __last,
+		 const basic_regex<_Ch_type, _Rx_traits>& __re,
+		 regex_constants::match_flag_type __flags,
+		 size_t __max_steps)
+    {
+      return __detail::__regex_algo_test<_Bi_iter, _Ch_type, _Rx_traits, false>
+	(__first, __last, __re, __flags, __max_steps);
     }
 
   /**
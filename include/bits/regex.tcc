@@ -34,10 +34,48 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 
 namespace __detail
 {
+  // Uses the literals _Compiler found to rule out a match in [__s, __e),
+  // or else to move __s up to the first place a match can start at.
+  template<typename _BiIter, typename _TraitsT>
+    bool
+    __regex_skip_to_literal(_BiIter&			__s,
+			    _BiIter			__e,
+			    const _NFA<_TraitsT>&	__nfa,
+			    regex_constants::match_flag_type __flags,
+			    bool			__match_mode)
+    {
+      const auto& __prefix = __nfa._M_literal_prefix;
+      if (!__prefix.empty())
+	{
+	  if (__match_mode || (__flags & regex_constants::match_continuous))
+	    {
+	      _BiIter __i = __s;
+	      for (auto __c : __prefix)
+		if (__i == __e || *__i++ != __c)
+		  return false;
+	    }
+	  else
+	    {
+	      _BiIter __p = std::search(__s, __e, __prefix.begin(),
+					__prefix.end());
+	      if (__p == __e)
+		return false;
+	      // _Executor::_M_search applies match_not_bow at every position
+	      // it tries, so only it may move the start then.
+	      if (!(__flags & regex_constants::match_not_bow))
+		__s = __p;
+	    }
+	}
+      const auto& __required = __nfa._M_required_literal;
+      return __required.empty()
+	|| std::search(__s, __e, __required.begin(), __required.end()) != __e;
+    }
+
   // Result of merging regex_match and regex_search.
   //
-  // __policy now can be _S_auto (auto dispatch) and _S_alternate (use
-  // the other one if possible, for test purpose).
+  // __policy now can be _S_auto (auto dispatch), _S_alternate (use
+  // the other one if possible, for test purpose) and _S_nfa (auto
+  // dispatch without the lazy DFA).
   //
   // That __match_mode is true means regex_match, else regex_search.
   template<typename _BiIter, typename _Alloc,
@@ -49,7 +87,9 @@ namespace __detail
 		      _BiIter                              __e,
 		      match_results<_BiIter, _Alloc>&      __m,
 		      const basic_regex<_CharT, _TraitsT>& __re,
-		      regex_constants::match_flag_type     __flags)
+		      regex_constants::match_flag_type     __flags,
+		      size_t                               __max_steps,
+		      _Match_context<_BiIter, _Alloc>*     __ctx)
     {
       if (__re._M_automaton == nullptr)
 	return false;
@@ -60,13 +100,39 @@ namespace __detail
       for (auto& __it : __res)
 	__it.matched = false;
 
+      // The literals and then the lazy DFA rule out inputs that do not
+      // match and find where the leftmost match starts, so that the
+      // executor only has to work out the submatches from there.
+      int __dfa = -1;
+      _BiIter __start = __s;
+      if (!__regex_skip_to_literal(__start, __e, *__re._M_automaton, __flags,
+				   __match_mode))
+	__dfa = 0;
+      else
+	{
+	  if (__start != __s)
+	    __flags |= regex_constants::match_prev_avail;
+	  if (__policy == _RegexExecutorPolicy::_S_auto)
+	    __dfa = _Lazy_dfa<_TraitsT>::_S_scan(*__re._M_automaton, __start,
+						 __e, __flags, __match_mode,
+						 true, __start);
+	}
+      if (__dfa == 1 && !__match_mode)
+	{
+	  if (__start != __s)
+	    __flags |= regex_constants::match_prev_avail;
+	  __flags |= regex_constants::match_continuous;
+	}
+
       bool __ret;
-      if ((__re.flags() & regex_constants::__polynomial)
+      if (__dfa == 0)
+	__ret = false;
+      else if ((__re.flags() & regex_constants::__polynomial)
 	  || (__policy == _RegexExecutorPolicy::_S_alternate
 	      && !__re._M_automaton->_M_has_backref))
 	{
 	  _Executor<_BiIter, _Alloc, _TraitsT, false>
-	    __executor(__s, __e, __m, __re, __flags);
+	    __executor(__start, __e, __m, __re, __flags, __max_steps, __ctx);
 	  if (__match_mode)
 	    __ret = __executor._M_match();
 	  else
@@ -75,7 +141,7 @@ namespace __detail
       else
 	{
 	  _Executor<_BiIter, _Alloc, _TraitsT, true>
-	    __executor(__s, __e, __m, __re, __flags);
+	    __executor(__start, __e, __m, __re, __flags, __max_steps, __ctx);
 	  if (__match_mode)
 	    __ret = __executor._M_match();
 	  else
@@ -118,6 +184,54 @@ namespace __detail
 	}
       return __ret;
     }
+
+  // regex_match and regex_search without match_results: the lazy DFA
+  // alone answers, unless it cannot handle the regex or the input.
+  template<typename _BiIter, typename _CharT, typename _TraitsT,
+	   bool __match_mode>
+    bool
+    __regex_algo_test(_BiIter				   __s,
+		      _BiIter				   __e,
+		      const basic_regex<_CharT, _TraitsT>& __re,
+		      regex_constants::match_flag_type     __flags,
+		      size_t				   __max_steps)
+    {
+      if (__re._M_automaton == nullptr)
+	return false;
+
+      _BiIter __start = __s;
+      if (!__regex_skip_to_literal(__start, __e, *__re._M_automaton, __flags,
+				   __match_mode))
+	return false;
+      if (__start != __s)
+	__flags |= regex_constants::match_prev_avail;
+      const int __dfa = _Lazy_dfa<_TraitsT>::_S_scan(*__re._M_automaton,
+						     __start, __e, __flags,
+						     __match_mode, false,
+						     __start);
+      if (__dfa >= 0)
+	return __dfa;
+
+      match_results<_BiIter> __m;
+      return __regex_algo_impl<_BiIter,
+	typename match_results<_BiIter>::allocator_type, _CharT, _TraitsT,
+	_RegexExecutorPolicy::_S_nfa, __match_mode>(__start, __e, __m, __re,
+						     __flags, __max_steps);
+    }
+
+  // For a match found by searching on from the end of the previous one,
+  // as regex_iterator does: the prefix starts where that match ended and
+  // positions count from the beginning of the sequence.  [28.12.1.4.5]
+  template<typename _BiIter, typename _Alloc>
+    void
+    __regex_iter_rebase(match_results<_BiIter, _Alloc>& __m,
+			_BiIter __begin, _BiIter __prefix_first)
+    {
+      auto& __prefix = __m._M_prefix();
+      __prefix.first = __prefix_first;
+      __prefix.matched = __prefix.first != __prefix.second;
+      __m._M_begin = __begin;
+    }
 }
 
   template<typename _Ch_type>
@@ -181,6 +181,46 @@ namespace __detail
       }
     };
 
+  template<typename _TraitsT>
+    class _Lazy_dfa;
+
+  // Owns the lazy DFA cache of an _NFA.  A search borrows the cache and
+  // hands it back when done, so searches that run concurrently on the
+  // same regex each use a cache of their own.
+  template<typename _DfaT>
+    struct _Dfa_cache_slot
+    {
+      _Dfa_cache_slot() noexcept
+      : _M_ptr(nullptr)
+      { }
+
+      // Only moved while the _NFA is being built.
+      _Dfa_cache_slot(_Dfa_cache_slot&& __x) noexcept
+      : _M_ptr(__x._M_ptr)
+      { __x._M_ptr = nullptr; }
+
+      ~_Dfa_cache_slot()
+      { delete _M_ptr; }
+
+      // The cache, or null if another search holds it or none was made.
+      _DfaT*
+      _M_take() const noexcept
+      { return __atomic_exchange_n(&_M_ptr, (_DfaT*)nullptr, __ATOMIC_ACQUIRE); }
+
+      // Stores __p for the next search, or frees it if another search
+      // returned its cache first.
+      void
+      _M_give_back(_DfaT* __p) const noexcept
+      {
+	_DfaT* __expected = nullptr;
+	if (!__atomic_compare_exchange_n(&_M_ptr, &__expected, __p, false,
+					 __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+	  delete __p;
+      }
+
+      mutable _DfaT* _M_ptr;
+    };
+
   struct _NFA_base
   {
     typedef size_t                              _SizeT;
@@ -346,6 +386,12 @@ namespace __detail
 #endif
     public:
       _TraitsT                  _M_traits;
+      _Dfa_cache_slot<_Lazy_dfa<_TraitsT>> _M_dfa_cache;
+      // Filled in by _Compiler: the literal every match begins with, and
+      // the longest literal every match contains when that is not the
+      // prefix.  Either may be empty.
+      basic_string<_Char_type>  _M_literal_prefix;
+      basic_string<_Char_type>  _M_required_literal;
     };
 
   /// Describes a sequence of one or more %_State, its current start
@@ -130,6 +130,10 @@ namespace __detail
 			   _BracketMatcher<_TraitsT, __icase, __collate>&
 			   __matcher);
 
+      // Finds the literals every match begins with or contains.
+      void
+      _M_find_literals();
+
       int
       _M_cur_int_value(int __radix);
 
@@ -151,6 +155,8 @@ namespace __detail
       _StackT             _M_stack;
       const _TraitsT&     _M_traits;
       const _CtypeT&      _M_ctype;
+      // States matching exactly one character, in increasing order.
+      vector<pair<_StateIdT, _CharT>> _M_literals;
     };
 
   template<typename _Tp>
@@ -89,6 +89,7 @@ namespace __detail
       __r._M_append(_M_nfa->_M_insert_subexpr_end());
       __r._M_append(_M_nfa->_M_insert_accept());
       _M_nfa->_M_eliminate_dummy();
+      _M_find_literals();
     }
 
   template<typename _TraitsT>
@@ -397,10 +398,11 @@ namespace __detail
     _Compiler<_TraitsT>::
     _M_insert_char_matcher()
     {
-      _M_stack.push(_StateSeqT(*_M_nfa,
-	_M_nfa->_M_insert_matcher
-	  (_CharMatcher<_TraitsT, __icase, __collate>
-	    (_M_value[0], _M_traits))));
+      auto __id = _M_nfa->_M_insert_matcher
+	(_CharMatcher<_TraitsT, __icase, __collate>(_M_value[0], _M_traits));
+      if (!__icase && !__collate)
+	_M_literals.emplace_back(__id, _M_value[0]);
+      _M_stack.push(_StateSeqT(*_M_nfa, __id));
     }
 
   template<typename _TraitsT>
@@ -597,6 +599,157 @@ namespace __detail
       return false;
     }
 
+  // Every match follows a path from the start state to the accept state
+  // inserted last, so it passes through every state that dominates the
+  // accept state.  From a literal state among those, a chain of literal
+  // states and of states that consume nothing and have one successor
+  // spells a string that every match contains.  Dominators are computed
+  // as in Cooper, Harvey and Kennedy, "A Simple, Fast Dominance
+  // Algorithm".
+  template<typename _TraitsT>
+    void
+    _Compiler<_TraitsT>::
+    _M_find_literals()
+    {
+      if (_M_literals.empty())
+	return;
+      const _RegexT& __nfa = *_M_nfa;
+      const _StateIdT __start = __nfa._M_start();
+      const _StateIdT __accept = __nfa.size() - 1;
+
+      auto __literal = [this](_StateIdT __i) -> const _CharT*
+	{
+	  auto __it = std::lower_bound(_M_literals.begin(), _M_literals.end(),
+				       __i, [](const pair<_StateIdT, _CharT>& __x,
+					       _StateIdT __y)
+				       { return __x.first < __y; });
+	  return __it != _M_literals.end() && __it->first == __i
+	    ? &__it->second : nullptr;
+	};
+      auto __spell = [&__nfa, &__literal](_StateIdT __i)
+	{
+	  basic_string<_CharT> __str;
+	  for (; __i >= 0; __i = __nfa[__i]._M_next)
+	    switch (__nfa[__i]._M_opcode())
+	      {
+	      case _S_opcode_match:
+		if (const _CharT* __c = __literal(__i))
+		  {
+		    __str += *__c;
+		    break;
+		  }
+		return __str;
+	      case _S_opcode_subexpr_begin:
+	      case _S_opcode_subexpr_end:
+	      case _S_opcode_dummy:
+	      case _S_opcode_line_begin_assertion:
+	      case _S_opcode_line_end_assertion:
+	      case _S_opcode_word_boundary:
+		break;
+	      default:
+		return __str;
+	      }
+	  return __str;
+	};
+      // Lookaheads are entered through _M_next only: what they match is
+      // not part of the match.
+      auto __successors = [&__nfa](_StateIdT __i, _StateIdT* __out)
+	{
+	  const auto& __state = __nfa[__i];
+	  if (__state._M_opcode() == _S_opcode_accept)
+	    return 0;
+	  __out[0] = __state._M_next;
+	  if (__state._M_opcode() != _S_opcode_alternative
+	      && __state._M_opcode() != _S_opcode_repeat)
+	    return 1;
+	  __out[1] = __state._M_alt;
+	  return 2;
+	};
+
+      // Number the reachable states in postorder.
+      const size_t __n = __nfa.size();
+      vector<_StateIdT> __order;
+      vector<int> __post(__n, -1);
+      vector<char> __seen(__n, 0);
+      vector<pair<_StateIdT, int>> __stack;
+      __stack.emplace_back(__start, 0);
+      __seen[__start] = 1;
+      while (!__stack.empty())
+	{
+	  _StateIdT __out[2];
+	  auto& __top = __stack.back();
+	  if (__top.second < __successors(__top.first, __out))
+	    {
+	      const _StateIdT __v = __out[__top.second++];
+	      if (__v >= 0 && !__seen[__v])
+		{
+		  __seen[__v] = 1;
+		  __stack.emplace_back(__v, 0);
+		}
+	    }
+	  else
+	    {
+	      __post[__top.first] = __order.size();
+	      __order.push_back(__top.first);
+	      __stack.pop_back();
+	    }
+	}
+      if (!__seen[__accept])
+	return;
+
+      vector<vector<_StateIdT>> __preds(__n);
+      for (auto __u : __order)
+	{
+	  _StateIdT __out[2];
+	  for (int __k = 0, __m = __successors(__u, __out); __k < __m; ++__k)
+	    if (__out[__k] >= 0)
+	      __preds[__out[__k]].push_back(__u);
+	}
+
+      vector<_StateIdT> __idom(__n, _S_invalid_state_id);
+      __idom[__start] = __start;
+      auto __intersect = [&__idom, &__post](_StateIdT __a, _StateIdT __b)
+	{
+	  while (__a != __b)
+	    {
+	      while (__post[__a] < __post[__b])
+		__a = __idom[__a];
+	      while (__post[__b] < __post[__a])
+		__b = __idom[__b];
+	    }
+	  return __a;
+	};
+      for (bool __changed = true; __changed; )
+	{
+	  __changed = false;
+	  // Reverse postorder, skipping the start state.
+	  for (auto __it = __order.rbegin() + 1; __it != __order.rend(); ++__it)
+	    {
+	      _StateIdT __new = _S_invalid_state_id;
+	      for (auto __p : __preds[*__it])
+		if (__idom[__p] >= 0)
+		  __new = __new < 0 ? __p : __intersect(__p, __new);
+	      if (__idom[*__it] != __new)
+		{
+		  __idom[*__it] = __new;
+		  __changed = true;
+		}
+	    }
+	}
+
+      _M_nfa->_M_literal_prefix = __spell(__start);
+      basic_string<_CharT> __longest;
+      for (_StateIdT __d = __accept; __d != __start; __d = __idom[__d])
+	if (__literal(__d))
+	  {
+	    auto __str = __spell(__d);
+	    if (__str.size() > __longest.size())
+	      __longest.swap(__str);
+	  }
+      if (__longest.size() > _M_nfa->_M_literal_prefix.size())
+	_M_nfa->_M_required_literal.swap(__longest);
+    }
+
   template<typename _TraitsT>
     int
     _Compiler<_TraitsT>::
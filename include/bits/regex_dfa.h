@@ -0,0 +1,223 @@
+// class template regex -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/**
+ *  @file bits/regex_dfa.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{regex}
+ */
+
+// This macro defines the maximal number of states a lazy DFA caches
+// before it starts over.
+#ifndef _GLIBCXX_REGEX_DFA_STATE_LIMIT
+#define _GLIBCXX_REGEX_DFA_STATE_LIMIT 1024
+#endif
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace __detail
+{
+  /**
+   * @addtogroup regex-detail
+   * @{
+   */
+
+  /**
+   * @brief Decides whether a regex matches, one table lookup per character.
+   *
+   * DFA states are built lazily from the _NFA, as in RE2: a state is the
+   * set of NFA states reached just after consuming a character, plus the
+   * context the assertions need (start of input, whether the previous
+   * character is a word character, whether the search is unanchored).
+   * Each state has a row of 256 transitions filled in on first use, so
+   * only the char-sized character types are handled.  Every transition
+   * also records whether a match ends just before the character, because
+   * whether an assertion holds there depends on that character.
+   *
+   * The DFA only tells whether, and where, a match exists; submatches are
+   * left to _Executor.  Regexes with back-references or lookaheads are not
+   * handled.  When more states are needed than the larger of
+   * _GLIBCXX_REGEX_DFA_STATE_LIMIT and the size of the _NFA, the cache is
+   * flushed, and after a few flushes in one scan the DFA gives up and the
+   * caller falls back to _Executor.
+   *
+   * The _NFA of a regex set has one accept state per pattern; for it the
+   * DFA can also tell which patterns match.
+   */
+  template<typename _TraitsT>
+    class _Lazy_dfa
+    {
+    public:
+      typedef typename _TraitsT::char_type		_CharT;
+      typedef _NFA<_TraitsT>				_NFAT;
+      typedef regex_constants::match_flag_type		_FlagT;
+
+      explicit
+      _Lazy_dfa(const _NFAT& __nfa);
+
+      // Whether there is a match in [__s, __e): 1 if so, 0 if not, -1 if
+      // the DFA cannot tell and _Executor has to be used.  With
+      // __match_mode the match must span the whole range.  Otherwise, if
+      // __want_start, __start is set to the leftmost position a match
+      // starts at.
+      template<typename _BiIter>
+	static int
+	_S_scan(const _NFAT& __nfa, _BiIter __s, _BiIter __e, _FlagT __flags,
+		bool __match_mode, bool __want_start, _BiIter& __start);
+
+      // For the _NFA of a regex set, which has an accept state per
+      // pattern tagged with the pattern index in _M_subexpr.  Sets
+      // __found[__i] if pattern __i matches in [__s, __e), or matches all
+      // of it with __match_mode.  Returns 1 if done, -1 as for _S_scan.
+      template<typename _BiIter>
+	static int
+	_S_scan_set(const _NFAT& __nfa, _BiIter __s, _BiIter __e,
+		    _FlagT __flags, bool __match_mode, vector<bool>& __found);
+
+      // Likewise, finds the leftmost longest match [__start, __end) of
+      // any pattern and sets __found for the patterns matching just it.
+      template<typename _BiIter>
+	static int
+	_S_scan_longest(const _NFAT& __nfa, _BiIter __s, _BiIter __e,
+			_FlagT __flags, vector<bool>& __found,
+			_BiIter& __start, _BiIter& __end);
+
+    private:
+      enum _Ctx : unsigned char
+      {
+	// DFA state flags.
+	_S_ctx_begin = 1,	// At the beginning of input, for ^.
+	_S_ctx_word = 2,	// The previous character is a word character.
+	_S_ctx_unanchored = 4,	// A match may start at every position.
+	// Flags only used while computing a closure.
+	_S_ctx_end = 8,		// At the end of input, for $.
+	_S_ctx_boundary = 16,	// At a word boundary, for \b.
+      };
+
+      // A transition is (target << 2) | _S_dead | _S_accept.
+      enum : int
+      {
+	_S_accept = 1,		// A match ends before the character.
+	_S_dead = 2,		// The target can never reach a match.
+	_S_unknown = -1,	// Not computed yet.
+	_S_give_up = -2		// Too many flushes.
+      };
+
+      struct _DState
+      {
+	vector<_StateIdT> _M_kernel;
+	unsigned char _M_ctx;
+	// Whether a match ends at the end of input, indexed by
+	// match_not_eol and match_not_eow; -1 if not computed yet.
+	signed char _M_eof[4];
+      };
+
+      enum { _S_max_flushes = 4 };
+
+      static bool
+      _S_supports(const _NFAT& __nfa);
+
+      static bool
+      _S_supports(_FlagT __flags);
+
+      // Runs __f on the cached DFA of __nfa, or on a new one.
+      template<typename _Func>
+	static int
+	_S_borrow(const _NFAT& __nfa, _Func __f);
+
+      template<typename _BiIter>
+	int
+	_M_scan(_BiIter __s, _BiIter __e, _FlagT __flags, bool __match_mode,
+		bool __want_start, _BiIter& __start);
+
+      template<typename _BiIter>
+	int
+	_M_scan_set(_BiIter __s, _BiIter __e, _FlagT __flags,
+		    bool __match_mode, vector<bool>& __found);
+
+      template<typename _BiIter>
+	int
+	_M_scan_longest(_BiIter __s, _BiIter __e, _FlagT __flags,
+			vector<bool>& __found, _BiIter& __start,
+			_BiIter& __end);
+
+      int
+      _M_start(bool __at_begin, bool __prev_word, bool __unanchored);
+
+      // Runs from the DFA state __st over [__p, __e).  Returns 1 as soon
+      // as a match ends if __first_end (leaving __p there), else only
+      // checks for one ending at __e.
+      template<typename _BiIter>
+	int
+	_M_run(int __st, _BiIter& __p, _BiIter __e, _FlagT __flags,
+	       bool __first_end);
+
+      int
+      _M_transition(int __st, unsigned char __c);
+
+      bool
+      _M_accepts_at_end(int __st, _FlagT __flags);
+
+      unsigned char
+      _M_ctx_at_end(int __st, _FlagT __flags) const;
+
+      // The patterns of a regex set with a match ending before __c.
+      const vector<size_t>&
+      _M_tags_before(int __st, unsigned char __c);
+
+      void
+      _M_tags_at_end(int __st, _FlagT __flags, vector<bool>& __found);
+
+      int
+      _M_intern(vector<_StateIdT>& __kernel, unsigned char __ctx);
+
+      void
+      _M_closure(const vector<_StateIdT>& __kernel, unsigned char __ctx,
+		 vector<_StateIdT>& __matchers, bool& __accept,
+		 vector<size_t>* __tags = nullptr);
+
+      const _NFAT&			_M_nfa;
+      bool				_M_usable;
+      vector<_DState>			_M_states;
+      vector<int>			_M_trans;	// 256 per state.
+      map<vector<_StateIdT>, int>	_M_index;	// Kernel + ctx.
+      bool				_M_word[256];
+      vector<unsigned>			_M_mark;
+      vector<_StateIdT>			_M_stack;
+      unsigned				_M_generation;
+      int				_M_flushes;
+      size_t				_M_state_limit;
+      int				_M_starts[8];	// By context, or -1.
+      // For regex sets, by 2 * state + whether at a word boundary.
+      map<int, vector<size_t>>		_M_tags;
+    };
+
+ //@} regex-detail
+} // namespace __detail
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
+
+#include <bits/regex_dfa.tcc>
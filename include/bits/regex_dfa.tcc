@@ -0,0 +1,528 @@
+// class template regex -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/**
+ *  @file bits/regex_dfa.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{regex}
+ */
+
+namespace std _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+namespace __detail
+{
+  template<typename _TraitsT>
+    _Lazy_dfa<_TraitsT>::
+    _Lazy_dfa(const _NFAT& __nfa)
+    : _M_nfa(__nfa), _M_usable(_S_supports(__nfa)), _M_generation(0),
+      _M_flushes(0),
+      _M_state_limit(std::max<size_t>(_GLIBCXX_REGEX_DFA_STATE_LIMIT,
+				      __nfa.size()))
+    {
+      std::fill_n(_M_starts, 8, -1);
+      if (!_M_usable)
+	return;
+      static const _CharT __s[2] = { 'w' };
+      const auto __w = _M_nfa._M_traits.lookup_classname(__s, __s+1);
+      for (unsigned __c = 0; __c < 256; ++__c)
+	_M_word[__c] = _M_nfa._M_traits.isctype(_CharT(__c), __w);
+      _M_mark.assign(_M_nfa.size(), 0);
+    }
+
+  template<typename _TraitsT>
+    bool _Lazy_dfa<_TraitsT>::
+    _S_supports(const _NFAT& __nfa)
+    {
+      if (sizeof(_CharT) != 1 || __nfa._M_has_backref)
+	return false;
+      for (const auto& __state : __nfa)
+	if (__state._M_opcode() == _S_opcode_subexpr_lookahead
+	    || __state._M_opcode() == _S_opcode_backref)
+	  return false;
+      return true;
+    }
+
+  template<typename _TraitsT>
+    bool _Lazy_dfa<_TraitsT>::
+    _S_supports(_FlagT __flags)
+    {
+      // \b at the beginning needs the character before it.
+      return sizeof(_CharT) == 1
+	&& !(__flags & regex_constants::match_not_null)
+	&& (!(__flags & regex_constants::match_not_bow)
+	    || (__flags & regex_constants::match_prev_avail));
+    }
+
+  template<typename _TraitsT>
+  template<typename _Func>
+    int _Lazy_dfa<_TraitsT>::
+    _S_borrow(const _NFAT& __nfa, _Func __f)
+    {
+      _Lazy_dfa* __dfa = __nfa._M_dfa_cache._M_take();
+      if (__dfa == nullptr)
+	__dfa = new _Lazy_dfa(__nfa);
+      int __ret = -1;
+      __try
+	{
+	  if (__dfa->_M_usable)
+	    __ret = __f(*__dfa);
+	}
+      __catch(...)
+	{
+	  // The cache may be half updated.
+	  delete __dfa;
+	  __throw_exception_again;
+	}
+      __nfa._M_dfa_cache._M_give_back(__dfa);
+      return __ret;
+    }
+
+  template<typename _TraitsT>
+  template<typename _BiIter>
+    int _Lazy_dfa<_TraitsT>::
+    _S_scan(const _NFAT& __nfa, _BiIter __s, _BiIter __e, _FlagT __flags,
+	    bool __match_mode, bool __want_start, _BiIter& __start)
+    {
+      if (!_S_supports(__flags))
+	return -1;
+      return _S_borrow(__nfa, [&](_Lazy_dfa& __dfa) {
+	return __dfa._M_scan(__s, __e, __flags, __match_mode, __want_start,
+			     __start);
+      });
+    }
+
+  template<typename _TraitsT>
+  template<typename _BiIter>
+    int _Lazy_dfa<_TraitsT>::
+    _S_scan_set(const _NFAT& __nfa, _BiIter __s, _BiIter __e,
+		_FlagT __flags, bool __match_mode, vector<bool>& __found)
+    {
+      if (!_S_supports(__flags))
+	return -1;
+      return _S_borrow(__nfa, [&](_Lazy_dfa& __dfa) {
+	return __dfa._M_scan_set(__s, __e, __flags, __match_mode, __found);
+      });
+    }
+
+  template<typename _TraitsT>
+  template<typename _BiIter>
+    int _Lazy_dfa<_TraitsT>::
+    _S_scan_longest(const _NFAT& __nfa, _BiIter __s, _BiIter __e,
+		    _FlagT __flags, vector<bool>& __found,
+		    _BiIter& __start, _BiIter& __end)
+    {
+      if (!_S_supports(__flags))
+	return -1;
+      return _S_borrow(__nfa, [&](_Lazy_dfa& __dfa) {
+	return __dfa._M_scan_longest(__s, __e, __flags, __found, __start,
+				     __end);
+      });
+    }
+
+  template<typename _TraitsT>
+  template<typename _BiIter>
+    int _Lazy_dfa<_TraitsT>::
+    _M_scan(_BiIter __s, _BiIter __e, _FlagT __flags, bool __match_mode,
+	    bool __want_start, _BiIter& __start)
+    {
+      const bool __at_begin = !(__flags & (regex_constants::match_not_bol
+					   | regex_constants::match_prev_avail));
+      const bool __prev_word = (__flags & regex_constants::match_prev_avail)
+	&& _M_word[static_cast<unsigned char>(*std::prev(__s))];
+      _M_flushes = 0;
+
+      if (__match_mode)
+	{
+	  const int __st = _M_start(__at_begin, __prev_word, false);
+	  if (__st < 0)
+	    return -1;
+	  _BiIter __p = __s;
+	  return _M_run(__st, __p, __e, __flags, false);
+	}
+
+      // A match starting at __s, or one starting anywhere.
+      const bool __continuous = __flags & regex_constants::match_continuous;
+      int __st = _M_start(__at_begin, __prev_word, !__continuous);
+      if (__st < 0)
+	return -1;
+      _BiIter __end = __s;
+      const int __ret = _M_run(__st, __end, __e, __flags, true);
+      if (__ret != 1 || !__want_start || __continuous)
+	{
+	  if (__ret == 1)
+	    __start = __s;
+	  return __ret;
+	}
+
+      // The match ending first starts no later than __end, and so does
+      // the leftmost one.  Try each start up to there.
+      bool __word = __prev_word;
+      for (_BiIter __p = __s; ; ++__p)
+	{
+	  __st = _M_start(__at_begin && __p == __s, __word, false);
+	  if (__st < 0)
+	    return -1;
+	  _BiIter __q = __p;
+	  const int __r = _M_run(__st, __q, __e, __flags, true);
+	  if (__r != 0)
+	    {
+	      if (__r == 1)
+		__start = __p;
+	      return __r;
+	    }
+	  if (__p == __end)
+	    return -1;
+	  __word = _M_word[static_cast<unsigned char>(*__p)];
+	}
+    }
+
+  template<typename _TraitsT>
+  template<typename _BiIter>
+    int _Lazy_dfa<_TraitsT>::
+    _M_scan_set(_BiIter __s, _BiIter __e, _FlagT __flags, bool __match_mode,
+		vector<bool>& __found)
+    {
+      const bool __at_begin = !(__flags & (regex_constants::match_not_bol
+					   | regex_constants::match_prev_avail));
+      const bool __prev_word = (__flags & regex_constants::match_prev_avail)
+	&& _M_word[static_cast<unsigned char>(*std::prev(__s))];
+      _M_flushes = 0;
+
+      int __st = _M_start(__at_begin, __prev_word,
+			  !__match_mode
+			  && !(__flags & regex_constants::match_continuous));
+      if (__st < 0)
+	return -1;
+      for (; __s != __e; ++__s)
+	{
+	  const unsigned char __c = static_cast<unsigned char>(*__s);
+	  int __t = _M_trans[(size_t)__st * 256 + __c];
+	  // Look at the tags while __st still exists.
+	  if (!__match_mode && (__t == _S_unknown || (__t & _S_accept)))
+	    for (auto __i : _M_tags_before(__st, __c))
+	      __found[__i] = true;
+	  if (__t == _S_unknown)
+	    {
+	      __t = _M_transition(__st, __c);
+	      if (__t == _S_give_up)
+		return -1;
+	    }
+	  if (__t & _S_dead)
+	    return 1;
+	  __st = __t >> 2;
+	}
+      _M_tags_at_end(__st, __flags, __found);
+      return 1;
+    }
+
+  template<typename _TraitsT>
+  template<typename _BiIter>
+    int _Lazy_dfa<_TraitsT>::
+    _M_scan_longest(_BiIter __s, _BiIter __e, _FlagT __flags,
+		    vector<bool>& __found, _BiIter& __start, _BiIter& __end)
+    {
+      const int __ret = _M_scan(__s, __e, __flags, false, true, __start);
+      if (__ret != 1)
+	return __ret;
+
+      // Every match from __start, keeping the tags of the last one.
+      const bool __at_begin = __start == __s
+	&& !(__flags & (regex_constants::match_not_bol
+			| regex_constants::match_prev_avail));
+      const bool __prev_word = (__start != __s
+				|| (__flags & regex_constants::match_prev_avail))
+	&& _M_word[static_cast<unsigned char>(*std::prev(__start))];
+      int __st = _M_start(__at_begin, __prev_word, false);
+      if (__st < 0)
+	return -1;
+      for (_BiIter __p = __start; __p != __e; ++__p)
+	{
+	  const unsigned char __c = static_cast<unsigned char>(*__p);
+	  int __t = _M_trans[(size_t)__st * 256 + __c];
+	  if (__t == _S_unknown || (__t & _S_accept))
+	    {
+	      const vector<size_t>& __tags = _M_tags_before(__st, __c);
+	      if (!__tags.empty())
+		{
+		  __found.assign(__found.size(), false);
+		  for (auto __i : __tags)
+		    __found[__i] = true;
+		  __end = __p;
+		}
+	    }
+	  if (__t == _S_unknown)
+	    {
+	      __t = _M_transition(__st, __c);
+	      if (__t == _S_give_up)
+		return -1;
+	    }
+	  if (__t & _S_dead)
+	    return 1;
+	  __st = __t >> 2;
+	}
+      if (_M_accepts_at_end(__st, __flags))
+	{
+	  __found.assign(__found.size(), false);
+	  _M_tags_at_end(__st, __flags, __found);
+	  __end = __e;
+	}
+      return 1;
+    }
+
+  template<typename _TraitsT>
+    int _Lazy_dfa<_TraitsT>::
+    _M_start(bool __at_begin, bool __prev_word, bool __unanchored)
+    {
+      const unsigned char __ctx = (__at_begin ? _S_ctx_begin : 0)
+	| (__prev_word ? _S_ctx_word : 0)
+	| (__unanchored ? _S_ctx_unanchored : 0);
+      int& __st = _M_starts[__ctx];
+      if (__st < 0)
+	{
+	  vector<_StateIdT> __kernel(1, _M_nfa._M_start());
+	  __st = _M_intern(__kernel, __ctx);
+	}
+      return __st;
+    }
+
+  template<typename _TraitsT>
+  template<typename _BiIter>
+    int _Lazy_dfa<_TraitsT>::
+    _M_run(int __st, _BiIter& __p, _BiIter __e, _FlagT __flags,
+	   bool __first_end)
+    {
+      for (; __p != __e; ++__p)
+	{
+	  const unsigned char __c = static_cast<unsigned char>(*__p);
+	  int __t = _M_trans[(size_t)__st * 256 + __c];
+	  if (__t == _S_unknown)
+	    {
+	      __t = _M_transition(__st, __c);
+	      if (__t == _S_give_up)
+		return -1;
+	    }
+	  if (__first_end && (__t & _S_accept))
+	    return 1;
+	  if (__t & _S_dead)
+	    return 0;
+	  __st = __t >> 2;
+	}
+      return _M_accepts_at_end(__st, __flags) ? 1 : 0;
+    }
+
+  template<typename _TraitsT>
+    int _Lazy_dfa<_TraitsT>::
+    _M_transition(int __st, unsigned char __c)
+    {
+      const unsigned char __ctx = _M_states[__st]._M_ctx;
+      const bool __word = _M_word[__c];
+      unsigned char __here = __ctx & _S_ctx_begin;
+      if (bool(__ctx & _S_ctx_word) != __word)
+	__here |= _S_ctx_boundary;
+
+      vector<_StateIdT> __matchers;
+      bool __accept = false;
+      _M_closure(_M_states[__st]._M_kernel, __here, __matchers, __accept);
+
+      vector<_StateIdT> __next;
+      for (auto __i : __matchers)
+	if (_M_nfa[__i]._M_matches(_CharT(__c)))
+	  __next.push_back(_M_nfa[__i]._M_next);
+      const bool __dead = __next.empty()
+	&& !(__ctx & _S_ctx_unanchored);
+      if (__ctx & _S_ctx_unanchored)
+	__next.push_back(_M_nfa._M_start());
+
+      const int __flushes = _M_flushes;
+      const int __target = _M_intern(__next, (__word ? _S_ctx_word : 0)
+				     | (__ctx & _S_ctx_unanchored));
+      if (__target < 0)
+	return _S_give_up;
+      const int __t = (__target << 2) | (__dead ? _S_dead : 0)
+	| (__accept ? _S_accept : 0);
+      // After a flush __st no longer exists.
+      if (__flushes == _M_flushes)
+	_M_trans[(size_t)__st * 256 + __c] = __t;
+      return __t;
+    }
+
+  template<typename _TraitsT>
+    bool _Lazy_dfa<_TraitsT>::
+    _M_accepts_at_end(int __st, _FlagT __flags)
+    {
+      const bool __not_eol = __flags & regex_constants::match_not_eol;
+      const bool __not_eow = __flags & regex_constants::match_not_eow;
+      signed char& __ret = _M_states[__st]._M_eof[__not_eol | __not_eow << 1];
+      if (__ret < 0)
+	{
+	  vector<_StateIdT> __matchers;
+	  bool __accept = false;
+	  _M_closure(_M_states[__st]._M_kernel, _M_ctx_at_end(__st, __flags),
+		     __matchers, __accept);
+	  __ret = __accept;
+	}
+      return __ret;
+    }
+
+  template<typename _TraitsT>
+    unsigned char _Lazy_dfa<_TraitsT>::
+    _M_ctx_at_end(int __st, _FlagT __flags) const
+    {
+      const unsigned char __ctx = _M_states[__st]._M_ctx;
+      unsigned char __here = __ctx & _S_ctx_begin;
+      if (!(__flags & regex_constants::match_not_eol))
+	__here |= _S_ctx_end;
+      if ((__ctx & _S_ctx_word) && !(__flags & regex_constants::match_not_eow))
+	__here |= _S_ctx_boundary;
+      return __here;
+    }
+
+  template<typename _TraitsT>
+    const vector<size_t>& _Lazy_dfa<_TraitsT>::
+    _M_tags_before(int __st, unsigned char __c)
+    {
+      const unsigned char __ctx = _M_states[__st]._M_ctx;
+      const bool __boundary = bool(__ctx & _S_ctx_word) != _M_word[__c];
+      auto __it = _M_tags.find(2 * __st + __boundary);
+      if (__it == _M_tags.end())
+	{
+	  vector<_StateIdT> __matchers;
+	  vector<size_t> __tags;
+	  bool __accept = false;
+	  _M_closure(_M_states[__st]._M_kernel,
+		     (__ctx & _S_ctx_begin) | (__boundary ? _S_ctx_boundary : 0),
+		     __matchers, __accept, &__tags);
+	  __it = _M_tags.emplace(2 * __st + __boundary, std::move(__tags)).first;
+	}
+      return __it->second;
+    }
+
+  template<typename _TraitsT>
+    void _Lazy_dfa<_TraitsT>::
+    _M_tags_at_end(int __st, _FlagT __flags, vector<bool>& __found)
+    {
+      vector<_StateIdT> __matchers;
+      vector<size_t> __tags;
+      bool __accept = false;
+      _M_closure(_M_states[__st]._M_kernel, _M_ctx_at_end(__st, __flags),
+		 __matchers, __accept, &__tags);
+      for (auto __i : __tags)
+	__found[__i] = true;
+    }
+
+  template<typename _TraitsT>
+    int _Lazy_dfa<_TraitsT>::
+    _M_intern(vector<_StateIdT>& __kernel, unsigned char __ctx)
+    {
+      std::sort(__kernel.begin(), __kernel.end());
+      __kernel.erase(std::unique(__kernel.begin(), __kernel.end()),
+		     __kernel.end());
+      // State ids are non-negative, so the context cannot be mistaken
+      // for one.
+      vector<_StateIdT> __key(__kernel);
+      __key.push_back(-1 - _StateIdT(__ctx));
+      auto __it = _M_index.find(__key);
+      if (__it != _M_index.end())
+	return __it->second;
+
+      if (_M_states.size() >= _M_state_limit)
+	{
+	  if (++_M_flushes > _S_max_flushes)
+	    return -1;
+	  _M_states.clear();
+	  _M_trans.clear();
+	  _M_index.clear();
+	  _M_tags.clear();
+	  std::fill_n(_M_starts, 8, -1);
+	}
+      const int __id = _M_states.size();
+      _M_states.push_back({ std::move(__kernel), __ctx, { -1, -1, -1, -1 } });
+      _M_trans.resize(_M_trans.size() + 256, _S_unknown);
+      _M_index.emplace(std::move(__key), __id);
+      return __id;
+    }
+
+  template<typename _TraitsT>
+    void _Lazy_dfa<_TraitsT>::
+    _M_closure(const vector<_StateIdT>& __kernel, unsigned char __ctx,
+	       vector<_StateIdT>& __matchers, bool& __accept,
+	       vector<size_t>* __tags)
+    {
+      if (++_M_generation == 0)
+	{
+	  std::fill(_M_mark.begin(), _M_mark.end(), 0);
+	  _M_generation = 1;
+	}
+      _M_stack.assign(__kernel.begin(), __kernel.end());
+      while (!_M_stack.empty())
+	{
+	  const _StateIdT __i = _M_stack.back();
+	  _M_stack.pop_back();
+	  if (__i < 0 || _M_mark[__i] == _M_generation)
+	    continue;
+	  _M_mark[__i] = _M_generation;
+	  const auto& __state = _M_nfa[__i];
+	  switch (__state._M_opcode())
+	    {
+	    case _S_opcode_alternative:
+	    case _S_opcode_repeat:
+	      _M_stack.push_back(__state._M_next);
+	      _M_stack.push_back(__state._M_alt);
+	      break;
+	    case _S_opcode_subexpr_begin:
+	    case _S_opcode_subexpr_end:
+	    case _S_opcode_dummy:
+	      _M_stack.push_back(__state._M_next);
+	      break;
+	    case _S_opcode_line_begin_assertion:
+	      if (__ctx & _S_ctx_begin)
+		_M_stack.push_back(__state._M_next);
+	      break;
+	    case _S_opcode_line_end_assertion:
+	      if (__ctx & _S_ctx_end)
+		_M_stack.push_back(__state._M_next);
+	      break;
+	    case _S_opcode_word_boundary:
+	      if (bool(__ctx & _S_ctx_boundary) == !__state._M_neg)
+		_M_stack.push_back(__state._M_next);
+	      break;
+	    case _S_opcode_match:
+	      __matchers.push_back(__i);
+	      break;
+	    case _S_opcode_accept:
+	      __accept = true;
+	      if (__tags)
+		__tags->push_back(__state._M_subexpr);
+	      break;
+	    default:
+	      break;
+	    }
+	}
+    }
+} // namespace __detail
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace std
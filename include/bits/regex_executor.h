@@ -41,11 +41,87 @@ namespace __detail
    * @{
    */
 
+  // What is left to do after a state handler of _Executor returns, in
+  // reverse order.  Handlers push these instead of recursing, and set
+  // _M_then to the state to visit before any of them.
+  enum _Frame_op : unsigned char
+  {
+    // These four resume at _M_pos.
+    _S_fop_next,			// Visit _M_id.
+    _S_fop_fallback_next,		// Visit _M_id unless there is a match.
+    _S_fop_fallback_rep_once_more,	// _M_rep_once_more(_M_id), likewise.
+    _S_fop_posix_alternative,		// The right branch of POSIX |.
+    _S_fop_merge_sol,			// _M_has_sol |= _M_val.
+    _S_fop_restore_sub_first,		// Of subexpression _M_id.
+    _S_fop_restore_sub_second,		// And its matched, from _M_val.
+    _S_fop_restore_rep_count,		// _M_rep_count[_M_id] = (_M_pos, _M_val).
+    _S_fop_decrement_rep_count		// --_M_rep_count[_M_id].second.
+  };
+
+  // _M_id is a state or subexpression index, both below
+  // _GLIBCXX_REGEX_STATE_LIMIT, and _M_val a repeat count (at most 2) or
+  // a flag, so a frame over a pointer takes 16 bytes rather than 24.
+  template<typename _BiIter>
+    struct _Executor_frame
+    {
+      static_assert(_GLIBCXX_REGEX_STATE_LIMIT <= __INT_MAX__,
+		    "state indices fit in an int");
+
+      _Executor_frame(_Frame_op __op, _StateIdT __id, _BiIter __pos,
+		      int __val)
+      : _M_pos(__pos), _M_id(__id), _M_op(__op), _M_val(__val)
+      { }
+
+      _BiIter		_M_pos;
+      int		_M_id;
+      _Frame_op		_M_op;
+      unsigned char	_M_val;
+    };
+
+  /**
+   * @brief The buffers of an _Executor, kept from one match to the next.
+   *
+   * An _Executor given a context takes its buffers over and hands them
+   * back when destroyed, so matching the same regex again allocates
+   * nothing once they have grown large enough.  A context must not be
+   * used by two executors at once.  Copies start out empty.
+   */
+  template<typename _BiIter, typename _Alloc>
+    struct _Match_context
+    {
+      typedef std::vector<sub_match<_BiIter>, _Alloc>	_ResultsVec;
+      typedef vector<pair<_StateIdT, _ResultsVec>>	_QueueT;
+
+      _Match_context() = default;
+
+      _Match_context(const _Match_context&)
+      : _Match_context()
+      { }
+
+      _Match_context&
+      operator=(const _Match_context&)
+      { return *this; }
+
+      _ResultsVec				_M_cur_results;
+      vector<pair<_BiIter, int>>		_M_rep_count;
+      vector<_Executor_frame<_BiIter>>	_M_frames;
+      // For BFS mode.
+      _QueueT					_M_match_queue;
+      _QueueT					_M_old_queue;
+      unique_ptr<bool[]>			_M_visited_states;
+      size_t					_M_visited_size = 0;
+    };
+
   /**
    * @brief Takes a regex and an input string and does the matching.
    *
    * The %_Executor class has two modes: DFS mode and BFS mode, controlled
    * by the template parameter %__dfs_mode.
+   *
+   * Both walk the NFA with an explicit stack of frames rather than by
+   * recursion, so long inputs cannot overflow the call stack.  Each state
+   * visited counts as a step; once __max_steps steps have been taken the
+   * executor throws regex_error(regex_constants::error_complexity).
    */
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
 	   bool __dfs_mode>
@@ -64,26 +140,45 @@ namespace __detail
       typedef regex_constants::match_flag_type              _FlagT;
       typedef typename _TraitsT::char_class_type            _ClassT;
       typedef _NFA<_TraitsT>                                _NFAT;
+      typedef _Match_context<_BiIter, _Alloc>               _ContextT;
 
     public:
       _Executor(_BiIter         __begin,
 		_BiIter         __end,
 		_ResultsVec&    __results,
 		const _RegexT&  __re,
-		_FlagT          __flags)
+		_FlagT          __flags,
+		size_t          __max_steps,
+		_ContextT*      __ctx = nullptr)
       : _M_begin(__begin),
       _M_end(__end),
       _M_re(__re),
       _M_nfa(*__re._M_automaton),
       _M_results(__results),
-      _M_rep_count(_M_nfa.size()),
-      _M_states(_M_nfa._M_start(), _M_nfa.size()),
+      _M_states(_M_nfa._M_start()),
       _M_flags((__flags & regex_constants::match_prev_avail)
 	       ? (__flags
 		  & ~regex_constants::match_not_bol
 		  & ~regex_constants::match_not_bow)
-	       : __flags)
-      { }
+	       : __flags),
+      _M_steps_left(__max_steps),
+      _M_ctx(__ctx)
+      {
+	if (_M_ctx)
+	  _M_swap_buffers(*_M_ctx);
+	_M_rep_count.assign(_M_nfa.size(), pair<_BiIter, int>());
+	_M_states._M_init(_M_nfa.size());
+      }
+
+      ~_Executor()
+      {
+	if (_M_ctx)
+	  {
+	    // The frame stack must not refer to the vector it hands back.
+	    _M_frames._M_clear();
+	    _M_swap_buffers(*_M_ctx);
+	  }
+      }
 
       // Set matched when string exactly matches the pattern.
       bool
@@ -141,9 +236,16 @@ namespace __detail
       void
       _M_handle_alternative(_Match_mode, _StateIdT);
 
+      // Visits __start and everything reachable from it, draining
+      // _M_then and _M_frames.
       void
       _M_dfs(_Match_mode __match_mode, _StateIdT __start);
 
+      // Visits state __i; only _M_dfs calls it, and inlined there it
+      // costs no more per state than the recursion it replaced.
+      void
+      _M_node(_Match_mode __match_mode, _StateIdT __i);
+
       bool
       _M_main(_Match_mode __match_mode)
       { return _M_main_dispatch(__match_mode, __search_mode{}); }
@@ -183,6 +285,15 @@ namespace __detail
       bool
       _M_lookahead(_StateIdT __next);
 
+      void
+      _M_swap_buffers(_ContextT& __ctx)
+      {
+	_M_cur_results.swap(__ctx._M_cur_results);
+	_M_rep_count.swap(__ctx._M_rep_count);
+	_M_frames._M_swap_heap(__ctx._M_frames);
+	_M_states._M_swap_buffers(__ctx);
+      }
+
        // Holds additional information used in BFS-mode.
       template<typename _SearchMode, typename _ResultsVec>
 	struct _State_info;
@@ -191,10 +302,27 @@ namespace __detail
 	struct _State_info<__bfs, _ResultsVec>
 	{
 	  explicit
-	  _State_info(_StateIdT __start, size_t __n)
-	  : _M_visited_states(new bool[__n]()), _M_start(__start)
+	  _State_info(_StateIdT __start)
+	  : _M_queued(0), _M_visited_size(0), _M_start(__start)
 	  { }
 
+	  void _M_init(size_t __n)
+	  {
+	    if (_M_visited_size != __n)
+	      {
+		_M_visited_states.reset(new bool[__n]());
+		_M_visited_size = __n;
+	      }
+	  }
+
+	  void _M_swap_buffers(_ContextT& __ctx)
+	  {
+	    _M_match_queue.swap(__ctx._M_match_queue);
+	    _M_old_queue.swap(__ctx._M_old_queue);
+	    _M_visited_states.swap(__ctx._M_visited_states);
+	    std::swap(_M_visited_size, __ctx._M_visited_size);
+	  }
+
 	  bool _M_visited(_StateIdT __i)
 	  {
 	    if (_M_visited_states[__i])
@@ -203,16 +331,30 @@ namespace __detail
 	    return false;
 	  }
 
+	  // Entries past _M_queued are kept for their buffers.
 	  void _M_queue(_StateIdT __i, const _ResultsVec& __res)
-	  { _M_match_queue.emplace_back(__i, __res); }
+	  {
+	    if (_M_queued < _M_match_queue.size())
+	      {
+		_M_match_queue[_M_queued].first = __i;
+		_M_match_queue[_M_queued].second = __res;
+	      }
+	    else
+	      _M_match_queue.emplace_back(__i, __res);
+	    ++_M_queued;
+	  }
 
 	  // Dummy implementations for BFS mode.
 	  _BiIter* _M_get_sol_pos() { return nullptr; }
 
 	  // Saves states that need to be considered for the next character.
 	  vector<pair<_StateIdT, _ResultsVec>>	_M_match_queue;
+	  size_t				_M_queued;
+	  // Those being considered for this one.
+	  vector<pair<_StateIdT, _ResultsVec>>	_M_old_queue;
 	  // Indicates which states are already visited.
 	  unique_ptr<bool[]>			_M_visited_states;
+	  size_t				_M_visited_size;
 	  // To record current solution.
 	  _StateIdT _M_start;
 	};
@@ -221,10 +363,12 @@ namespace __detail
 	struct _State_info<__dfs, _ResultsVec>
 	{
 	  explicit
-	  _State_info(_StateIdT __start, size_t) : _M_start(__start)
+	  _State_info(_StateIdT __start) : _M_start(__start)
 	  { }
 
 	  // Dummy implementations for DFS mode.
+	  void _M_init(size_t) { }
+	  void _M_swap_buffers(_ContextT&) { }
 	  bool _M_visited(_StateIdT) const { return false; }
 	  void _M_queue(_StateIdT, const _ResultsVec&) { }
 
@@ -235,6 +379,77 @@ namespace __detail
 	  _BiIter   _M_sol_pos;
 	};
 
+      typedef _Executor_frame<_BiIter> _Frame;
+
+      // Most matches need few frames, so the first ones are kept in the
+      // executor itself, uninitialized until pushed, and only deeper
+      // stacks allocate.
+      class _Frame_stack
+      {
+      public:
+	_Frame_stack() : _M_size(0) { }
+
+	_Frame_stack(const _Frame_stack&) = delete;
+	_Frame_stack& operator=(const _Frame_stack&) = delete;
+
+	~_Frame_stack()
+	{ _M_clear(); }
+
+	// Drops the frames left, as when a match is abandoned by an
+	// exception, keeping the heap storage.
+	void
+	_M_clear()
+	{
+	  for (size_t __i = std::min<size_t>(_M_size, _S_local_frames);
+	       __i > 0; --__i)
+	    _M_local[__i - 1]._M_ptr()->~_Frame();
+	  _M_heap.clear();
+	  _M_size = 0;
+	}
+
+	bool
+	_M_empty() const
+	{ return _M_size == 0; }
+
+	void
+	_M_push(_Frame_op __op, _StateIdT __id, _BiIter __pos = _BiIter(),
+		int __val = 0)
+	{
+	  if (_M_size < _S_local_frames)
+	    ::new (_M_local[_M_size]._M_addr())
+	      _Frame(__op, __id, __pos, __val);
+	  else
+	    _M_heap.emplace_back(__op, __id, __pos, __val);
+	  ++_M_size;
+	}
+
+	_Frame
+	_M_pop()
+	{
+	  if (--_M_size < _S_local_frames)
+	    {
+	      _Frame* __p = _M_local[_M_size]._M_ptr();
+	      _Frame __f = std::move(*__p);
+	      __p->~_Frame();
+	      return __f;
+	    }
+	  _Frame __f = std::move(_M_heap.back());
+	  _M_heap.pop_back();
+	  return __f;
+	}
+
+	void
+	_M_swap_heap(vector<_Frame>& __v)
+	{ _M_heap.swap(__v); }
+
+      private:
+	enum { _S_local_frames = 32 };
+
+	size_t					_M_size;
+	__gnu_cxx::__aligned_membuf<_Frame>	_M_local[_S_local_frames];
+	vector<_Frame>				_M_heap;
+      };
+
     public:
       _ResultsVec                                           _M_cur_results;
       _BiIter                                               _M_current;
@@ -248,6 +463,10 @@ namespace __detail
       _FlagT                                                _M_flags;
       // Do we have a solution so far?
       bool                                                  _M_has_sol;
+      _Frame_stack                                          _M_frames;
+      _StateIdT                                             _M_then;
+      size_t                                                _M_steps_left;
+      _ContextT*                                            _M_ctx;
     };
 
  //@} regex-detail
@@ -44,9 +44,19 @@ namespace __detail
       if (_M_flags & regex_constants::match_continuous)
 	return false;
       _M_flags |= regex_constants::match_prev_avail;
+      // Every match begins with the literal prefix, if there is one, so
+      // only its occurrences are worth trying.
+      const auto& __prefix = _M_nfa._M_literal_prefix;
       while (_M_begin != _M_end)
 	{
 	  ++_M_begin;
+	  if (!__prefix.empty())
+	    {
+	      _M_begin = std::search(_M_begin, _M_end,
+				     __prefix.begin(), __prefix.end());
+	      if (_M_begin == _M_end)
+		return false;
+	    }
 	  if (_M_search_from_first())
 	    return true;
 	}
@@ -64,7 +74,8 @@ namespace __detail
   // It applies a Depth-First-Search (aka backtracking) on given NFA and input
   // string.
   // At the very beginning the executor stands in the start state, then it
-  // tries every possible state transition in current state recursively. Some
+  // tries every possible state transition in current state in turn, using
+  // _M_frames as the stack of what to try or undo next. Some
   // state transitions consume input string, say, a single-char-matcher or a
   // back-reference matcher; some don't, like assertion or other anchor nodes.
   // When the input is exhausted and/or the current state is an accepting
@@ -120,13 +131,18 @@ namespace __detail
       while (1)
 	{
 	  _M_has_sol = false;
-	  if (_M_states._M_match_queue.empty())
+	  if (_M_states._M_queued == 0)
 	    break;
 	  std::fill_n(_M_states._M_visited_states.get(), _M_nfa.size(), false);
-	  auto __old_queue = std::move(_M_states._M_match_queue);
-	  for (auto& __task : __old_queue)
+	  // Both queues keep their entries, and the submatches in them, so
+	  // that a warm _Match_context does not allocate.
+	  _M_states._M_old_queue.swap(_M_states._M_match_queue);
+	  const size_t __n = _M_states._M_queued;
+	  _M_states._M_queued = 0;
+	  for (size_t __j = 0; __j < __n; ++__j)
 	    {
-	      _M_cur_results = std::move(__task.second);
+	      auto& __task = _M_states._M_old_queue[__j];
+	      _M_cur_results = __task.second;
 	      _M_dfs(__match_mode, __task.first);
 	    }
 	  if (__match_mode == _Match_mode::_Prefix)
@@ -137,7 +153,7 @@ namespace __detail
 	}
       if (__match_mode == _Match_mode::_Exact)
 	__ret = _M_has_sol;
-      _M_states._M_match_queue.clear();
+      _M_states._M_queued = 0;
       return __ret;
     }
 
@@ -151,9 +167,12 @@ namespace __detail
       // We may want to make this faster by not copying,
       // but let's not be clever prematurely.
       _ResultsVec __what(_M_cur_results);
-      _Executor __sub(_M_current, _M_end, __what, _M_re, _M_flags);
+      _Executor __sub(_M_current, _M_end, __what, _M_re, _M_flags,
+		      _M_steps_left);
       __sub._M_states._M_start = __next;
-      if (__sub._M_search_from_first())
+      const bool __ret = __sub._M_search_from_first();
+      _M_steps_left = __sub._M_steps_left;
+      if (__ret)
 	{
 	  for (size_t __i = 0; __i < __what.size(); __i++)
 	    if (__what[__i].matched)
@@ -178,19 +197,19 @@ namespace __detail
       auto& __rep_count = _M_rep_count[__i];
       if (__rep_count.second == 0 || __rep_count.first != _M_current)
 	{
-	  auto __back = __rep_count;
+	  _M_frames._M_push(_S_fop_restore_rep_count, __i,
+			    __rep_count.first, __rep_count.second);
 	  __rep_count.first = _M_current;
 	  __rep_count.second = 1;
-	  _M_dfs(__match_mode, __state._M_alt);
-	  __rep_count = __back;
+	  _M_then = __state._M_alt;
 	}
       else
 	{
 	  if (__rep_count.second < 2)
 	    {
 	      __rep_count.second++;
-	      _M_dfs(__match_mode, __state._M_alt);
-	      __rep_count.second--;
+	      _M_frames._M_push(_S_fop_decrement_rep_count, __i);
+	      _M_then = __state._M_alt;
 	    }
 	}
     }
@@ -199,6 +218,9 @@ namespace __detail
   // of this quantifier". Executing _M_next first or _M_alt first don't
   // mean the same thing, and we need to choose the correct order under
   // given greedy mode.
+  //
+  // Frames run in the reverse order they are pushed, so the branch to
+  // try second is pushed first; the branch to try first is _M_then.
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
 	   bool __dfs_mode>
     void _Executor<_BiIter, _Alloc, _TraitsT, __dfs_mode>::
@@ -209,19 +231,19 @@ namespace __detail
       // Greedy.
       if (!__state._M_neg)
 	{
-	  _M_rep_once_more(__match_mode, __i);
 	  // If it's DFS executor and already accepted, we're done.
-	  if (!__dfs_mode || !_M_has_sol)
-	    _M_dfs(__match_mode, __state._M_next);
+	  _M_frames._M_push(__dfs_mode ? _S_fop_fallback_next
+			    : _S_fop_next, __state._M_next, _M_current);
+	  _M_rep_once_more(__match_mode, __i);
 	}
       else // Non-greedy mode
 	{
 	  if (__dfs_mode)
 	    {
 	      // vice-versa.
-	      _M_dfs(__match_mode, __state._M_next);
-	      if (!_M_has_sol)
-		_M_rep_once_more(__match_mode, __i);
+	      _M_frames._M_push(_S_fop_fallback_rep_once_more, __i,
+				_M_current);
+	      _M_then = __state._M_next;
 	    }
 	  else
 	    {
@@ -230,12 +252,12 @@ namespace __detail
 	      // be better by attempting its next node.
 	      if (!_M_has_sol)
 		{
-		  _M_dfs(__match_mode, __state._M_next);
 		  // DON'T attempt anything if it's already accepted. An
 		  // accepted state *must* be better than a solution that
 		  // matches a non-greedy quantifier one more time.
-		  if (!_M_has_sol)
-		    _M_rep_once_more(__match_mode, __i);
+		  _M_frames._M_push(_S_fop_fallback_rep_once_more, __i,
+				    _M_current);
+		  _M_then = __state._M_next;
 		}
 	    }
 	}
@@ -249,10 +271,10 @@ namespace __detail
       const auto& __state = _M_nfa[__i];
 
       auto& __res = _M_cur_results[__state._M_subexpr];
-      auto __back = __res.first;
+      _M_frames._M_push(_S_fop_restore_sub_first, __state._M_subexpr,
+			__res.first);
       __res.first = _M_current;
-      _M_dfs(__match_mode, __state._M_next);
-      __res.first = __back;
+      _M_then = __state._M_next;
     }
 
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
@@ -263,11 +285,11 @@ namespace __detail
       const auto& __state = _M_nfa[__i];
 
       auto& __res = _M_cur_results[__state._M_subexpr];
-      auto __back = __res;
+      _M_frames._M_push(_S_fop_restore_sub_second, __state._M_subexpr,
+			__res.second, __res.matched);
       __res.second = _M_current;
       __res.matched = true;
-      _M_dfs(__match_mode, __state._M_next);
-      __res = __back;
+      _M_then = __state._M_next;
     }
 
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
@@ -277,7 +299,7 @@ namespace __detail
     {
       const auto& __state = _M_nfa[__i];
       if (_M_at_begin())
-	_M_dfs(__match_mode, __state._M_next);
+	_M_then = __state._M_next;
     }
 
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
@@ -287,7 +309,7 @@ namespace __detail
     {
       const auto& __state = _M_nfa[__i];
       if (_M_at_end())
-	_M_dfs(__match_mode, __state._M_next);
+	_M_then = __state._M_next;
     }
 
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
@@ -297,11 +319,11 @@ namespace __detail
     {
       const auto& __state = _M_nfa[__i];
       if (_M_word_boundary() == !__state._M_neg)
-	_M_dfs(__match_mode, __state._M_next);
+	_M_then = __state._M_next;
     }
 
   // Here __state._M_alt offers a single start node for a sub-NFA.
-  // We recursively invoke our algorithm to match the sub-NFA.
+  // A nested executor matches the sub-NFA.
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
 	   bool __dfs_mode>
     void _Executor<_BiIter, _Alloc, _TraitsT, __dfs_mode>::
@@ -309,7 +331,7 @@ namespace __detail
     {
       const auto& __state = _M_nfa[__i];
       if (_M_lookahead(__state._M_alt) == !__state._M_neg)
-	_M_dfs(__match_mode, __state._M_next);
+	_M_then = __state._M_next;
     }
 
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
@@ -326,8 +348,7 @@ namespace __detail
 	  if (__state._M_matches(*_M_current))
 	    {
 	      ++_M_current;
-	      _M_dfs(__match_mode, __state._M_next);
-	      --_M_current;
+	      _M_then = __state._M_next;
 	    }
 	}
       else
@@ -408,15 +429,8 @@ namespace __detail
 	      _M_re._M_automaton->_M_traits)._M_apply(
 		  __submatch.first, __submatch.second, _M_current, __last))
 	{
-	  if (__last != _M_current)
-	    {
-	      auto __backup = _M_current;
-	      _M_current = __last;
-	      _M_dfs(__match_mode, __state._M_next);
-	      _M_current = __backup;
-	    }
-	  else
-	    _M_dfs(__match_mode, __state._M_next);
+	  _M_current = __last;
+	  _M_then = __state._M_next;
 	}
     }
 
@@ -484,30 +498,110 @@ namespace __detail
       if (_M_nfa._M_flags & regex_constants::ECMAScript)
 	{
 	  // TODO: Fix BFS support. It is wrong.
-	  _M_dfs(__match_mode, __state._M_alt);
 	  // Pick lhs if it matches. Only try rhs if it doesn't.
-	  if (!_M_has_sol)
-	    _M_dfs(__match_mode, __state._M_next);
+	  _M_frames._M_push(_S_fop_fallback_next, __state._M_next,
+			    _M_current);
+	  _M_then = __state._M_alt;
 	}
       else
 	{
 	  // Try both and compare the result.
 	  // See "case _S_opcode_accept:" handling above.
-	  _M_dfs(__match_mode, __state._M_alt);
-	  auto __has_sol = _M_has_sol;
-	  _M_has_sol = false;
-	  _M_dfs(__match_mode, __state._M_next);
-	  _M_has_sol |= __has_sol;
+	  _M_frames._M_push(_S_fop_posix_alternative, __state._M_next,
+			    _M_current);
+	  _M_then = __state._M_alt;
 	}
     }
 
   template<typename _BiIter, typename _Alloc, typename _TraitsT,
 	   bool __dfs_mode>
     void _Executor<_BiIter, _Alloc, _TraitsT, __dfs_mode>::
-    _M_dfs(_Match_mode __match_mode, _StateIdT __i)
+    _M_dfs(_Match_mode __match_mode, _StateIdT __start)
+    {
+      // Frames that go down another branch carry the position to resume
+      // at, so moving forward needs nothing to undo it.
+      const _BiIter __current = _M_current;
+      _M_then = __start;
+      for (;;)
+	{
+	  if (_M_then != _S_invalid_state_id)
+	    {
+	      const _StateIdT __i = _M_then;
+	      _M_then = _S_invalid_state_id;
+	      _M_node(__match_mode, __i);
+	      continue;
+	    }
+	  if (_M_frames._M_empty())
+	    break;
+	  // ECMAScript takes the first match, so once there is one the
+	  // frames left would only be skipped or undo changes that no-one
+	  // reads again: the executor is done, and the next one resets
+	  // _M_rep_count.
+	  if (__dfs_mode && _M_has_sol
+	      && (_M_nfa._M_flags & regex_constants::ECMAScript))
+	    {
+	      _M_frames._M_clear();
+	      break;
+	    }
+	  // Handlers push frames, so take this one off first.
+	  const _Frame __f = _M_frames._M_pop();
+	  switch (__f._M_op)
+	    {
+	    case _S_fop_fallback_next:
+	      if (_M_has_sol)
+		break;
+	      // fallthrough
+	    case _S_fop_next:
+	      _M_current = __f._M_pos;
+	      _M_then = __f._M_id;
+	      break;
+	    case _S_fop_fallback_rep_once_more:
+	      if (_M_has_sol)
+		break;
+	      _M_current = __f._M_pos;
+	      _M_rep_once_more(__match_mode, __f._M_id);
+	      break;
+	    case _S_fop_posix_alternative:
+	      _M_frames._M_push(_S_fop_merge_sol, 0, _BiIter(),
+				_M_has_sol);
+	      _M_has_sol = false;
+	      _M_current = __f._M_pos;
+	      _M_then = __f._M_id;
+	      break;
+	    case _S_fop_merge_sol:
+	      _M_has_sol |= bool(__f._M_val);
+	      break;
+	    case _S_fop_restore_sub_first:
+	      _M_cur_results[__f._M_id].first = __f._M_pos;
+	      break;
+	    case _S_fop_restore_sub_second:
+	      _M_cur_results[__f._M_id].second = __f._M_pos;
+	      _M_cur_results[__f._M_id].matched = __f._M_val;
+	      break;
+	    case _S_fop_restore_rep_count:
+	      _M_rep_count[__f._M_id] = make_pair(__f._M_pos, __f._M_val);
+	      break;
+	    case _S_fop_decrement_rep_count:
+	      --_M_rep_count[__f._M_id].second;
+	      break;
+	    }
+	}
+      _M_current = __current;
+    }
+
+  template<typename _BiIter, typename _Alloc, typename _TraitsT,
+	   bool __dfs_mode>
+    __attribute__((__always_inline__)) inline void
+    _Executor<_BiIter, _Alloc, _TraitsT, __dfs_mode>::
+    _M_node(_Match_mode __match_mode, _StateIdT __i)
     {
       if (_M_states._M_visited(__i))
 	return;
+      if (_M_steps_left == 0)
+	__throw_regex_error(regex_constants::error_complexity,
+			    "The number of regex matching steps exceeds the"
+			    " limit given.");
+      --_M_steps_left;
 
       switch (_M_nfa[__i]._M_opcode())
 	{
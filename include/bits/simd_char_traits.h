@@ -0,0 +1,259 @@
+// Vectorized character traits operations -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file bits/simd_char_traits.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{string}
+ */
+
+#ifndef _SIMD_CHAR_TRAITS_H
+#define _SIMD_CHAR_TRAITS_H 1
+
+#pragma GCC system_header
+
+// SSE2 is the baseline, AVX2 is selected at run time when the compiler
+// was not already told it may assume it.  The vector routines cannot run
+// in constant expressions, so they also need a way to detect those.
+#if (defined __x86_64__ || defined __i386__) && defined __SSE2__ \
+    && defined _GLIBCXX_HAVE_BUILTIN_IS_CONSTANT_EVALUATED       \
+    && !defined _GLIBCXX_NO_SIMD_CHAR_TRAITS
+#define _GLIBCXX_SIMD_CHAR_TRAITS 1
+
+namespace std _GLIBCXX_VISIBILITY(default) {
+
+  // The vector_size attribute cannot take a dependent size, so spell out
+  // the lane and word vectors for each supported block width.
+  template <size_t _Width, size_t _Size>
+  struct __simd_char_vec;
+
+#define _GLIBCXX_SIMD_CHAR_VEC(_Width, _Size, _LaneT)                           \
+  template <>                                                                  \
+  struct __simd_char_vec<_Width, _Size> {                                      \
+    typedef _LaneT _Lane;                                                      \
+    typedef _LaneT _Vec __attribute__((__vector_size__(_Width)));              \
+    typedef unsigned long long _Words __attribute__((__vector_size__(_Width))); \
+  };
+
+  _GLIBCXX_SIMD_CHAR_VEC(16, 2, unsigned short)
+  _GLIBCXX_SIMD_CHAR_VEC(16, 4, unsigned int)
+  _GLIBCXX_SIMD_CHAR_VEC(32, 2, unsigned short)
+  _GLIBCXX_SIMD_CHAR_VEC(32, 4, unsigned int)
+
+#undef _GLIBCXX_SIMD_CHAR_VEC
+
+  /**
+   *  Traits operations on @a _Width byte blocks of 16- or 32-bit
+   *  characters.  Written with the generic vector extension, so the same
+   *  code becomes SSE2 or AVX2 depending on the function it is inlined
+   *  into.  Lanes are unsigned, matching char_traits::lt for char16_t
+   *  and char32_t.
+   */
+  template <size_t _Width, typename _CharT>
+  struct __simd_char_block {
+    typedef typename __simd_char_vec<_Width, sizeof(_CharT)>::_Lane _Lane;
+    typedef typename __simd_char_vec<_Width, sizeof(_CharT)>::_Vec _Vec;
+    typedef typename __simd_char_vec<_Width, sizeof(_CharT)>::_Words _Words;
+
+    static constexpr size_t _S_lanes = _Width / sizeof(_CharT);
+    static constexpr size_t _S_words = _Width / sizeof(unsigned long long);
+
+    // Index of the first lane set in the comparison result __m, or
+    // _S_lanes if there is none.
+    template <typename _Mask>
+    static _GLIBCXX_ALWAYS_INLINE size_t
+    _S_first(const _Mask& __m) {
+      const _Words __w = (_Words)__m;
+      unsigned long long __any = __w[0];
+      for (size_t __i = 1; __i < _S_words; ++__i)
+        __any |= __w[__i];
+      if (__builtin_expect(__any == 0, 1))
+        return _S_lanes;
+      size_t __i = 0;
+      while (__w[__i] == 0)
+        ++__i;
+      return (__i * sizeof(unsigned long long) + __builtin_ctzll(__w[__i]) / __CHAR_BIT__) / sizeof(_CharT);
+    }
+
+    static _GLIBCXX_ALWAYS_INLINE void
+    _S_load(_Vec& __v, const _CharT* __p) { __builtin_memcpy(&__v, __p, _Width); }
+
+    static _GLIBCXX_ALWAYS_INLINE const _CharT*
+    _S_find(const _CharT* __s, size_t __n, _CharT __a) {
+      const _Vec __needle = _Vec{} + _Lane(__a);
+      _Vec __v;
+      if (__n >= _S_lanes) {
+        for (; __n >= _S_lanes; __s += _S_lanes, __n -= _S_lanes) {
+          _S_load(__v, __s);
+          const size_t __i = _S_first(__v == __needle);
+          if (__i != _S_lanes)
+            return __s + __i;
+        }
+        if (__n == 0)
+          return 0;
+        // Finish with a block overlapping the part already searched.
+        __s += __n - _S_lanes;
+        _S_load(__v, __s);
+        const size_t __i = _S_first(__v == __needle);
+        return __i != _S_lanes ? __s + __i : 0;
+      }
+      for (; __n; ++__s, --__n)
+        if (*__s == __a)
+          return __s;
+      return 0;
+    }
+
+    static _GLIBCXX_ALWAYS_INLINE int
+    _S_compare(const _CharT* __s1, const _CharT* __s2, size_t __n) {
+      _Vec __v1, __v2;
+      if (__n >= _S_lanes) {
+        size_t __off = 0;
+        for (;; __off += _S_lanes) {
+          if (__off + _S_lanes > __n)
+            __off = __n - _S_lanes;
+          _S_load(__v1, __s1 + __off);
+          _S_load(__v2, __s2 + __off);
+          const size_t __i = _S_first(__v1 != __v2);
+          if (__i != _S_lanes)
+            return _Lane(__s1[__off + __i]) < _Lane(__s2[__off + __i]) ? -1 : 1;
+          if (__off + _S_lanes == __n)
+            return 0;
+        }
+      }
+      for (size_t __i = 0; __i < __n; ++__i)
+        if (__s1[__i] != __s2[__i])
+          return _Lane(__s1[__i]) < _Lane(__s2[__i]) ? -1 : 1;
+      return 0;
+    }
+
+    // Reads whole aligned blocks, which may extend past the terminator
+    // but never into another page.  Callers must disable ASan.
+    static _GLIBCXX_ALWAYS_INLINE size_t
+    _S_length(const _CharT* __s) {
+      const _CharT* __p = __s;
+      while (reinterpret_cast<__UINTPTR_TYPE__>(__p) % _Width) {
+        if (*__p == _CharT())
+          return __p - __s;
+        ++__p;
+      }
+      const _Vec __zero = _Vec{};
+      _Vec __v;
+      for (;; __p += _S_lanes) {
+        _S_load(__v, static_cast<const _CharT*>(__builtin_assume_aligned(__p, _Width)));
+        const size_t __i = _S_first(__v == __zero);
+        if (__i != _S_lanes)
+          return __p - __s + __i;
+      }
+    }
+
+    static _GLIBCXX_ALWAYS_INLINE _CharT*
+    _S_assign(_CharT* __s, size_t __n, _CharT __a) {
+      const _Vec __fill = _Vec{} + _Lane(__a);
+      _CharT* __p = __s;
+      for (; __n >= _S_lanes; __p += _S_lanes, __n -= _S_lanes)
+        __builtin_memcpy(__p, &__fill, _Width);
+      for (; __n; ++__p, --__n)
+        *__p = __a;
+      return __s;
+    }
+  };
+
+  // Below this many bytes the CPU feature test costs more than AVX2 saves.
+  constexpr size_t __simd_char_avx2_threshold = 64;
+
+#ifndef __AVX2__
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+  template <typename _CharT>
+  const _CharT*
+  __simd_char_find_avx2(const _CharT* __s, size_t __n, _CharT __a) { return __simd_char_block<32, _CharT>::_S_find(__s, __n, __a); }
+
+  template <typename _CharT>
+  int
+  __simd_char_compare_avx2(const _CharT* __s1, const _CharT* __s2, size_t __n) { return __simd_char_block<32, _CharT>::_S_compare(__s1, __s2, __n); }
+
+  template <typename _CharT>
+  __attribute__((__no_sanitize_address__)) size_t
+  __simd_char_length_avx2(const _CharT* __s) { return __simd_char_block<32, _CharT>::_S_length(__s); }
+
+  template <typename _CharT>
+  _CharT*
+  __simd_char_assign_avx2(_CharT* __s, size_t __n, _CharT __a) { return __simd_char_block<32, _CharT>::_S_assign(__s, __n, __a); }
+
+#pragma GCC pop_options
+
+  template <typename _CharT>
+  inline const _CharT*
+  __simd_char_find(const _CharT* __s, size_t __n, _CharT __a) {
+    if (__n * sizeof(_CharT) >= __simd_char_avx2_threshold && __builtin_cpu_supports("avx2"))
+      return std::__simd_char_find_avx2(__s, __n, __a);
+    return __simd_char_block<16, _CharT>::_S_find(__s, __n, __a);
+  }
+
+  template <typename _CharT>
+  inline int
+  __simd_char_compare(const _CharT* __s1, const _CharT* __s2, size_t __n) {
+    if (__n * sizeof(_CharT) >= __simd_char_avx2_threshold && __builtin_cpu_supports("avx2"))
+      return std::__simd_char_compare_avx2(__s1, __s2, __n);
+    return __simd_char_block<16, _CharT>::_S_compare(__s1, __s2, __n);
+  }
+
+  template <typename _CharT>
+  __attribute__((__no_sanitize_address__)) inline size_t
+  __simd_char_length(const _CharT* __s) {
+    if (__builtin_cpu_supports("avx2"))
+      return std::__simd_char_length_avx2(__s);
+    return __simd_char_block<16, _CharT>::_S_length(__s);
+  }
+
+  template <typename _CharT>
+  inline _CharT*
+  __simd_char_assign(_CharT* __s, size_t __n, _CharT __a) {
+    if (__n * sizeof(_CharT) >= __simd_char_avx2_threshold && __builtin_cpu_supports("avx2"))
+      return std::__simd_char_assign_avx2(__s, __n, __a);
+    return __simd_char_block<16, _CharT>::_S_assign(__s, __n, __a);
+  }
+#else
+  template <typename _CharT>
+  inline const _CharT*
+  __simd_char_find(const _CharT* __s, size_t __n, _CharT __a) { return __simd_char_block<32, _CharT>::_S_find(__s, __n, __a); }
+
+  template <typename _CharT>
+  inline int
+  __simd_char_compare(const _CharT* __s1, const _CharT* __s2, size_t __n) { return __simd_char_block<32, _CharT>::_S_compare(__s1, __s2, __n); }
+
+  template <typename _CharT>
+  __attribute__((__no_sanitize_address__)) inline size_t
+  __simd_char_length(const _CharT* __s) { return __simd_char_block<32, _CharT>::_S_length(__s); }
+
+  template <typename _CharT>
+  inline _CharT*
+  __simd_char_assign(_CharT* __s, size_t __n, _CharT __a) { return __simd_char_block<32, _CharT>::_S_assign(__s, __n, __a); }
+#endif // __AVX2__
+
+} // namespace )
+
+#endif // _GLIBCXX_SIMD_CHAR_TRAITS
+
+#endif // _SIMD_CHAR_TRAITS_H
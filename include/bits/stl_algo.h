@@ -57,6 +57,7 @@
 #define _STL_ALGO_H 1
 
 #include <bits/algorithmfwd.h>
+#include <bits/byte_search.h>
 #include <bits/predefined_ops.h>
 #include <bits/stl_heap.h>
 #include <bits/stl_tempbuf.h> // for _Temporary_buffer
@@ -231,6 +232,44 @@ namespace std _GLIBCXX_VISIBILITY(default) {
     return __first1;
   }
 
+  template <bool _IsBytes>
+  struct __search_bytes {
+    template <typename _ForwardIterator1, typename _ForwardIterator2>
+    static _ForwardIterator1
+    __search(_ForwardIterator1 __first1, _ForwardIterator1 __last1,
+             _ForwardIterator2 __first2, _ForwardIterator2 __last2) {
+      return std::__search(__first1, __last1, __first2, __last2,
+                           __gnu_cxx::__ops::__iter_equal_to_iter());
+    }
+  };
+
+  // Contiguous ranges of the same byte type compare with memcmp semantics,
+  // so they can use the prefilter and Two-Way matchers.
+  template <>
+  struct __search_bytes<true> {
+    template <typename _Tp1, typename _Tp2>
+    static _Tp1*
+    __search(_Tp1* __first1, _Tp1* __last1, _Tp2* __first2, _Tp2* __last2) {
+      const unsigned char* __h = reinterpret_cast<const unsigned char*>(__first1);
+      const unsigned char* __r =
+          std::__byte_search(__h, __last1 - __first1,
+                             reinterpret_cast<const unsigned char*>(__first2),
+                             __last2 - __first2);
+      return __r ? __first1 + (__r - __h) : __last1;
+    }
+  };
+
+  template <typename _ForwardIterator1, typename _ForwardIterator2>
+  inline _ForwardIterator1
+  __search_aux(_ForwardIterator1 __first1, _ForwardIterator1 __last1,
+               _ForwardIterator2 __first2, _ForwardIterator2 __last2) {
+    typedef typename iterator_traits<_ForwardIterator1>::value_type _ValueType1;
+    typedef typename iterator_traits<_ForwardIterator2>::value_type _ValueType2;
+    const bool __bytes = (__is_byte<_ValueType1>::__value && __is_pointer<_ForwardIterator1>::__value && __is_pointer<_ForwardIterator2>::__value && __are_same<_ValueType1, _ValueType2>::__value);
+
+    return std::__search_bytes<__bytes>::__search(__first1, __last1, __first2, __last2);
+  }
+
   // search_n
 
   /**
@@ -3853,8 +3892,11 @@ namespace std _GLIBCXX_VISIBILITY(default) {
                 __glibcxx_requires_valid_range(__first1, __last1);
     __glibcxx_requires_valid_range(__first2, __last2);
 
-    return std::__search(__first1, __last1, __first2, __last2,
-                         __gnu_cxx::__ops::__iter_equal_to_iter());
+    return std::__niter_wrap(__first1,
+                             std::__search_aux(std::__niter_base(__first1),
+                                               std::__niter_base(__last1),
+                                               std::__niter_base(__first2),
+                                               std::__niter_base(__last2)));
   }
 
   /**
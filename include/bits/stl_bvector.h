@@ -369,6 +369,286 @@ namespace std _GLIBCXX_VISIBILITY(default) {
       __fill_bvector(__first._M_p, __first._M_offset, __last._M_offset, __x);
   }
 
+  // Word-at-a-time helpers for the algorithm overloads below.  A range of
+  // bits is processed in chunks of at most _S_word_bit bits, so the cost is
+  // one or two word operations per _S_word_bit elements instead of one
+  // _Bit_reference per element.
+
+  // Returns the __n bits (0 < __n <= _S_word_bit) starting at bit __off of
+  // *__p in the low bits of the result.  Reads __p[1] only when the bits
+  // actually extend into it.
+  inline _Bit_type
+  __load_bvector(const _Bit_type* __p, unsigned int __off, unsigned int __n) {
+    _Bit_type __w = *__p >> __off;
+    if (__off + __n > unsigned(_S_word_bit))
+      __w |= __p[1] << (_S_word_bit - __off);
+    if (__n < unsigned(_S_word_bit))
+      __w &= ~0ul >> (_S_word_bit - __n);
+    return __w;
+  }
+
+  // Stores the low __n bits of __w (0 < __n <= _S_word_bit) at bit __off of
+  // *__p, leaving all other bits untouched.
+  inline void
+  __store_bvector(_Bit_type* __p, unsigned int __off, unsigned int __n,
+                  _Bit_type __w) {
+    const unsigned int __lo = __n < _S_word_bit - __off ? __n : _S_word_bit - __off;
+    const _Bit_type __lmask = (~0ul >> (_S_word_bit - __lo)) << __off;
+    *__p = (*__p & ~__lmask) | ((__w << __off) & __lmask);
+    if (__n > __lo) {
+      const _Bit_type __hmask = ~0ul >> (_S_word_bit - (__n - __lo));
+      __p[1] = (__p[1] & ~__hmask) | ((__w >> __lo) & __hmask);
+    }
+  }
+
+  // Forward copy; like std::copy, __result may precede __first even if the
+  // ranges overlap, since every chunk is read before anything after it is
+  // written.
+  inline _Bit_iterator
+  __copy_bvector(_Bit_const_iterator __first, _Bit_const_iterator __last,
+                 _Bit_iterator __result) {
+    ptrdiff_t __n = __last - __first;
+    const _Bit_type* __p = __first._M_p;
+    unsigned int __s = __first._M_offset;
+    _Bit_type* __q = __result._M_p;
+    unsigned int __d = __result._M_offset;
+
+    // Bring the destination to a word boundary, then copy whole words,
+    // shifting them when the source is not aligned the same way.
+    if (__n > 0 && __d != 0) {
+      const unsigned int __k = __n < ptrdiff_t(_S_word_bit - __d) ? unsigned(__n) : _S_word_bit - __d;
+      __store_bvector(__q, __d, __k, __load_bvector(__p, __s, __k));
+      __n -= __k;
+      __s += __k;
+      __p += __s / unsigned(_S_word_bit);
+      __s %= unsigned(_S_word_bit);
+      __d = (__d + __k) % unsigned(_S_word_bit);
+      if (__d == 0)
+        ++__q;
+    }
+
+    const ptrdiff_t __nwords = __n / int(_S_word_bit);
+    if (__s == 0) {
+      if (__nwords)
+        __builtin_memmove(__q, __p, __nwords * sizeof(_Bit_type));
+    } else
+      for (ptrdiff_t __i = 0; __i < __nwords; ++__i)
+        __q[__i] = (__p[__i] >> __s) | (__p[__i + 1] << (_S_word_bit - __s));
+    __p += __nwords;
+    __q += __nwords;
+    __n -= __nwords * int(_S_word_bit);
+
+    if (__n > 0) {
+      __store_bvector(__q, __d, unsigned(__n), __load_bvector(__p, __s, unsigned(__n)));
+      __d += unsigned(__n);
+    }
+    return _Bit_iterator(__q, __d);
+  }
+
+  // Backward copy; __result may follow __first even if the ranges overlap.
+  inline _Bit_iterator
+  __copy_backward_bvector(_Bit_const_iterator __first,
+                          _Bit_const_iterator __last, _Bit_iterator __result) {
+    ptrdiff_t __n = __last - __first;
+    const _Bit_type* __p = __last._M_p;
+    unsigned int __s = __last._M_offset;
+    _Bit_type* __q = __result._M_p;
+    unsigned int __d = __result._M_offset;
+
+    while (__n > 0) {
+      // After the first chunk the destination end is word aligned.
+      const unsigned int __room = __d ? __d : unsigned(_S_word_bit);
+      const unsigned int __k = __n < ptrdiff_t(__room) ? unsigned(__n) : __room;
+      if (__s >= __k)
+        __s -= __k;
+      else {
+        --__p;
+        __s += _S_word_bit - __k;
+      }
+      if (__d >= __k)
+        __d -= __k;
+      else {
+        --__q;
+        __d += _S_word_bit - __k;
+      }
+      __store_bvector(__q, __d, __k, __load_bvector(__p, __s, __k));
+      __n -= __k;
+    }
+    return _Bit_iterator(__q, __d);
+  }
+
+  // Number of set bits in [__first, __last).
+  inline ptrdiff_t
+  __count_bvector(_Bit_const_iterator __first, _Bit_const_iterator __last) {
+    const _Bit_type* __p = __first._M_p;
+    if (__p == __last._M_p) {
+      if (__first._M_offset >= __last._M_offset)
+        return 0;
+      const _Bit_type __mask = (~0ul << __first._M_offset) & (~0ul >> (_S_word_bit - __last._M_offset));
+      return __builtin_popcountl(*__p & __mask);
+    }
+
+    ptrdiff_t __n = __builtin_popcountl(*__p & (~0ul << __first._M_offset));
+    for (++__p; __p != __last._M_p; ++__p)
+      __n += __builtin_popcountl(*__p);
+    if (__last._M_offset)
+      __n += __builtin_popcountl(*__p & (~0ul >> (_S_word_bit - __last._M_offset)));
+    return __n;
+  }
+
+  // First position in [__first, __last) whose bit equals __x, or __last.
+  inline _Bit_const_iterator
+  __find_bvector(_Bit_const_iterator __first, _Bit_const_iterator __last,
+                 bool __x) {
+    if (!(__first < __last))
+      return __last;
+
+    // Flip the words when looking for a zero so the search is always for
+    // the lowest set bit.
+    const _Bit_type __flip = __x ? 0ul : ~0ul;
+    _Bit_type* __p = __first._M_p;
+    _Bit_type __w = (*__p ^ __flip) & (~0ul << __first._M_offset);
+    while (__w == 0) {
+      if (++__p > __last._M_p || (__p == __last._M_p && __last._M_offset == 0))
+        return __last;
+      __w = *__p ^ __flip;
+    }
+
+    const _Bit_const_iterator __pos(__p, unsigned(__builtin_ctzl(__w)));
+    return __pos < __last ? __pos : __last;
+  }
+
+  inline bool
+  __equal_bvector(_Bit_const_iterator __first1, _Bit_const_iterator __last1,
+                  _Bit_const_iterator __first2) {
+    ptrdiff_t __n = __last1 - __first1;
+    const _Bit_type* __p = __first1._M_p;
+    unsigned int __s = __first1._M_offset;
+    const _Bit_type* __q = __first2._M_p;
+    unsigned int __d = __first2._M_offset;
+
+    if (__s == __d) {
+      // Same alignment: after the leading partial word compare whole words.
+      if (__n > 0 && __s != 0) {
+        const unsigned int __k = __n < ptrdiff_t(_S_word_bit - __s) ? unsigned(__n) : _S_word_bit - __s;
+        if (__load_bvector(__p++, __s, __k) != __load_bvector(__q++, __s, __k))
+          return false;
+        __n -= __k;
+      }
+      const ptrdiff_t __nwords = __n / int(_S_word_bit);
+      if (__nwords && __builtin_memcmp(__p, __q, __nwords * sizeof(_Bit_type)))
+        return false;
+      __n -= __nwords * int(_S_word_bit);
+      return __n == 0 || __load_bvector(__p + __nwords, 0, unsigned(__n)) == __load_bvector(__q + __nwords, 0, unsigned(__n));
+    }
+
+    while (__n > 0) {
+      const unsigned int __k = __n < ptrdiff_t(_S_word_bit - __s) ? unsigned(__n) : _S_word_bit - __s;
+      if (__load_bvector(__p, __s, __k) != __load_bvector(__q, __d, __k))
+        return false;
+      __n -= __k;
+      ++__p;
+      __s = 0;
+      __d += __k;
+      __q += __d / unsigned(_S_word_bit);
+      __d %= unsigned(_S_word_bit);
+    }
+    return true;
+  }
+
+  inline _Bit_iterator
+  copy(_Bit_const_iterator __first, _Bit_const_iterator __last,
+       _Bit_iterator __result) { return __copy_bvector(__first, __last, __result); }
+
+  inline _Bit_iterator
+  copy(_Bit_iterator __first, _Bit_iterator __last, _Bit_iterator __result) {
+    return __copy_bvector(__first, __last, __result);
+  }
+
+  inline _Bit_iterator
+  copy_backward(_Bit_const_iterator __first, _Bit_const_iterator __last,
+                _Bit_iterator __result) { return __copy_backward_bvector(__first, __last, __result); }
+
+  inline _Bit_iterator
+  copy_backward(_Bit_iterator __first, _Bit_iterator __last,
+                _Bit_iterator __result) { return __copy_backward_bvector(__first, __last, __result); }
+
+  inline ptrdiff_t
+  count(_Bit_const_iterator __first, _Bit_const_iterator __last,
+        const bool& __x) {
+    const ptrdiff_t __n = __count_bvector(__first, __last);
+    return __x ? __n : (__last - __first) - __n;
+  }
+
+  inline ptrdiff_t
+  count(_Bit_iterator __first, _Bit_iterator __last, const bool& __x) {
+    const ptrdiff_t __n = __count_bvector(__first, __last);
+    return __x ? __n : (__last - __first) - __n;
+  }
+
+  inline _Bit_const_iterator
+  find(_Bit_const_iterator __first, _Bit_const_iterator __last,
+       const bool& __x) { return __find_bvector(__first, __last, __x); }
+
+  inline _Bit_iterator
+  find(_Bit_iterator __first, _Bit_iterator __last, const bool& __x) {
+    return __find_bvector(__first, __last, __x)._M_const_cast();
+  }
+
+  inline bool
+  equal(_Bit_const_iterator __first1, _Bit_const_iterator __last1,
+        _Bit_const_iterator __first2) { return __equal_bvector(__first1, __last1, __first2); }
+
+  inline bool
+  equal(_Bit_iterator __first1, _Bit_iterator __last1,
+        _Bit_iterator __first2) { return __equal_bvector(__first1, __last1, __first2); }
+
+  inline bool
+  equal(_Bit_const_iterator __first1, _Bit_const_iterator __last1,
+        _Bit_iterator __first2) { return __equal_bvector(__first1, __last1, __first2); }
+
+  inline bool
+  equal(_Bit_iterator __first1, _Bit_iterator __last1,
+        _Bit_const_iterator __first2) { return __equal_bvector(__first1, __last1, __first2); }
+
+  // A bit matches the second range if that range holds any element equal
+  // to its value, so the answer only depends on which of true and false
+  // occur there.
+  template <typename _ForwardIterator>
+  _Bit_const_iterator
+  __find_first_of_bvector(_Bit_const_iterator __first1,
+                          _Bit_const_iterator __last1,
+                          _ForwardIterator __first2, _ForwardIterator __last2) {
+    bool __has_true = false, __has_false = false;
+    for (; __first2 != __last2 && !(__has_true && __has_false); ++__first2) {
+      if (true == *__first2)
+        __has_true = true;
+      if (false == *__first2)
+        __has_false = true;
+    }
+
+    if (__has_true && __has_false)
+      return __first1 < __last1 ? __first1 : __last1;
+    if (__has_true || __has_false)
+      return __find_bvector(__first1, __last1, __has_true);
+    return __last1;
+  }
+
+  template <typename _ForwardIterator>
+  inline _Bit_const_iterator
+  find_first_of(_Bit_const_iterator __first1, _Bit_const_iterator __last1,
+                _ForwardIterator __first2, _ForwardIterator __last2) {
+    return __find_first_of_bvector(__first1, __last1, __first2, __last2);
+  }
+
+  template <typename _ForwardIterator>
+  inline _Bit_iterator
+  find_first_of(_Bit_iterator __first1, _Bit_iterator __last1,
+                _ForwardIterator __first2, _ForwardIterator __last2) {
+    return __find_first_of_bvector(__first1, __last1, __first2, __last2)
+        ._M_const_cast();
+  }
+
   template <typename _Alloc>
   struct _Bvector_base {
     typedef typename __gnu_cxx::__alloc_traits<_Alloc>::template rebind<_Bit_type>::other _Bit_alloc_type;
@@ -938,6 +1218,23 @@ namespace std _GLIBCXX_VISIBILITY(default) {
         *__p = ~*__p;
     }
 
+    /// Index of the first set bit at or after __pos, or size() if there
+    /// is none.
+    size_type
+    find_next_set(size_type __pos) const noexcept {
+      if (__pos >= size())
+        return size();
+      return size_type(__find_bvector(begin() + difference_type(__pos), end(), true) - begin());
+    }
+
+    /// Number of set bits in [__first, __last), where
+    /// __first <= __last <= size().
+    size_type
+    count_range(size_type __first, size_type __last) const noexcept {
+      return size_type(__count_bvector(begin() + difference_type(__first),
+                                       begin() + difference_type(__last)));
+    }
+
     void
     clear() noexcept { _M_erase_at_end(begin()); }
 
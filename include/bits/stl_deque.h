@@ -428,6 +428,36 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 				const _Tp&, const _Tp*>(__last),
 				__result); }
 
+  // Overloads that walk [__first, __last) one node at a time, so the work
+  // on each node is a plain loop over contiguous elements.
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _OI>
+    _OI
+    copy(_Deque_iterator<_Tp, _Ref, _Ptr>,
+	 _Deque_iterator<_Tp, _Ref, _Ptr>, _OI);
+
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _Up>
+    _Deque_iterator<_Tp, _Ref, _Ptr>
+    find(_Deque_iterator<_Tp, _Ref, _Ptr>,
+	 _Deque_iterator<_Tp, _Ref, _Ptr>, const _Up&);
+
+  template<typename _Tp, typename _Ref, typename _Ptr,
+	   typename _Function>
+    _Function
+    for_each(_Deque_iterator<_Tp, _Ref, _Ptr>,
+	     _Deque_iterator<_Tp, _Ref, _Ptr>, _Function);
+
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _II>
+    bool
+    equal(_Deque_iterator<_Tp, _Ref, _Ptr>,
+	  _Deque_iterator<_Tp, _Ref, _Ptr>, _II);
+
+  template<typename _Tp, typename _Ref1, typename _Ptr1,
+	   typename _Ref2, typename _Ptr2>
+    bool
+    equal(_Deque_iterator<_Tp, _Ref1, _Ptr1>,
+	  _Deque_iterator<_Tp, _Ref1, _Ptr1>,
+	  _Deque_iterator<_Tp, _Ref2, _Ptr2>);
+
 #if __cplusplus >= 201103L
   template<typename _Tp>
     _Deque_iterator<_Tp, _Tp&, _Tp*>
@@ -460,6 +490,11 @@ _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 				_Deque_iterator<_Tp,
 				const _Tp&, const _Tp*>(__last),
 				__result); }
+
+  template<typename _Tp, typename _Ref, typename _Ptr, typename _OI>
+    _OI
+    move(_Deque_iterator<_Tp, _Ref, _Ptr>,
+	 _Deque_iterator<_Tp, _Ref, _Ptr>, _OI);
 #endif
 
   /**
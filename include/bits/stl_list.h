@@ -60,6 +60,7 @@
 #include <ext/alloc_traits.h>
 #if __cplusplus >= 201103L
 #include <bits/allocated_ptr.h>
+#include <bits/node_sort.h>
 #include <ext/aligned_buffer.h>
 #include <initializer_list>
 #endif
@@ -1752,6 +1753,13 @@ namespace std _GLIBCXX_VISIBILITY(default) {
     void
     _M_transfer(iterator __position, iterator __first, iterator __last) { __position._M_node->_M_transfer(__first._M_node, __last._M_node); }
 
+    // Sorts the nodes through a buffer of pointers to them, see
+    // _Node_sort_buffer.  Returns false, having done nothing, if no
+    // buffer could be allocated.
+    template <typename _Compare>
+    bool
+    _M_sort_nodes(_Compare __comp);
+
     // Inserts new element at position given and with value given.
 #if __cplusplus < 201103L
     void
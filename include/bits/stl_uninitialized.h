@@ -642,6 +642,22 @@ namespace std _GLIBCXX_VISIBILITY(default) {
         __uninit_default_novalue_n(first, __n);
   }
 
+  // __uninitialized_default_novalue_n_a
+  // Fills [first, first + n) with n default-initialized value_types(s),
+  // constructed with the allocator alloc.  Only std::allocator is known
+  // not to customize construct(), so any other allocator value-initializes.
+  template <typename _ForwardIterator, typename _Size, typename _Allocator>
+  inline _ForwardIterator
+  __uninitialized_default_novalue_n_a(_ForwardIterator first, _Size __n,
+                                      _Allocator& __alloc) {
+    return std::__uninitialized_default_n_a(first, __n, __alloc);
+  }
+
+  template <typename _ForwardIterator, typename _Size, typename _Tp>
+  inline _ForwardIterator
+  __uninitialized_default_novalue_n_a(_ForwardIterator first, _Size __n,
+                                      allocator<_Tp>&) { return std::__uninitialized_default_novalue_n(first, __n); }
+
   template <typename _InputIterator, typename _Size,
             typename _ForwardIterator>
   _ForwardIterator
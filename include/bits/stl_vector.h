@@ -731,6 +731,24 @@ namespace std _GLIBCXX_VISIBILITY(default) {
         _M_erase_at_end(this->_M_impl._M_start + __new_size);
     }
 
+    /**
+       *  @brief  Resizes the %vector without value-initializing new elements.
+       *  @param  __new_size  Number of elements the %vector should contain.
+       *
+       *  Like resize(__new_size), except that appended elements are
+       *  default-initialized rather than value-initialized.  For trivial
+       *  types and std::allocator this leaves their values indeterminate
+       *  and avoids zeroing memory the caller is about to overwrite.
+       *  This is a GNU extension.
+       */
+    void
+    resize_default_init(size_type __new_size) {
+      if (__new_size > size())
+        _M_default_append<false>(__new_size - size());
+      else if (__new_size < size())
+        _M_erase_at_end(this->_M_impl._M_start + __new_size);
+    }
+
     /**
        *  @brief  Resizes the %vector to the specified number of elements.
        *  @param  __new_size  Number of elements the %vector should contain.
@@ -1427,10 +1445,21 @@ namespace std _GLIBCXX_VISIBILITY(default) {
     _M_fill_insert(iterator __pos, size_type __n, const value_type& __x);
 
 #if __cplusplus >= 201103L
-    // Called by resize(n).
+    // Called by resize(n), and by resize_default_init(n) with
+    // _ValueInit false.
+    template <bool _ValueInit = true>
     void
     _M_default_append(size_type __n);
 
+    template <bool _ValueInit>
+    static pointer
+    _S_default_construct_n(pointer __p, size_type __n, _Tp_alloc_type& __a) {
+      if constexpr (_ValueInit)
+        return std::__uninitialized_default_n_a(__p, __n, __a);
+      else
+        return std::__uninitialized_default_novalue_n_a(__p, __n, __a);
+    }
+
     bool
     _M_shrink_to_fit();
 #endif
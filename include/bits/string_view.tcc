@@ -123,6 +123,12 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		  size_type __n) const noexcept
     {
       __glibcxx_requires_string_len(__str, __n);
+#ifdef _GLIBCXX_HAVE_BUILTIN_IS_CONSTANT_EVALUATED
+      if (!__builtin_is_constant_evaluated()
+	  && __char_set_search<_Traits>::_S_usable(this->_M_len))
+	return __char_set_search<_Traits>::
+	  _S_find_first(this->_M_str, this->_M_len, __pos, __str, __n, true);
+#endif
       for (; __n && __pos < this->_M_len; ++__pos)
 	{
 	  const _CharT* __p = traits_type::find(__str, __n,
@@ -140,6 +146,12 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		 size_type __n) const noexcept
     {
       __glibcxx_requires_string_len(__str, __n);
+#ifdef _GLIBCXX_HAVE_BUILTIN_IS_CONSTANT_EVALUATED
+      if (!__builtin_is_constant_evaluated()
+	  && __char_set_search<_Traits>::_S_usable(this->_M_len))
+	return __char_set_search<_Traits>::
+	  _S_find_last(this->_M_str, this->_M_len, __pos, __str, __n, true);
+#endif
       size_type __size = this->size();
       if (__size && __n)
 	{
@@ -162,6 +174,12 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		      size_type __n) const noexcept
     {
       __glibcxx_requires_string_len(__str, __n);
+#ifdef _GLIBCXX_HAVE_BUILTIN_IS_CONSTANT_EVALUATED
+      if (!__builtin_is_constant_evaluated()
+	  && __char_set_search<_Traits>::_S_usable(this->_M_len))
+	return __char_set_search<_Traits>::
+	  _S_find_first(this->_M_str, this->_M_len, __pos, __str, __n, false);
+#endif
       for (; __pos < this->_M_len; ++__pos)
 	if (!traits_type::find(__str, __n, this->_M_str[__pos]))
 	  return __pos;
@@ -186,6 +204,12 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		     size_type __n) const noexcept
     {
       __glibcxx_requires_string_len(__str, __n);
+#ifdef _GLIBCXX_HAVE_BUILTIN_IS_CONSTANT_EVALUATED
+      if (!__builtin_is_constant_evaluated()
+	  && __char_set_search<_Traits>::_S_usable(this->_M_len))
+	return __char_set_search<_Traits>::
+	  _S_find_last(this->_M_str, this->_M_len, __pos, __str, __n, false);
+#endif
       size_type __size = this->_M_len;
       if (__size)
 	{
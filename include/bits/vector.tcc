@@ -461,6 +461,7 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
 #if __cplusplus >= 201103L
   template <typename _Tp, typename _Alloc>
+  template <bool _ValueInit>
   void
   vector<_Tp, _Alloc>::
       _M_default_append(size_type __n) {
@@ -473,16 +474,16 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
       if (__navail >= __n) {
         this->_M_impl._M_finish =
-            std::__uninitialized_default_n_a(this->_M_impl._M_finish,
-                                             __n, _M_get_Tp_allocator());
+            _S_default_construct_n<_ValueInit>(this->_M_impl._M_finish,
+                                               __n, _M_get_Tp_allocator());
       } else {
         const size_type __len =
             _M_check_len(__n, "vector::_M_default_append");
         pointer __new_start(this->_M_allocate(__len));
         if constexpr (_S_use_relocate()) {
           try {
-            std::__uninitialized_default_n_a(__new_start + __size,
-                                             __n, _M_get_Tp_allocator());
+            _S_default_construct_n<_ValueInit>(__new_start + __size,
+                                               __n, _M_get_Tp_allocator());
           }
           catch(...) {
             _M_deallocate(__new_start, __len);
@@ -493,8 +494,8 @@ namespace std _GLIBCXX_VISIBILITY(default) {
         } else {
           pointer __destroy_from = pointer();
           try {
-            std::__uninitialized_default_n_a(__new_start + __size,
-                                             __n, _M_get_Tp_allocator());
+            _S_default_construct_n<_ValueInit>(__new_start + __size,
+                                               __n, _M_get_Tp_allocator());
             __destroy_from = __new_start + __size;
             std::__uninitialized_move_if_noexcept_a(
                 this->_M_impl._M_start, this->_M_impl._M_finish,
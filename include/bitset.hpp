@@ -64,6 +64,208 @@
 namespace std _GLIBCXX_VISIBILITY(default) {
   _GLIBCXX_BEGIN_NAMESPACE_CONTAINER
 
+  /**
+   *  Bulk word kernels used by _Base_bitset once a bitset spans at least
+   *  _S_min_words words.
+   *
+   *  The loops operate on blocks of _S_lanes words held in a GCC vector
+   *  type, so one block is a single 256-bit operation when AVX2 is
+   *  enabled and two 128-bit ones with SSE2.  On targets without SIMD
+   *  the compiler lowers the same code to per-word operations, which is
+   *  the explicit fallback.  Population counts use the popcnt
+   *  instruction when the target has it and a vectorized SWAR count
+   *  otherwise.
+  */
+  struct _Bitset_kernels {
+    typedef unsigned long _WordT;
+    typedef _WordT _VecT __attribute__((__vector_size__(32)));
+
+    enum { _S_lanes = sizeof(_VecT) / sizeof(_WordT) };
+    enum { _S_min_words = 4 * _S_lanes };
+
+    // Bitset storage is only word aligned, so go through memcpy.
+    static void
+    _S_load(_VecT& __v, const _WordT* __p) noexcept { __builtin_memcpy(&__v, __p, sizeof(_VecT)); }
+
+    static void
+    _S_store(_WordT* __p, const _VecT& __v) noexcept { __builtin_memcpy(__p, &__v, sizeof(_VecT)); }
+
+    static bool
+    _S_nonzero(const _VecT& __v) noexcept {
+      _WordT __w[_S_lanes];
+      __builtin_memcpy(__w, &__v, sizeof(_VecT));
+      _WordT __r = 0;
+      for (size_t __i = 0; __i < _S_lanes; ++__i)
+        __r |= __w[__i];
+      return __r != 0;
+    }
+
+    static void
+    _S_and(_WordT* __x, const _WordT* __y, size_t __n) noexcept {
+      size_t __i = 0;
+      for (_VecT __a, __b; __i + _S_lanes <= __n; __i += _S_lanes) {
+        _S_load(__a, __x + __i);
+        _S_load(__b, __y + __i);
+        _S_store(__x + __i, __a & __b);
+      }
+      for (; __i < __n; ++__i)
+        __x[__i] &= __y[__i];
+    }
+
+    static void
+    _S_or(_WordT* __x, const _WordT* __y, size_t __n) noexcept {
+      size_t __i = 0;
+      for (_VecT __a, __b; __i + _S_lanes <= __n; __i += _S_lanes) {
+        _S_load(__a, __x + __i);
+        _S_load(__b, __y + __i);
+        _S_store(__x + __i, __a | __b);
+      }
+      for (; __i < __n; ++__i)
+        __x[__i] |= __y[__i];
+    }
+
+    static void
+    _S_xor(_WordT* __x, const _WordT* __y, size_t __n) noexcept {
+      size_t __i = 0;
+      for (_VecT __a, __b; __i + _S_lanes <= __n; __i += _S_lanes) {
+        _S_load(__a, __x + __i);
+        _S_load(__b, __y + __i);
+        _S_store(__x + __i, __a ^ __b);
+      }
+      for (; __i < __n; ++__i)
+        __x[__i] ^= __y[__i];
+    }
+
+    static void
+    _S_flip(_WordT* __x, size_t __n) noexcept {
+      size_t __i = 0;
+      for (_VecT __a; __i + _S_lanes <= __n; __i += _S_lanes) {
+        _S_load(__a, __x + __i);
+        _S_store(__x + __i, ~__a);
+      }
+      for (; __i < __n; ++__i)
+        __x[__i] = ~__x[__i];
+    }
+
+    static bool
+    _S_is_equal(const _WordT* __x, const _WordT* __y, size_t __n) noexcept {
+      size_t __i = 0;
+      for (_VecT __a, __b; __i + _S_lanes <= __n; __i += _S_lanes) {
+        _S_load(__a, __x + __i);
+        _S_load(__b, __y + __i);
+        if (_S_nonzero(__a ^ __b))
+          return false;
+      }
+      for (; __i < __n; ++__i)
+        if (__x[__i] != __y[__i])
+          return false;
+      return true;
+    }
+
+    // Index of the first non-zero word at or after __i, or __n.
+    static size_t
+    _S_find_nonzero(const _WordT* __x, size_t __i, size_t __n) noexcept {
+      for (; __i < __n && __i % _S_lanes; ++__i)
+        if (__x[__i])
+          return __i;
+      for (_VecT __a; __i + _S_lanes <= __n; __i += _S_lanes) {
+        _S_load(__a, __x + __i);
+        if (_S_nonzero(__a))
+          break;
+      }
+      for (; __i < __n; ++__i)
+        if (__x[__i])
+          return __i;
+      return __n;
+    }
+
+    // Number of set bits in __x[0, __n), or in __x & __y when _And.
+    template <bool _And>
+    static size_t
+    _S_count(const _WordT* __x, const _WordT* __y, size_t __n) noexcept {
+      size_t __i = 0;
+#ifdef __POPCNT__
+      // Four independent sums keep several popcnt in flight.
+      size_t __c0 = 0, __c1 = 0, __c2 = 0, __c3 = 0;
+      for (; __i + 4 <= __n; __i += 4) {
+        __c0 += __builtin_popcountl(_And ? __x[__i] & __y[__i] : __x[__i]);
+        __c1 += __builtin_popcountl(_And ? __x[__i + 1] & __y[__i + 1] : __x[__i + 1]);
+        __c2 += __builtin_popcountl(_And ? __x[__i + 2] & __y[__i + 2] : __x[__i + 2]);
+        __c3 += __builtin_popcountl(_And ? __x[__i + 3] & __y[__i + 3] : __x[__i + 3]);
+      }
+      size_t __result = __c0 + __c1 + __c2 + __c3;
+#else
+      // SWAR count: per-byte counts (at most 8) are summed in __acc and
+      // folded into __result before any byte can reach 256.
+      const _WordT __m1 = ~_WordT(0) / 3;
+      const _WordT __m2 = ~_WordT(0) / 5;
+      const _WordT __m4 = ~_WordT(0) / 17;
+      const _WordT __m8 = ~_WordT(0) / 257;
+      size_t __result = 0;
+      while (__i + _S_lanes <= __n) {
+        _VecT __acc = _VecT();
+        for (int __k = 0; __k < 31 && __i + _S_lanes <= __n; ++__k, __i += _S_lanes) {
+          _VecT __v;
+          _S_load(__v, __x + __i);
+          if (_And) {
+            _VecT __b;
+            _S_load(__b, __y + __i);
+            __v &= __b;
+          }
+          __v -= (__v >> 1) & __m1;
+          __v = (__v & __m2) + ((__v >> 2) & __m2);
+          __acc += (__v + (__v >> 4)) & __m4;
+        }
+        // Bytes to 16-bit lanes, then sum those with a multiply.
+        __acc = (__acc & __m8) + ((__acc >> 8) & __m8);
+        _WordT __w[_S_lanes];
+        __builtin_memcpy(__w, &__acc, sizeof(_VecT));
+        for (size_t __l = 0; __l < _S_lanes; ++__l)
+          __result += (__w[__l] * (~_WordT(0) / 65535)) >> (_GLIBCXX_BITSET_BITS_PER_WORD - 16);
+      }
+#endif
+      for (; __i < __n; ++__i)
+        __result += __builtin_popcountl(_And ? __x[__i] & __y[__i] : __x[__i]);
+      return __result;
+    }
+
+    // Shift __x[0, __n) left by __wshift words plus __offset bits
+    // (0 < __offset < word size), filling from the bottom with zeros up
+    // to word __wshift.  Works downwards, so a block is always read
+    // before the block below it is overwritten.
+    static void
+    _S_left_shift(_WordT* __x, size_t __n, size_t __wshift,
+                  size_t __offset) noexcept {
+      const size_t __sub_offset = _GLIBCXX_BITSET_BITS_PER_WORD - __offset;
+      size_t __i = __n;
+      for (_VecT __a, __b; __i >= __wshift + 1 + _S_lanes; __i -= _S_lanes) {
+        _S_load(__a, __x + __i - _S_lanes - __wshift);
+        _S_load(__b, __x + __i - _S_lanes - __wshift - 1);
+        _S_store(__x + __i - _S_lanes, (__a << __offset) | (__b >> __sub_offset));
+      }
+      for (; __i > __wshift + 1; --__i)
+        __x[__i - 1] = (__x[__i - 1 - __wshift] << __offset) | (__x[__i - 2 - __wshift] >> __sub_offset);
+      __x[__wshift] = __x[0] << __offset;
+    }
+
+    // The mirror image of _S_left_shift; works upwards.
+    static void
+    _S_right_shift(_WordT* __x, size_t __n, size_t __wshift,
+                   size_t __offset) noexcept {
+      const size_t __sub_offset = _GLIBCXX_BITSET_BITS_PER_WORD - __offset;
+      const size_t __limit = __n - __wshift - 1;
+      size_t __i = 0;
+      for (_VecT __a, __b; __i + _S_lanes <= __limit; __i += _S_lanes) {
+        _S_load(__a, __x + __i + __wshift);
+        _S_load(__b, __x + __i + __wshift + 1);
+        _S_store(__x + __i, (__a >> __offset) | (__b << __sub_offset));
+      }
+      for (; __i < __limit; ++__i)
+        __x[__i] = (__x[__i + __wshift] >> __offset) | (__x[__i + __wshift + 1] << __sub_offset);
+      __x[__limit] = __x[__n - 1] >> __offset;
+    }
+  };
+
   /**
    *  Base class, general case.  It is a class invariant that _Nw will be
    *  nonnegative.
@@ -124,20 +326,29 @@ namespace std _GLIBCXX_VISIBILITY(default) {
     constexpr _WordT
     _M_hiword() const noexcept { return _M_w[_Nw - 1]; }
 
+    static constexpr bool
+    _S_use_kernels() noexcept { return _Nw >= _Bitset_kernels::_S_min_words; }
+
     void
     _M_do_and(const _Base_bitset<_Nw>& __x) noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_and(_M_w, __x._M_w, _Nw);
       for (size_t __i = 0; __i < _Nw; __i++)
         _M_w[__i] &= __x._M_w[__i];
     }
 
     void
     _M_do_or(const _Base_bitset<_Nw>& __x) noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_or(_M_w, __x._M_w, _Nw);
       for (size_t __i = 0; __i < _Nw; __i++)
         _M_w[__i] |= __x._M_w[__i];
     }
 
     void
     _M_do_xor(const _Base_bitset<_Nw>& __x) noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_xor(_M_w, __x._M_w, _Nw);
       for (size_t __i = 0; __i < _Nw; __i++)
         _M_w[__i] ^= __x._M_w[__i];
     }
@@ -150,6 +361,8 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     void
     _M_do_flip() noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_flip(_M_w, _Nw);
       for (size_t __i = 0; __i < _Nw; __i++)
         _M_w[__i] = ~_M_w[__i];
     }
@@ -165,6 +378,8 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     bool
     _M_is_equal(const _Base_bitset<_Nw>& __x) const noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_is_equal(_M_w, __x._M_w, _Nw);
       for (size_t __i = 0; __i < _Nw; ++__i)
         if (_M_w[__i] != __x._M_w[__i])
           return false;
@@ -182,6 +397,8 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     bool
     _M_is_any() const noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_find_nonzero(_M_w, 0, _Nw) != _Nw;
       for (size_t __i = 0; __i < _Nw; __i++)
         if (_M_w[__i] != static_cast<_WordT>(0))
           return true;
@@ -190,12 +407,39 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     size_t
     _M_do_count() const noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_count<false>(_M_w, 0, _Nw);
       size_t __result = 0;
       for (size_t __i = 0; __i < _Nw; __i++)
         __result += __builtin_popcountl(_M_w[__i]);
       return __result;
     }
 
+    // count() of (*this & __x) without materializing the intersection.
+    size_t
+    _M_do_and_count(const _Base_bitset<_Nw>& __x) const noexcept {
+      if (_S_use_kernels())
+        return _Bitset_kernels::_S_count<true>(_M_w, __x._M_w, _Nw);
+      size_t __result = 0;
+      for (size_t __i = 0; __i < _Nw; __i++)
+        __result += __builtin_popcountl(_M_w[__i] & __x._M_w[__i]);
+      return __result;
+    }
+
+    template <typename _Func>
+    void
+    _M_do_for_each_set_bit(_Func& __f) const {
+      for (size_t __i = 0; __i < _Nw; __i++) {
+        if (_S_use_kernels()) {
+          __i = _Bitset_kernels::_S_find_nonzero(_M_w, __i, _Nw);
+          if (__i == _Nw)
+            break;
+        }
+        for (_WordT __w = _M_w[__i]; __w != 0; __w &= __w - 1)
+          __f(__i * _GLIBCXX_BITSET_BITS_PER_WORD + __builtin_ctzl(__w));
+      }
+    }
+
     unsigned long
     _M_do_to_ulong() const;
 
@@ -224,6 +468,8 @@ namespace std _GLIBCXX_VISIBILITY(default) {
       if (__offset == 0)
         for (size_t __n = _Nw - 1; __n >= __wshift; --__n)
           _M_w[__n] = _M_w[__n - __wshift];
+      else if (_S_use_kernels())
+        _Bitset_kernels::_S_left_shift(_M_w, _Nw, __wshift, __offset);
       else {
         const size_t __sub_offset = (_GLIBCXX_BITSET_BITS_PER_WORD - __offset);
         for (size_t __n = _Nw - 1; __n > __wshift; --__n)
@@ -246,6 +492,8 @@ namespace std _GLIBCXX_VISIBILITY(default) {
       if (__offset == 0)
         for (size_t __n = 0; __n <= __limit; ++__n)
           _M_w[__n] = _M_w[__n + __wshift];
+      else if (_S_use_kernels())
+        _Bitset_kernels::_S_right_shift(_M_w, _Nw, __wshift, __offset);
       else {
         const size_t __sub_offset = (_GLIBCXX_BITSET_BITS_PER_WORD - __offset);
         for (size_t __n = 0; __n < __limit; ++__n)
@@ -286,6 +534,12 @@ namespace std _GLIBCXX_VISIBILITY(default) {
   size_t
   _Base_bitset<_Nw>::
       _M_do_find_first(size_t __not_found) const noexcept {
+    if (_S_use_kernels()) {
+      const size_t __i = _Bitset_kernels::_S_find_nonzero(_M_w, 0, _Nw);
+      if (__i != _Nw)
+        return (__i * _GLIBCXX_BITSET_BITS_PER_WORD + __builtin_ctzl(_M_w[__i]));
+      return __not_found;
+    }
     for (size_t __i = 0; __i < _Nw; __i++) {
       _WordT __thisword = _M_w[__i];
       if (__thisword != static_cast<_WordT>(0))
@@ -318,6 +572,12 @@ namespace std _GLIBCXX_VISIBILITY(default) {
 
     // check subsequent words
     __i++;
+    if (_S_use_kernels()) {
+      __i = _Bitset_kernels::_S_find_nonzero(_M_w, __i, _Nw);
+      if (__i != _Nw)
+        return (__i * _GLIBCXX_BITSET_BITS_PER_WORD + __builtin_ctzl(_M_w[__i]));
+      return __not_found;
+    }
     for (; __i < _Nw; __i++) {
       __thisword = _M_w[__i];
       if (__thisword != static_cast<_WordT>(0))
@@ -414,6 +674,16 @@ namespace std _GLIBCXX_VISIBILITY(default) {
     size_t
     _M_do_count() const noexcept { return __builtin_popcountl(_M_w); }
 
+    size_t
+    _M_do_and_count(const _Base_bitset<1>& __x) const noexcept { return __builtin_popcountl(_M_w & __x._M_w); }
+
+    template <typename _Func>
+    void
+    _M_do_for_each_set_bit(_Func& __f) const {
+      for (_WordT __w = _M_w; __w != 0; __w &= __w - 1)
+        __f(size_t(__builtin_ctzl(__w)));
+    }
+
     unsigned long
     _M_do_to_ulong() const noexcept { return _M_w; }
 
@@ -536,6 +806,13 @@ namespace std _GLIBCXX_VISIBILITY(default) {
     size_t
     _M_do_count() const noexcept { return 0; }
 
+    size_t
+    _M_do_and_count(const _Base_bitset<0>&) const noexcept { return 0; }
+
+    template <typename _Func>
+    void
+    _M_do_for_each_set_bit(_Func&) const {}
+
     unsigned long
     _M_do_to_ulong() const noexcept { return 0; }
 
@@ -1213,6 +1490,29 @@ namespace std _GLIBCXX_VISIBILITY(default) {
        */
     size_t
     _Find_next(size_t __prev) const noexcept { return this->_M_do_find_next(__prev, _Nb); }
+
+    /**
+       *  @brief  Counts the bits set in both bitsets.
+       *  @return  (*this & __x).count(), without building the intersection.
+       *  @param  __x  A bitset of the same size.
+       *  @ingroup SGIextensions
+       */
+    size_t
+    _And_count(const bitset<_Nb>& __x) const noexcept { return this->_M_do_and_count(__x); }
+
+    /**
+       *  @brief  Calls @a __f with the index of every "on" bit, in
+       *  increasing order.
+       *  @return  @a __f.
+       *  @ingroup SGIextensions
+       *  @sa  _Find_first, _Find_next
+       */
+    template <typename _Func>
+    _Func
+    _For_each_set_bit(_Func __f) const {
+      this->_M_do_for_each_set_bit(__f);
+      return __f;
+    }
   };
 
   // Definitions of non-inline member functions.
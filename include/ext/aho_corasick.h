@@ -0,0 +1,229 @@
+// Multi-pattern Aho-Corasick searcher -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/aho_corasick.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _AHO_CORASICK_H
+#define _AHO_CORASICK_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <bits/functexcept.h>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief  Searches for many literal patterns in one pass.
+   *
+   *  The patterns are compiled into an Aho-Corasick automaton whose states
+   *  are laid out in breadth-first order, so the shallow states a scan
+   *  spends most of its time in are adjacent in memory.  The root and
+   *  states with many outgoing edges get a dense row of 256 resolved
+   *  transitions; the others keep a short sorted edge list and follow
+   *  failure links.  Scanning costs O(n + number of matches).
+   *
+   *  Patterns are identified by their index in the sequence given to the
+   *  constructor.  Empty patterns never match.  Matches are reported as
+   *  (pattern, position) pairs, position being the offset of the first
+   *  character of the occurrence, in order of their end position and,
+   *  for the same end, from longest to shortest pattern.
+   *
+   *  Objects of this type are usable with std::search, which yields the
+   *  occurrence that ends first.  The nested class stream keeps the
+   *  automaton state between chunks of input, so occurrences spanning
+   *  chunk boundaries are found too.
+   */
+  template <typename _CharT = char>
+  class aho_corasick_searcher {
+    static_assert(sizeof(_CharT) == 1, "aho_corasick_searcher requires a byte-sized character type");
+
+    typedef std::uint32_t _Index;
+
+    // Marks a state whose transitions are a dense row.
+    static constexpr _Index _S_dense = _Index(-1);
+
+    // States with more outgoing edges than this get a dense row.
+    static constexpr size_t _S_sparse_max = 8;
+
+    struct _State {
+      _Index _M_fail;
+      _Index _M_report;    // This state if it has outputs, else the nearest
+                           // failure-chain state that has, else 0.
+      _Index _M_first;     // Dense row, or offset of the sparse edges.
+      _Index _M_count;     // Number of sparse edges, or _S_dense.
+      _Index _M_out_first; // Offset of the patterns ending here.
+      _Index _M_out_count;
+    };
+
+  public:
+    typedef _CharT char_type;
+    typedef std::basic_string_view<_CharT> string_view_type;
+
+    /**
+     *  @brief  Compiles the patterns in [__first, __last).
+     *  @throw  std::length_error  If the automaton needs more than
+     *          2^32 - 1 states.
+     *
+     *  Each element must be convertible to string_view_type.  The patterns
+     *  are copied into the automaton and need not outlive it.
+     */
+    template <typename _ForwardIterator>
+    aho_corasick_searcher(_ForwardIterator __first, _ForwardIterator __last) { _M_build(__first, __last); }
+
+    aho_corasick_searcher(std::initializer_list<string_view_type> __l) { _M_build(__l.begin(), __l.end()); }
+
+    /// Number of patterns.
+    size_t
+    size() const noexcept { return _M_lengths.size(); }
+
+    /// Length of pattern @a __pattern.
+    size_t
+    pattern_length(size_t __pattern) const noexcept { return _M_lengths[__pattern]; }
+
+    /**
+     *  @brief  Finds the occurrence of any pattern that ends first.
+     *  @return  The range of that occurrence, or (__last, __last).
+     */
+    template <typename _ForwardIterator>
+    std::pair<_ForwardIterator, _ForwardIterator>
+    operator()(_ForwardIterator __first, _ForwardIterator __last) const;
+
+    /**
+     *  @brief  Calls @c __f(pattern,position) for every occurrence in
+     *          [__first, __last).
+     */
+    template <typename _InputIterator, typename _Func>
+    void
+    for_each_match(_InputIterator __first, _InputIterator __last, _Func __f) const {
+      size_t __n = 0;
+      _M_scan(__first, __last, _Index(0), __n, [&__f](size_t __p, size_t __pos) {
+        __f(__p, __pos);
+        return true;
+      });
+    }
+
+    template <typename _Func>
+    void
+    for_each_match(string_view_type __s, _Func __f) const { for_each_match(__s.begin(), __s.end(), std::move(__f)); }
+
+    /**
+     *  Incremental search over input that arrives in chunks.  Positions
+     *  are offsets from the start of the whole input, and occurrences may
+     *  span chunks.  The searcher must outlive the stream.
+     */
+    class stream {
+    public:
+      explicit stream(const aho_corasick_searcher& __ac) noexcept
+          : _M_ac(&__ac), _M_state(0), _M_pos(0) {}
+
+      /// Scans the next chunk, calling @c __f(pattern,position) for each
+      /// occurrence that ends in it.
+      template <typename _InputIterator, typename _Func>
+      void
+      feed(_InputIterator __first, _InputIterator __last, _Func __f) {
+        _M_state = _M_ac->_M_scan(__first, __last, _M_state, _M_pos,
+                                  [&__f](size_t __p, size_t __pos) {
+                                    __f(__p, __pos);
+                                    return true;
+                                  });
+      }
+
+      template <typename _Func>
+      void
+      feed(string_view_type __s, _Func __f) { feed(__s.begin(), __s.end(), std::move(__f)); }
+
+      /// Characters consumed so far.
+      size_t
+      position() const noexcept { return _M_pos; }
+
+      /// Forgets all input, as if newly constructed.
+      void
+      reset() noexcept {
+        _M_state = 0;
+        _M_pos = 0;
+      }
+
+    private:
+      const aho_corasick_searcher* _M_ac;
+      _Index _M_state;
+      size_t _M_pos;
+    };
+
+  private:
+    template <typename _ForwardIterator>
+    void
+    _M_build(_ForwardIterator __first, _ForwardIterator __last);
+
+    _Index
+    _M_next(_Index __s, unsigned char __c) const noexcept {
+      for (;;) {
+        const _State& __st = _M_states[__s];
+        if (__st._M_count == _S_dense)
+          return _M_dense[size_t(__st._M_first) * 256 + __c];
+        const unsigned char* __labels = _M_labels.data() + __st._M_first;
+        for (_Index __i = 0; __i < __st._M_count; ++__i)
+          if (__labels[__i] == __c)
+            return _M_targets[__st._M_first + __i];
+        __s = __st._M_fail;
+      }
+    }
+
+    // Runs the automaton from state __s over [__first, __last), whose first
+    // character is at offset __pos, calling __f(pattern, position) for each
+    // occurrence until it returns false.  Updates __pos and returns the
+    // final state.
+    template <typename _InputIterator, typename _Func>
+    _Index
+    _M_scan(_InputIterator __first, _InputIterator __last, _Index __s, size_t& __pos, _Func __f) const;
+
+    std::vector<_State> _M_states;
+    std::vector<_Index> _M_dense;
+    std::vector<unsigned char> _M_labels;
+    std::vector<_Index> _M_targets;
+    std::vector<_Index> _M_outputs;
+    std::vector<size_t> _M_lengths;
+  };
+
+  template <typename _ForwardIterator>
+  aho_corasick_searcher(_ForwardIterator, _ForwardIterator)->aho_corasick_searcher<>;
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#include <ext/aho_corasick.tcc>
+
+#endif // C++17
+
+#endif // _AHO_CORASICK_H
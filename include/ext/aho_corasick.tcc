@@ -0,0 +1,193 @@
+// Multi-pattern Aho-Corasick searcher implementation -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/aho_corasick.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/aho_corasick.h}
+ */
+
+#ifndef _AHO_CORASICK_TCC
+#define _AHO_CORASICK_TCC 1
+
+#include <algorithm>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template <typename _CharT>
+  template <typename _ForwardIterator>
+  void
+  aho_corasick_searcher<_CharT>::
+      _M_build(_ForwardIterator __first, _ForwardIterator __last) {
+    typedef std::pair<unsigned char, _Index> _Edge;
+
+    // Build the trie with unsorted edge lists.
+    std::vector<std::vector<_Edge>> __edges(1);
+    std::vector<std::vector<_Index>> __ends(1);
+    for (; __first != __last; ++__first) {
+      const string_view_type __p(*__first);
+      const _Index __id = _M_lengths.size();
+      _M_lengths.push_back(__p.size());
+      if (__p.empty())
+        continue;
+      _Index __s = 0;
+      for (const _CharT __ch : __p) {
+        const unsigned char __c = static_cast<unsigned char>(__ch);
+        auto& __out = __edges[__s];
+        auto __e = std::find_if(__out.begin(), __out.end(),
+                                [__c](const _Edge& __x) { return __x.first == __c; });
+        if (__e != __out.end()) {
+          __s = __e->second;
+          continue;
+        }
+        if (__edges.size() >= size_t(_S_dense))
+          std::__throw_length_error(__N("aho_corasick_searcher: too many states"));
+        const _Index __t = __edges.size();
+        __out.emplace_back(__c, __t);
+        __edges.emplace_back();
+        __ends.emplace_back();
+        __s = __t;
+      }
+      __ends[__s].push_back(__id);
+    }
+    for (auto& __out : __edges)
+      std::sort(__out.begin(), __out.end());
+
+    auto __child = [&__edges](_Index __s, unsigned char __c) -> _Index {
+      const auto& __out = __edges[__s];
+      auto __e = std::lower_bound(__out.begin(), __out.end(), _Edge(__c, 0));
+      return __e != __out.end() && __e->first == __c ? __e->second : _Index(0);
+    };
+
+    // Breadth-first order and failure links, in trie numbering.
+    const size_t __n = __edges.size();
+    std::vector<_Index> __order;
+    std::vector<_Index> __fail(__n, 0);
+    __order.reserve(__n);
+    __order.push_back(0);
+    for (size_t __i = 0; __i < __order.size(); ++__i) {
+      const _Index __u = __order[__i];
+      for (const _Edge& __e : __edges[__u]) {
+        _Index __f = 0;
+        if (__u != 0) {
+          __f = __fail[__u];
+          while (__f != 0 && !__child(__f, __e.first))
+            __f = __fail[__f];
+          __f = __child(__f, __e.first);
+        }
+        __fail[__e.second] = __f;
+        __order.push_back(__e.second);
+      }
+    }
+
+    // Renumber states in breadth-first order and lay them out.
+    std::vector<_Index> __rank(__n);
+    for (size_t __i = 0; __i < __n; ++__i)
+      __rank[__order[__i]] = __i;
+
+    _M_states.resize(__n);
+    _Index __rows = 0;
+    for (size_t __i = 0; __i < __n; ++__i) {
+      const _Index __u = __order[__i];
+      _State& __st = _M_states[__i];
+      __st._M_fail = __rank[__fail[__u]];
+      __st._M_out_first = _M_outputs.size();
+      __st._M_out_count = __ends[__u].size();
+      _M_outputs.insert(_M_outputs.end(), __ends[__u].begin(), __ends[__u].end());
+      if (__i == 0 || __edges[__u].size() > _S_sparse_max) {
+        __st._M_first = __rows++;
+        __st._M_count = _S_dense;
+      } else {
+        __st._M_first = _M_labels.size();
+        __st._M_count = __edges[__u].size();
+        for (const _Edge& __e : __edges[__u]) {
+          _M_labels.push_back(__e.first);
+          _M_targets.push_back(__rank[__e.second]);
+        }
+      }
+      // The failure target is shallower, so its _M_report is final.
+      __st._M_report = __st._M_out_count ? _Index(__i) : _M_states[__st._M_fail]._M_report;
+    }
+
+    // Dense rows resolve failures in advance.  Shallower states come
+    // first, so _M_next on a failure target only sees finished rows.
+    _M_dense.resize(size_t(__rows) * 256);
+    for (size_t __i = 0; __i < __n; ++__i) {
+      const _State& __st = _M_states[__i];
+      if (__st._M_count != _S_dense)
+        continue;
+      const _Index __u = __order[__i];
+      _Index* __row = _M_dense.data() + size_t(__st._M_first) * 256;
+      for (unsigned __c = 0; __c < 256; ++__c) {
+        if (const _Index __t = __child(__u, __c))
+          __row[__c] = __rank[__t];
+        else
+          __row[__c] = __i == 0 ? 0 : _M_next(__st._M_fail, __c);
+      }
+    }
+  }
+
+  template <typename _CharT>
+  template <typename _InputIterator, typename _Func>
+  typename aho_corasick_searcher<_CharT>::_Index
+  aho_corasick_searcher<_CharT>::
+      _M_scan(_InputIterator __first, _InputIterator __last, _Index __s, size_t& __pos, _Func __f) const {
+    for (; __first != __last; ++__first) {
+      __s = _M_next(__s, static_cast<unsigned char>(*__first));
+      ++__pos;
+      for (_Index __r = _M_states[__s]._M_report; __r != 0;
+           __r = _M_states[_M_states[__r]._M_fail]._M_report) {
+        const _State& __st = _M_states[__r];
+        for (_Index __k = 0; __k < __st._M_out_count; ++__k) {
+          const _Index __p = _M_outputs[__st._M_out_first + __k];
+          if (!__f(size_t(__p), __pos - _M_lengths[__p]))
+            return __s;
+        }
+      }
+    }
+    return __s;
+  }
+
+  template <typename _CharT>
+  template <typename _ForwardIterator>
+  std::pair<_ForwardIterator, _ForwardIterator>
+  aho_corasick_searcher<_CharT>::
+  operator()(_ForwardIterator __first, _ForwardIterator __last) const {
+    size_t __pos = 0;
+    size_t __found = size_t(-1), __len = 0;
+    _M_scan(__first, __last, _Index(0), __pos, [&](size_t __p, size_t __start) {
+      __found = __start;
+      __len = _M_lengths[__p];
+      return false;
+    });
+    if (__found == size_t(-1))
+      return std::make_pair(__last, __last);
+    _ForwardIterator __match = std::next(__first, __found);
+    return std::make_pair(__match, std::next(__match, __len));
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // _AHO_CORASICK_TCC
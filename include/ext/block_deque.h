@@ -0,0 +1,1016 @@
+// Deque with a configurable node size -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/block_deque.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _BLOCK_DEQUE_H
+#define _BLOCK_DEQUE_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <bits/functexcept.h>
+#include <bits/stl_algo.h>
+#include <bits/stl_algobase.h>
+#include <bits/stl_construct.h>
+#include <bits/stl_iterator.h>
+#include <bits/stl_uninitialized.h>
+#include <ext/alloc_traits.h>
+#include <ext/numeric_traits.h>
+#include <initializer_list>
+#include <memory>
+
+#include <debug/assertions.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Random access iterator over a block_deque: std::_Deque_iterator
+  /// with the node size _Nm fixed by the container.
+  template <typename _Tp, size_t _Nm, bool _Const>
+  struct _Block_deque_iterator {
+    typedef _Tp* _Elt_pointer;
+    typedef _Tp** _Map_pointer;
+
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef _Tp value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::conditional<_Const, const _Tp*, _Tp*>::type pointer;
+    typedef typename std::conditional<_Const, const _Tp&, _Tp&>::type reference;
+
+    _Elt_pointer _M_cur;
+    _Elt_pointer _M_first;
+    _Elt_pointer _M_last;
+    _Map_pointer _M_node;
+
+    _Block_deque_iterator() noexcept
+        : _M_cur(), _M_first(), _M_last(), _M_node() {}
+
+    _Block_deque_iterator(_Elt_pointer __x, _Map_pointer __y) noexcept
+        : _M_cur(__x), _M_first(*__y), _M_last(*__y + _Nm), _M_node(__y) {}
+
+    // iterator to const_iterator conversion
+    template <bool _C2, typename = typename std::enable_if<_Const && !_C2>::type>
+    _Block_deque_iterator(const _Block_deque_iterator<_Tp, _Nm, _C2>& __it) noexcept
+        : _M_cur(__it._M_cur), _M_first(__it._M_first), _M_last(__it._M_last), _M_node(__it._M_node) {}
+
+    reference
+    operator*() const noexcept { return *_M_cur; }
+
+    pointer
+    operator->() const noexcept { return _M_cur; }
+
+    _Block_deque_iterator&
+    operator++() noexcept {
+      if (++_M_cur == _M_last) {
+        _M_set_node(_M_node + 1);
+        _M_cur = _M_first;
+      }
+      return *this;
+    }
+
+    _Block_deque_iterator
+    operator++(int) noexcept {
+      _Block_deque_iterator __tmp = *this;
+      ++*this;
+      return __tmp;
+    }
+
+    _Block_deque_iterator&
+    operator--() noexcept {
+      if (_M_cur == _M_first) {
+        _M_set_node(_M_node - 1);
+        _M_cur = _M_last;
+      }
+      --_M_cur;
+      return *this;
+    }
+
+    _Block_deque_iterator
+    operator--(int) noexcept {
+      _Block_deque_iterator __tmp = *this;
+      --*this;
+      return __tmp;
+    }
+
+    _Block_deque_iterator&
+    operator+=(difference_type __n) noexcept {
+      const difference_type __offset = __n + (_M_cur - _M_first);
+      if (__offset >= 0 && __offset < difference_type(_Nm))
+        _M_cur += __n;
+      else {
+        const difference_type __node_offset =
+            __offset > 0 ? __offset / difference_type(_Nm) : -difference_type((-__offset - 1) / _Nm) - 1;
+        _M_set_node(_M_node + __node_offset);
+        _M_cur = _M_first + (__offset - __node_offset * difference_type(_Nm));
+      }
+      return *this;
+    }
+
+    _Block_deque_iterator&
+    operator-=(difference_type __n) noexcept { return *this += -__n; }
+
+    _Block_deque_iterator
+    operator+(difference_type __n) const noexcept {
+      _Block_deque_iterator __tmp = *this;
+      return __tmp += __n;
+    }
+
+    _Block_deque_iterator
+    operator-(difference_type __n) const noexcept {
+      _Block_deque_iterator __tmp = *this;
+      return __tmp -= __n;
+    }
+
+    reference
+    operator[](difference_type __n) const noexcept { return *(*this + __n); }
+
+    void
+    _M_set_node(_Map_pointer __new_node) noexcept {
+      _M_node = __new_node;
+      _M_first = *__new_node;
+      _M_last = _M_first + _Nm;
+    }
+
+    friend bool
+    operator==(const _Block_deque_iterator& __x, const _Block_deque_iterator& __y) noexcept { return __x._M_cur == __y._M_cur; }
+
+    friend bool
+    operator!=(const _Block_deque_iterator& __x, const _Block_deque_iterator& __y) noexcept { return !(__x == __y); }
+
+    friend bool
+    operator<(const _Block_deque_iterator& __x, const _Block_deque_iterator& __y) noexcept {
+      return __x._M_node == __y._M_node ? __x._M_cur < __y._M_cur : __x._M_node < __y._M_node;
+    }
+
+    friend bool
+    operator>(const _Block_deque_iterator& __x, const _Block_deque_iterator& __y) noexcept { return __y < __x; }
+
+    friend bool
+    operator<=(const _Block_deque_iterator& __x, const _Block_deque_iterator& __y) noexcept { return !(__y < __x); }
+
+    friend bool
+    operator>=(const _Block_deque_iterator& __x, const _Block_deque_iterator& __y) noexcept { return !(__x < __y); }
+
+    // An empty block_deque has no nodes, so both iterators may be null.
+    friend difference_type
+    operator-(const _Block_deque_iterator& __x, const _Block_deque_iterator& __y) noexcept {
+      return difference_type(_Nm) * (__x._M_node - __y._M_node - bool(__x._M_node)) + (__x._M_cur - __x._M_first) +
+             (__y._M_last - __y._M_cur);
+    }
+
+    friend _Block_deque_iterator
+    operator+(difference_type __n, const _Block_deque_iterator& __x) noexcept { return __x + __n; }
+  };
+
+  // Calls __f(__p, __q) on each contiguous run [__p, __q) of [__first,
+  // __last) in order, stopping when it returns false.  Returns whether it
+  // went through the whole range.
+  template <typename _Tp, size_t _Nm, bool _Const, typename _Func>
+  bool
+  __block_deque_runs(const _Block_deque_iterator<_Tp, _Nm, _Const>& __first,
+                     const _Block_deque_iterator<_Tp, _Nm, _Const>& __last, _Func __f) {
+    typedef typename _Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    if (__first._M_node == __last._M_node)
+      return __f(_Ptr(__first._M_cur), _Ptr(__last._M_cur));
+    if (!__f(_Ptr(__first._M_cur), _Ptr(__first._M_last)))
+      return false;
+    for (_Tp** __node = __first._M_node + 1; __node != __last._M_node; ++__node)
+      if (!__f(_Ptr(*__node), _Ptr(*__node + _Nm)))
+        return false;
+    return __f(_Ptr(__last._M_first), _Ptr(__last._M_cur));
+  }
+
+  // As __block_deque_runs, from the last run to the first.
+  template <typename _Tp, size_t _Nm, bool _Const, typename _Func>
+  bool
+  __block_deque_runs_backward(const _Block_deque_iterator<_Tp, _Nm, _Const>& __first,
+                              const _Block_deque_iterator<_Tp, _Nm, _Const>& __last, _Func __f) {
+    typedef typename _Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    if (__first._M_node == __last._M_node)
+      return __f(_Ptr(__first._M_cur), _Ptr(__last._M_cur));
+    if (!__f(_Ptr(__last._M_first), _Ptr(__last._M_cur)))
+      return false;
+    for (_Tp** __node = __last._M_node - 1; __node != __first._M_node; --__node)
+      if (!__f(_Ptr(*__node), _Ptr(*__node + _Nm)))
+        return false;
+    return __f(_Ptr(__first._M_cur), _Ptr(__first._M_last));
+  }
+
+  // Copies, or moves if _IsMove, the contiguous range [__first, __last)
+  // to __result, one destination node at a time.
+  template <bool _IsMove, typename _Ptr, typename _Tp, size_t _Nm>
+  _Block_deque_iterator<_Tp, _Nm, false>
+  __block_deque_copy_in(_Ptr __first, _Ptr __last, _Block_deque_iterator<_Tp, _Nm, false> __result) {
+    ptrdiff_t __len = __last - __first;
+    while (__len > 0) {
+      const ptrdiff_t __clen = std::min(__len, __result._M_last - __result._M_cur);
+      std::__copy_move_a<_IsMove>(__first, __first + __clen, __result._M_cur);
+      __first += __clen;
+      __result += __clen;
+      __len -= __clen;
+    }
+    return __result;
+  }
+
+  template <bool _IsMove, typename _Ptr, typename _Tp, size_t _Nm>
+  _Block_deque_iterator<_Tp, _Nm, false>
+  __block_deque_copy_backward_in(_Ptr __first, _Ptr __last, _Block_deque_iterator<_Tp, _Nm, false> __result) {
+    ptrdiff_t __len = __last - __first;
+    while (__len > 0) {
+      ptrdiff_t __rlen = __result._M_cur - __result._M_first;
+      _Tp* __rend = __result._M_cur;
+      if (!__rlen) {
+        __rlen = _Nm;
+        __rend = *(__result._M_node - 1) + _Nm;
+      }
+      const ptrdiff_t __clen = std::min(__len, __rlen);
+      std::__copy_move_backward_a<_IsMove>(__last - __clen, __last, __rend);
+      __last -= __clen;
+      __result -= __clen;
+      __len -= __clen;
+    }
+    return __result;
+  }
+
+  /// Map and node allocation for block_deque.
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  struct _Block_deque_base {
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Tp>::other _Tp_alloc_type;
+    typedef __alloc_traits<_Tp_alloc_type> _Tp_alloc_traits;
+    typedef typename _Tp_alloc_traits::template rebind<_Tp*>::other _Map_alloc_type;
+    typedef __alloc_traits<_Map_alloc_type> _Map_alloc_traits;
+    typedef _Block_deque_iterator<_Tp, _Nm, false> iterator;
+    typedef _Tp** _Map_pointer;
+
+    static_assert(std::is_pointer<typename _Tp_alloc_traits::pointer>::value,
+                  "__gnu_cxx::block_deque requires an allocator with raw pointers");
+
+    enum { _S_initial_map_size = 8 };
+
+    // An empty map, and null _M_start and _M_finish, until the first
+    // element is added.
+    struct _Block_deque_impl : public _Tp_alloc_type {
+      _Map_pointer _M_map;
+      size_t _M_map_size;
+      iterator _M_start;
+      iterator _M_finish;
+
+      _Block_deque_impl() noexcept(std::is_nothrow_default_constructible<_Tp_alloc_type>::value)
+          : _Tp_alloc_type(), _M_map(), _M_map_size(0), _M_start(), _M_finish() {}
+
+      _Block_deque_impl(const _Tp_alloc_type& __a) noexcept
+          : _Tp_alloc_type(__a), _M_map(), _M_map_size(0), _M_start(), _M_finish() {}
+
+      _Block_deque_impl(_Block_deque_impl&& __x) noexcept
+          : _Tp_alloc_type(std::move(__x)), _M_map(), _M_map_size(0), _M_start(), _M_finish() { _M_swap_data(__x); }
+
+      void
+      _M_swap_data(_Block_deque_impl& __x) noexcept {
+        using std::swap;
+        swap(_M_map, __x._M_map);
+        swap(_M_map_size, __x._M_map_size);
+        swap(_M_start, __x._M_start);
+        swap(_M_finish, __x._M_finish);
+      }
+    };
+
+    _Block_deque_impl _M_impl;
+
+    _Block_deque_base() = default;
+
+    _Block_deque_base(const _Tp_alloc_type& __a) noexcept
+        : _M_impl(__a) {}
+
+    _Block_deque_base(_Block_deque_base&&) = default;
+
+    ~_Block_deque_base() noexcept {
+      if (_M_impl._M_map) {
+        _M_destroy_nodes(_M_impl._M_start._M_node, _M_impl._M_finish._M_node + 1);
+        _M_deallocate_map(_M_impl._M_map, _M_impl._M_map_size);
+      }
+    }
+
+    _Tp_alloc_type&
+    _M_get_Tp_allocator() noexcept { return _M_impl; }
+
+    const _Tp_alloc_type&
+    _M_get_Tp_allocator() const noexcept { return _M_impl; }
+
+    _Tp*
+    _M_allocate_node() { return _Tp_alloc_traits::allocate(_M_impl, _Nm); }
+
+    void
+    _M_deallocate_node(_Tp* __p) noexcept { _Tp_alloc_traits::deallocate(_M_impl, __p, _Nm); }
+
+    _Map_pointer
+    _M_allocate_map(size_t __n) {
+      _Map_alloc_type __map_alloc(_M_get_Tp_allocator());
+      return _Map_alloc_traits::allocate(__map_alloc, __n);
+    }
+
+    void
+    _M_deallocate_map(_Map_pointer __p, size_t __n) noexcept {
+      _Map_alloc_type __map_alloc(_M_get_Tp_allocator());
+      _Map_alloc_traits::deallocate(__map_alloc, __p, __n);
+    }
+
+    void
+    _M_create_nodes(_Map_pointer __nstart, _Map_pointer __nfinish) {
+      _Map_pointer __cur;
+      try {
+        for (__cur = __nstart; __cur < __nfinish; ++__cur)
+          *__cur = _M_allocate_node();
+      } catch (...) {
+        _M_destroy_nodes(__nstart, __cur);
+        throw;
+      }
+    }
+
+    void
+    _M_destroy_nodes(_Map_pointer __nstart, _Map_pointer __nfinish) noexcept {
+      for (_Map_pointer __n = __nstart; __n < __nfinish; ++__n)
+        _M_deallocate_node(*__n);
+    }
+
+    // Allocates the map and the nodes for __num_elements elements, with
+    // room to grow at both ends.  There must be no map yet.
+    void
+    _M_initialize_map(size_t __num_elements);
+  };
+
+  /**
+   *  @brief A double-ended queue whose nodes hold _Nm elements.
+   *
+   *  @tparam _Tp  Type of element.
+   *  @tparam _Nm  Number of elements per node.
+   *  @tparam _Alloc  Allocator type.
+   *
+   *  The same structure, complexity and iterator invalidation rules as
+   *  std::deque, whose nodes are 512 bytes: one element per node for
+   *  anything larger than 256 bytes, which makes a deque of large
+   *  elements behave like a list of heap blocks.  Here the node size is
+   *  chosen by the user instead.  Unlike std::deque, a default
+   *  constructed or moved-from block_deque allocates nothing.
+   *
+   *  The algorithms fill, copy, copy_backward, move, move_backward,
+   *  find, for_each and equal have overloads for block_deque iterators
+   *  that work on one node at a time, as those for std::deque do.
+  */
+  template <typename _Tp, size_t _Nm, typename _Alloc = std::allocator<_Tp>>
+  class block_deque : protected _Block_deque_base<_Tp, _Nm, _Alloc> {
+    static_assert(_Nm > 0, "__gnu_cxx::block_deque needs at least one element per node");
+    static_assert(std::is_same<typename std::remove_cv<_Tp>::type, _Tp>::value,
+                  "__gnu_cxx::block_deque must have a non-const, non-volatile value_type");
+
+    typedef _Block_deque_base<_Tp, _Nm, _Alloc> _Base;
+    typedef typename _Base::_Tp_alloc_type _Tp_alloc_type;
+    typedef typename _Base::_Tp_alloc_traits _Alloc_traits;
+    typedef typename _Base::_Map_pointer _Map_pointer;
+
+  public:
+    typedef _Tp value_type;
+    typedef _Tp* pointer;
+    typedef const _Tp* const_pointer;
+    typedef _Tp& reference;
+    typedef const _Tp& const_reference;
+    typedef _Block_deque_iterator<_Tp, _Nm, false> iterator;
+    typedef _Block_deque_iterator<_Tp, _Nm, true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef _Alloc allocator_type;
+
+  protected:
+    using _Base::_M_get_Tp_allocator;
+    using _Base::_M_impl;
+
+  public:
+    block_deque() = default;
+
+    explicit block_deque(const allocator_type& __a) noexcept
+        : _Base(_Tp_alloc_type(__a)) {}
+
+    explicit block_deque(size_type __n, const allocator_type& __a = allocator_type())
+        : _Base(_Tp_alloc_type(__a)) { _M_default_append(__n); }
+
+    block_deque(size_type __n, const value_type& __value,
+                const allocator_type& __a = allocator_type())
+        : _Base(_Tp_alloc_type(__a)) { _M_fill_append(__n, __value); }
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    block_deque(_InputIterator __first, _InputIterator __last,
+                const allocator_type& __a = allocator_type())
+        : _Base(_Tp_alloc_type(__a)) { _M_range_append(__first, __last, std::__iterator_category(__first)); }
+
+    block_deque(std::initializer_list<value_type> __l,
+                const allocator_type& __a = allocator_type())
+        : block_deque(__l.begin(), __l.end(), __a) {}
+
+    block_deque(const block_deque& __x)
+        : block_deque(__x.begin(), __x.end(),
+                      _Alloc_traits::_S_select_on_copy(__x._M_get_Tp_allocator())) {}
+
+    block_deque(const block_deque& __x, const allocator_type& __a)
+        : block_deque(__x.begin(), __x.end(), __a) {}
+
+    block_deque(block_deque&&) noexcept = default;
+
+    block_deque(block_deque&& __x, const allocator_type& __a)
+        : _Base(_Tp_alloc_type(__a)) {
+      if (_M_get_Tp_allocator() == __x._M_get_Tp_allocator())
+        _M_impl._M_swap_data(__x._M_impl);
+      else {
+        _M_range_append(std::make_move_iterator(__x.begin()), std::make_move_iterator(__x.end()),
+                        std::random_access_iterator_tag());
+        __x.clear();
+      }
+    }
+
+    ~block_deque() noexcept { _M_destroy_data(begin(), end()); }
+
+    block_deque&
+    operator=(const block_deque& __x);
+
+    block_deque&
+    operator=(block_deque&& __x) noexcept(_Alloc_traits::_S_nothrow_move());
+
+    block_deque&
+    operator=(std::initializer_list<value_type> __l) {
+      assign(__l.begin(), __l.end());
+      return *this;
+    }
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    void
+    assign(_InputIterator __first, _InputIterator __last);
+
+    void
+    assign(size_type __n, const value_type& __value);
+
+    void
+    assign(std::initializer_list<value_type> __l) { assign(__l.begin(), __l.end()); }
+
+    allocator_type
+    get_allocator() const noexcept { return allocator_type(_M_get_Tp_allocator()); }
+
+    // iterators
+    iterator
+    begin() noexcept { return _M_impl._M_start; }
+
+    const_iterator
+    begin() const noexcept { return _M_impl._M_start; }
+
+    iterator
+    end() noexcept { return _M_impl._M_finish; }
+
+    const_iterator
+    end() const noexcept { return _M_impl._M_finish; }
+
+    reverse_iterator
+    rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator
+    rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator
+    rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator
+    rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator
+    cbegin() const noexcept { return begin(); }
+
+    const_iterator
+    cend() const noexcept { return end(); }
+
+    const_reverse_iterator
+    crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator
+    crend() const noexcept { return rend(); }
+
+    // capacity
+    bool
+    empty() const noexcept { return _M_impl._M_start == _M_impl._M_finish; }
+
+    size_type
+    size() const noexcept { return _M_impl._M_finish - _M_impl._M_start; }
+
+    size_type
+    max_size() const noexcept {
+      const size_t __diffmax = __numeric_traits<ptrdiff_t>::__max / sizeof(_Tp);
+      const size_t __allocmax = _Alloc_traits::max_size(_M_get_Tp_allocator());
+      return std::min(__diffmax, __allocmax);
+    }
+
+    void
+    resize(size_type __new_size) {
+      const size_type __len = size();
+      if (__new_size > __len)
+        _M_default_append(__new_size - __len);
+      else
+        _M_erase_at_end(begin() + difference_type(__new_size));
+    }
+
+    void
+    resize(size_type __new_size, const value_type& __x) {
+      const size_type __len = size();
+      if (__new_size > __len)
+        _M_fill_append(__new_size - __len, __x);
+      else
+        _M_erase_at_end(begin() + difference_type(__new_size));
+    }
+
+    /// Frees the map and the spare nodes where that saves a node or more.
+    void
+    shrink_to_fit() noexcept;
+
+    // element access
+    reference
+    operator[](size_type __n) noexcept {
+      __glibcxx_requires_subscript(__n);
+      return _M_impl._M_start[difference_type(__n)];
+    }
+
+    const_reference
+    operator[](size_type __n) const noexcept {
+      __glibcxx_requires_subscript(__n);
+      return _M_impl._M_start[difference_type(__n)];
+    }
+
+    reference
+    at(size_type __n) {
+      _M_range_check(__n);
+      return (*this)[__n];
+    }
+
+    const_reference
+    at(size_type __n) const {
+      _M_range_check(__n);
+      return (*this)[__n];
+    }
+
+    reference
+    front() noexcept {
+      __glibcxx_requires_nonempty();
+      return *begin();
+    }
+
+    const_reference
+    front() const noexcept {
+      __glibcxx_requires_nonempty();
+      return *begin();
+    }
+
+    reference
+    back() noexcept {
+      __glibcxx_requires_nonempty();
+      return *(end() - 1);
+    }
+
+    const_reference
+    back() const noexcept {
+      __glibcxx_requires_nonempty();
+      return *(end() - 1);
+    }
+
+    // modifiers
+    template <typename... _Args>
+    reference
+    emplace_front(_Args&&... __args);
+
+    void
+    push_front(const value_type& __x) { emplace_front(__x); }
+
+    void
+    push_front(value_type&& __x) { emplace_front(std::move(__x)); }
+
+    template <typename... _Args>
+    reference
+    emplace_back(_Args&&... __args);
+
+    void
+    push_back(const value_type& __x) { emplace_back(__x); }
+
+    void
+    push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+    void
+    pop_front() noexcept {
+      __glibcxx_requires_nonempty();
+      iterator& __start = _M_impl._M_start;
+      _Alloc_traits::destroy(_M_impl, __start._M_cur);
+      if (__start._M_cur != __start._M_last - 1)
+        ++__start._M_cur;
+      else {
+        this->_M_deallocate_node(__start._M_first);
+        __start._M_set_node(__start._M_node + 1);
+        __start._M_cur = __start._M_first;
+      }
+    }
+
+    void
+    pop_back() noexcept {
+      __glibcxx_requires_nonempty();
+      iterator& __finish = _M_impl._M_finish;
+      if (__finish._M_cur == __finish._M_first) {
+        this->_M_deallocate_node(__finish._M_first);
+        __finish._M_set_node(__finish._M_node - 1);
+        __finish._M_cur = __finish._M_last;
+      }
+      --__finish._M_cur;
+      _Alloc_traits::destroy(_M_impl, __finish._M_cur);
+    }
+
+    template <typename... _Args>
+    iterator
+    emplace(const_iterator __position, _Args&&... __args);
+
+    iterator
+    insert(const_iterator __position, const value_type& __x) { return emplace(__position, __x); }
+
+    iterator
+    insert(const_iterator __position, value_type&& __x) { return emplace(__position, std::move(__x)); }
+
+    iterator
+    insert(const_iterator __position, size_type __n, const value_type& __x);
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    iterator
+    insert(const_iterator __position, _InputIterator __first, _InputIterator __last) {
+      return _M_range_insert(__position, __first, __last, std::__iterator_category(__first));
+    }
+
+    iterator
+    insert(const_iterator __position, std::initializer_list<value_type> __l) { return insert(__position, __l.begin(), __l.end()); }
+
+    iterator
+    erase(const_iterator __position) {
+      __glibcxx_assert(__position != end());
+      return erase(__position, __position + 1);
+    }
+
+    iterator
+    erase(const_iterator __first, const_iterator __last);
+
+    void
+    swap(block_deque& __x) noexcept {
+      __glibcxx_assert(_Alloc_traits::propagate_on_container_swap::value || _M_get_Tp_allocator() == __x._M_get_Tp_allocator());
+      _M_impl._M_swap_data(__x._M_impl);
+      _Alloc_traits::_S_on_swap(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+    }
+
+    void
+    clear() noexcept { _M_erase_at_end(begin()); }
+
+  private:
+    void
+    _M_range_check(size_type __n) const {
+      if (__n >= size())
+        std::__throw_out_of_range_fmt(__N("block_deque::_M_range_check: __n (which is %zu)"
+                                          ">= this->size() (which is %zu)"),
+                                      __n, size());
+    }
+
+    void
+    _M_destroy_data(iterator __first, iterator __last) noexcept {
+      if (!std::is_trivially_destructible<_Tp>::value)
+        __block_deque_runs(__first, __last, [this](_Tp* __p, _Tp* __q) {
+          std::_Destroy(__p, __q, _M_get_Tp_allocator());
+          return true;
+        });
+    }
+
+    // Destroys [__pos, end()) and frees the nodes after that of __pos.
+    void
+    _M_erase_at_end(iterator __pos) noexcept {
+      if (__pos == end())
+        return;
+      _M_destroy_data(__pos, end());
+      this->_M_destroy_nodes(__pos._M_node + 1, _M_impl._M_finish._M_node + 1);
+      _M_impl._M_finish = __pos;
+    }
+
+    // Destroys [begin(), __pos) and frees the nodes before that of __pos.
+    void
+    _M_erase_at_begin(iterator __pos) noexcept {
+      _M_destroy_data(begin(), __pos);
+      this->_M_destroy_nodes(_M_impl._M_start._M_node, __pos._M_node);
+      _M_impl._M_start = __pos;
+    }
+
+    // Makes room for __n elements before begin() or from end() on, and
+    // returns where the new begin() or end() will be.  The elements are
+    // for the caller to construct; if it fails, it frees the new nodes
+    // with _M_destroy_nodes.
+    iterator
+    _M_reserve_elements_at_front(size_type __n) {
+      if (!_M_impl._M_map)
+        this->_M_initialize_map(0);
+      const size_type __vacancies = _M_impl._M_start._M_cur - _M_impl._M_start._M_first;
+      if (__n > __vacancies)
+        _M_new_elements_at_front(__n - __vacancies);
+      return _M_impl._M_start - difference_type(__n);
+    }
+
+    iterator
+    _M_reserve_elements_at_back(size_type __n) {
+      if (!_M_impl._M_map)
+        this->_M_initialize_map(0);
+      const size_type __vacancies = (_M_impl._M_finish._M_last - _M_impl._M_finish._M_cur) - 1;
+      if (__n > __vacancies)
+        _M_new_elements_at_back(__n - __vacancies);
+      return _M_impl._M_finish + difference_type(__n);
+    }
+
+    void
+    _M_new_elements_at_front(size_type __new_elements);
+
+    void
+    _M_new_elements_at_back(size_type __new_elements);
+
+    void
+    _M_reserve_map_at_front(size_type __nodes_to_add) {
+      if (__nodes_to_add > size_type(_M_impl._M_start._M_node - _M_impl._M_map))
+        _M_reallocate_map(__nodes_to_add, true);
+    }
+
+    void
+    _M_reserve_map_at_back(size_type __nodes_to_add) {
+      if (__nodes_to_add + 1 > _M_impl._M_map_size - (_M_impl._M_finish._M_node - _M_impl._M_map))
+        _M_reallocate_map(__nodes_to_add, false);
+    }
+
+    void
+    _M_reallocate_map(size_type __nodes_to_add, bool __add_at_front);
+
+    void
+    _M_default_append(size_type __n);
+
+    void
+    _M_fill_append(size_type __n, const value_type& __x);
+
+    void
+    _M_fill_prepend(size_type __n, const value_type& __x);
+
+    template <typename _InputIterator>
+    void
+    _M_range_append(_InputIterator __first, _InputIterator __last, std::input_iterator_tag);
+
+    template <typename _ForwardIterator>
+    void
+    _M_range_append(_ForwardIterator __first, _ForwardIterator __last, std::forward_iterator_tag);
+
+    template <typename _ForwardIterator>
+    void
+    _M_range_prepend(_ForwardIterator __first, _ForwardIterator __last, size_type __n);
+
+    template <typename _InputIterator>
+    iterator
+    _M_range_insert(const_iterator __position, _InputIterator __first, _InputIterator __last,
+                    std::input_iterator_tag);
+
+    template <typename _ForwardIterator>
+    iterator
+    _M_range_insert(const_iterator __position, _ForwardIterator __first, _ForwardIterator __last,
+                    std::forward_iterator_tag);
+
+    // Moves the __n elements just added at one end to __offset.
+    iterator
+    _M_rotate_into_place(difference_type __offset, size_type __n, bool __at_front);
+  };
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator==(const block_deque<_Tp, _Nm, _Alloc>& __x, const block_deque<_Tp, _Nm, _Alloc>& __y) {
+    return __x.size() == __y.size() && std::equal(__x.begin(), __x.end(), __y.begin());
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator<(const block_deque<_Tp, _Nm, _Alloc>& __x, const block_deque<_Tp, _Nm, _Alloc>& __y) {
+    return std::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end());
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator!=(const block_deque<_Tp, _Nm, _Alloc>& __x, const block_deque<_Tp, _Nm, _Alloc>& __y) { return !(__x == __y); }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator>(const block_deque<_Tp, _Nm, _Alloc>& __x, const block_deque<_Tp, _Nm, _Alloc>& __y) { return __y < __x; }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator<=(const block_deque<_Tp, _Nm, _Alloc>& __x, const block_deque<_Tp, _Nm, _Alloc>& __y) { return !(__y < __x); }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator>=(const block_deque<_Tp, _Nm, _Alloc>& __x, const block_deque<_Tp, _Nm, _Alloc>& __y) { return !(__x < __y); }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline void
+  swap(block_deque<_Tp, _Nm, _Alloc>& __x, block_deque<_Tp, _Nm, _Alloc>& __y) noexcept { __x.swap(__y); }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+namespace std _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  // Overloads for block_deque iterators, which work on one node at a time.
+
+  template <typename _Tp, size_t _Nm>
+  void
+  fill(const __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false>& __first,
+       const __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false>& __last, const _Tp& __value) {
+    __gnu_cxx::__block_deque_runs(__first, __last, [&__value](_Tp* __p, _Tp* __q) {
+      std::fill(__p, __q, __value);
+      return true;
+    });
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const, typename _OI>
+  _OI
+  copy(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+       __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last, _OI __result) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    __gnu_cxx::__block_deque_runs(__first, __last, [&__result](_Ptr __p, _Ptr __q) {
+      __result = std::copy(__p, __q, __result);
+      return true;
+    });
+    return __result;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const>
+  __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false>
+  copy(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+       __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last,
+       __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false> __result) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    __gnu_cxx::__block_deque_runs(__first, __last, [&__result](_Ptr __p, _Ptr __q) {
+      __result = __gnu_cxx::__block_deque_copy_in<false>(__p, __q, __result);
+      return true;
+    });
+    return __result;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const>
+  __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false>
+  copy_backward(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+                __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last,
+                __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false> __result) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    __gnu_cxx::__block_deque_runs_backward(__first, __last, [&__result](_Ptr __p, _Ptr __q) {
+      __result = __gnu_cxx::__block_deque_copy_backward_in<false>(__p, __q, __result);
+      return true;
+    });
+    return __result;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const, typename _OI>
+  _OI
+  move(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+       __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last, _OI __result) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    __gnu_cxx::__block_deque_runs(__first, __last, [&__result](_Ptr __p, _Ptr __q) {
+      __result = std::move(__p, __q, __result);
+      return true;
+    });
+    return __result;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const>
+  __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false>
+  move(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+       __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last,
+       __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false> __result) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    __gnu_cxx::__block_deque_runs(__first, __last, [&__result](_Ptr __p, _Ptr __q) {
+      __result = __gnu_cxx::__block_deque_copy_in<true>(__p, __q, __result);
+      return true;
+    });
+    return __result;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const>
+  __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false>
+  move_backward(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+                __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last,
+                __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, false> __result) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    __gnu_cxx::__block_deque_runs_backward(__first, __last, [&__result](_Ptr __p, _Ptr __q) {
+      __result = __gnu_cxx::__block_deque_copy_backward_in<true>(__p, __q, __result);
+      return true;
+    });
+    return __result;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const, typename _Up>
+  __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>
+  find(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+       __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last, const _Up& __val) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    _Ptr __found = nullptr;
+    __gnu_cxx::__block_deque_runs(__first, __last, [&__val, &__found](_Ptr __p, _Ptr __q) {
+      for (; __p != __q; ++__p)
+        if (*__p == __val) {
+          __found = __p;
+          return false;
+        }
+      return true;
+    });
+    if (!__found)
+      return __last;
+    // __found is in the node of __first or in a later one.
+    while (!(__found >= __first._M_first && __found < __first._M_last))
+      __first._M_set_node(__first._M_node + 1);
+    __first._M_cur = const_cast<_Tp*>(__found);
+    return __first;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const, typename _Function>
+  _Function
+  for_each(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first,
+           __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last, _Function __f) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    __gnu_cxx::__block_deque_runs(__first, __last, [&__f](_Ptr __p, _Ptr __q) {
+      for (; __p != __q; ++__p)
+        __f(*__p);
+      return true;
+    });
+    return __f;
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const, typename _II>
+  bool
+  equal(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __first1,
+        __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const> __last1, _II __first2) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const>::pointer _Ptr;
+    // __first2 may be a single-pass iterator, so it is only ever
+    // incremented, never copied and advanced again.
+    return __gnu_cxx::__block_deque_runs(__first1, __last1, [&__first2](_Ptr __p, _Ptr __q) {
+      for (; __p != __q; ++__p, (void)++__first2)
+        if (!(*__p == *__first2))
+          return false;
+      return true;
+    });
+  }
+
+  template <typename _Tp, size_t _Nm, bool _Const1, bool _Const2>
+  bool
+  equal(__gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const1> __first1,
+        __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const1> __last1,
+        __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const2> __first2) {
+    typedef typename __gnu_cxx::_Block_deque_iterator<_Tp, _Nm, _Const1>::pointer _Ptr;
+    // Compare the longest run that is contiguous in both ranges, which
+    // lets std::equal use memcmp.
+    return __gnu_cxx::__block_deque_runs(__first1, __last1, [&__first2](_Ptr __p, _Ptr __q) {
+      while (__p != __q) {
+        const ptrdiff_t __clen = std::min(__q - __p, __first2._M_last - __first2._M_cur);
+        if (!std::equal(__p, __p + __clen, __first2._M_cur))
+          return false;
+        __p += __clen;
+        __first2 += __clen;
+      }
+      return true;
+    });
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#include <ext/block_deque.tcc>
+
+#endif // C++11
+
+#endif // _BLOCK_DEQUE_H
@@ -0,0 +1,449 @@
+// Deque with a configurable node size -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/block_deque.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/block_deque.h}
+ */
+
+#ifndef _BLOCK_DEQUE_TCC
+#define _BLOCK_DEQUE_TCC 1
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  _Block_deque_base<_Tp, _Nm, _Alloc>::
+  _M_initialize_map(size_t __num_elements) {
+    const size_t __num_nodes = __num_elements / _Nm + 1;
+    const size_t __map_size = std::max(size_t(_S_initial_map_size), __num_nodes + 2);
+    _Map_pointer __map = _M_allocate_map(__map_size);
+    // Nodes in the middle of the map leave room to grow either way.
+    _Map_pointer __nstart = __map + (__map_size - __num_nodes) / 2;
+    _Map_pointer __nfinish = __nstart + __num_nodes;
+    try {
+      _M_create_nodes(__nstart, __nfinish);
+    } catch (...) {
+      _M_deallocate_map(__map, __map_size);
+      throw;
+    }
+    _M_impl._M_map = __map;
+    _M_impl._M_map_size = __map_size;
+    _M_impl._M_start._M_set_node(__nstart);
+    _M_impl._M_finish._M_set_node(__nfinish - 1);
+    _M_impl._M_start._M_cur = _M_impl._M_start._M_first;
+    _M_impl._M_finish._M_cur = _M_impl._M_finish._M_first + __num_elements % _Nm;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  block_deque<_Tp, _Nm, _Alloc>&
+  block_deque<_Tp, _Nm, _Alloc>::
+  operator=(const block_deque& __x) {
+    if (&__x == this)
+      return *this;
+    if (_Alloc_traits::_S_propagate_on_copy_assign() && !_Alloc_traits::_S_always_equal() &&
+        _M_get_Tp_allocator() != __x._M_get_Tp_allocator()) {
+      // The nodes must go back to the allocator they came from.
+      block_deque __tmp(std::move(*this));
+      std::__alloc_on_copy(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+    } else if (_Alloc_traits::_S_propagate_on_copy_assign())
+      std::__alloc_on_copy(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+    assign(__x.begin(), __x.end());
+    return *this;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  block_deque<_Tp, _Nm, _Alloc>&
+  block_deque<_Tp, _Nm, _Alloc>::
+  operator=(block_deque&& __x) noexcept(_Alloc_traits::_S_nothrow_move()) {
+    if (&__x == this)
+      return *this;
+    if (_Alloc_traits::_S_propagate_on_move_assign() || _M_get_Tp_allocator() == __x._M_get_Tp_allocator()) {
+      block_deque __tmp(std::move(*this));
+      _M_impl._M_swap_data(__x._M_impl);
+      std::__alloc_on_move(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+    } else {
+      assign(std::make_move_iterator(__x.begin()), std::make_move_iterator(__x.end()));
+      __x.clear();
+    }
+    return *this;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename _InputIterator, typename>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  assign(_InputIterator __first, _InputIterator __last) {
+    iterator __cur = begin();
+    for (; __first != __last && __cur != end(); ++__cur, (void)++__first)
+      *__cur = *__first;
+    if (__first == __last)
+      _M_erase_at_end(__cur);
+    else
+      _M_range_append(__first, __last, std::__iterator_category(__first));
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  assign(size_type __n, const value_type& __value) {
+    const size_type __len = size();
+    if (__n > __len) {
+      std::fill(begin(), end(), __value);
+      _M_fill_append(__n - __len, __value);
+    } else {
+      // __value may be one of the elements erased.
+      std::fill(begin(), begin() + difference_type(__n), __value);
+      _M_erase_at_end(begin() + difference_type(__n));
+    }
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  shrink_to_fit() noexcept {
+    if (!_M_impl._M_map)
+      return;
+    const size_type __spare = (_M_impl._M_start._M_cur - _M_impl._M_start._M_first) +
+                              (_M_impl._M_finish._M_last - _M_impl._M_finish._M_cur) - 1;
+    if (!empty() && __spare < _Nm)
+      return;
+    try {
+      block_deque __tmp(std::make_move_iterator(begin()), std::make_move_iterator(end()), get_allocator());
+      __tmp.swap(*this);
+    } catch (...) {
+    }
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  typename block_deque<_Tp, _Nm, _Alloc>::reference
+  block_deque<_Tp, _Nm, _Alloc>::
+  emplace_front(_Args&&... __args) {
+    iterator& __start = _M_impl._M_start;
+    if (__start._M_cur && __start._M_cur != __start._M_first) {
+      _Alloc_traits::construct(_M_impl, __start._M_cur - 1, std::forward<_Args>(__args)...);
+      --__start._M_cur;
+    } else {
+      iterator __new_start = _M_reserve_elements_at_front(1);
+      try {
+        _Alloc_traits::construct(_M_impl, __new_start._M_cur, std::forward<_Args>(__args)...);
+      } catch (...) {
+        this->_M_destroy_nodes(__new_start._M_node, __start._M_node);
+        throw;
+      }
+      __start = __new_start;
+    }
+    return front();
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  typename block_deque<_Tp, _Nm, _Alloc>::reference
+  block_deque<_Tp, _Nm, _Alloc>::
+  emplace_back(_Args&&... __args) {
+    iterator& __finish = _M_impl._M_finish;
+    // _M_finish always points into a node, so the last slot of a node is
+    // only filled once the next node exists.
+    if (__finish._M_cur && __finish._M_cur != __finish._M_last - 1) {
+      _Alloc_traits::construct(_M_impl, __finish._M_cur, std::forward<_Args>(__args)...);
+      ++__finish._M_cur;
+    } else {
+      iterator __new_finish = _M_reserve_elements_at_back(1);
+      try {
+        _Alloc_traits::construct(_M_impl, __finish._M_cur, std::forward<_Args>(__args)...);
+      } catch (...) {
+        this->_M_destroy_nodes(__finish._M_node + 1, __new_finish._M_node + 1);
+        throw;
+      }
+      __finish = __new_finish;
+    }
+    return back();
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  typename block_deque<_Tp, _Nm, _Alloc>::iterator
+  block_deque<_Tp, _Nm, _Alloc>::
+  emplace(const_iterator __position, _Args&&... __args) {
+    if (__position == cbegin()) {
+      emplace_front(std::forward<_Args>(__args)...);
+      return begin();
+    }
+    if (__position == cend()) {
+      emplace_back(std::forward<_Args>(__args)...);
+      return end() - 1;
+    }
+
+    // The arguments may refer to elements that are about to move.
+    value_type __x_copy(std::forward<_Args>(__args)...);
+    const difference_type __index = __position - cbegin();
+    if (size_type(__index) < size() / 2) {
+      emplace_front(std::move(front()));
+      std::move(begin() + 2, begin() + (__index + 1), begin() + 1);
+    } else {
+      emplace_back(std::move(back()));
+      std::move_backward(begin() + __index, end() - 2, end() - 1);
+    }
+    iterator __pos = begin() + __index;
+    *__pos = std::move(__x_copy);
+    return __pos;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  typename block_deque<_Tp, _Nm, _Alloc>::iterator
+  block_deque<_Tp, _Nm, _Alloc>::
+  insert(const_iterator __position, size_type __n, const value_type& __x) {
+    const difference_type __offset = __position - cbegin();
+    if (__n == 0)
+      return begin() + __offset;
+    // The new elements are built at the end nearer __position, where no
+    // element moves, so __x may be one of the elements.
+    const bool __at_front = size_type(__offset) < size() / 2;
+    if (__at_front)
+      _M_fill_prepend(__n, __x);
+    else
+      _M_fill_append(__n, __x);
+    return _M_rotate_into_place(__offset, __n, __at_front);
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  typename block_deque<_Tp, _Nm, _Alloc>::iterator
+  block_deque<_Tp, _Nm, _Alloc>::
+  erase(const_iterator __first, const_iterator __last) {
+    const difference_type __n = __last - __first;
+    const difference_type __elems_before = __first - cbegin();
+    if (__n == 0)
+      return begin() + __elems_before;
+    if (__n == difference_type(size())) {
+      clear();
+      return end();
+    }
+    if (size_type(__elems_before) < (size() - __n) / 2) {
+      std::move_backward(begin(), begin() + __elems_before, begin() + (__elems_before + __n));
+      _M_erase_at_begin(begin() + __n);
+    } else {
+      std::move(begin() + (__elems_before + __n), end(), begin() + __elems_before);
+      _M_erase_at_end(end() - __n);
+    }
+    return begin() + __elems_before;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_new_elements_at_front(size_type __new_elems) {
+    if (max_size() - size() < __new_elems)
+      std::__throw_length_error(__N("block_deque::_M_new_elements_at_front"));
+    const size_type __new_nodes = (__new_elems + _Nm - 1) / _Nm;
+    _M_reserve_map_at_front(__new_nodes);
+    this->_M_create_nodes(_M_impl._M_start._M_node - __new_nodes, _M_impl._M_start._M_node);
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_new_elements_at_back(size_type __new_elems) {
+    if (max_size() - size() < __new_elems)
+      std::__throw_length_error(__N("block_deque::_M_new_elements_at_back"));
+    const size_type __new_nodes = (__new_elems + _Nm - 1) / _Nm;
+    _M_reserve_map_at_back(__new_nodes);
+    this->_M_create_nodes(_M_impl._M_finish._M_node + 1, _M_impl._M_finish._M_node + 1 + __new_nodes);
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_reallocate_map(size_type __nodes_to_add, bool __add_at_front) {
+    const size_type __old_num_nodes = _M_impl._M_finish._M_node - _M_impl._M_start._M_node + 1;
+    const size_type __new_num_nodes = __old_num_nodes + __nodes_to_add;
+
+    _Map_pointer __new_nstart;
+    if (_M_impl._M_map_size > 2 * __new_num_nodes) {
+      // Recentre the nodes in the map that is there.
+      __new_nstart = _M_impl._M_map + (_M_impl._M_map_size - __new_num_nodes) / 2 + (__add_at_front ? __nodes_to_add : 0);
+      if (__new_nstart < _M_impl._M_start._M_node)
+        std::copy(_M_impl._M_start._M_node, _M_impl._M_finish._M_node + 1, __new_nstart);
+      else
+        std::copy_backward(_M_impl._M_start._M_node, _M_impl._M_finish._M_node + 1, __new_nstart + __old_num_nodes);
+    } else {
+      const size_type __new_map_size = _M_impl._M_map_size + std::max(_M_impl._M_map_size, __nodes_to_add) + 2;
+      _Map_pointer __new_map = this->_M_allocate_map(__new_map_size);
+      __new_nstart = __new_map + (__new_map_size - __new_num_nodes) / 2 + (__add_at_front ? __nodes_to_add : 0);
+      std::copy(_M_impl._M_start._M_node, _M_impl._M_finish._M_node + 1, __new_nstart);
+      this->_M_deallocate_map(_M_impl._M_map, _M_impl._M_map_size);
+      _M_impl._M_map = __new_map;
+      _M_impl._M_map_size = __new_map_size;
+    }
+
+    _M_impl._M_start._M_set_node(__new_nstart);
+    _M_impl._M_finish._M_set_node(__new_nstart + __old_num_nodes - 1);
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_default_append(size_type __n) {
+    if (__n == 0)
+      return;
+    iterator __new_finish = _M_reserve_elements_at_back(__n);
+    try {
+      std::__uninitialized_default_a(_M_impl._M_finish, __new_finish, _M_get_Tp_allocator());
+    } catch (...) {
+      this->_M_destroy_nodes(_M_impl._M_finish._M_node + 1, __new_finish._M_node + 1);
+      throw;
+    }
+    _M_impl._M_finish = __new_finish;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_fill_append(size_type __n, const value_type& __x) {
+    if (__n == 0)
+      return;
+    iterator __new_finish = _M_reserve_elements_at_back(__n);
+    try {
+      std::__uninitialized_fill_a(_M_impl._M_finish, __new_finish, __x, _M_get_Tp_allocator());
+    } catch (...) {
+      this->_M_destroy_nodes(_M_impl._M_finish._M_node + 1, __new_finish._M_node + 1);
+      throw;
+    }
+    _M_impl._M_finish = __new_finish;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_fill_prepend(size_type __n, const value_type& __x) {
+    iterator __new_start = _M_reserve_elements_at_front(__n);
+    try {
+      std::__uninitialized_fill_a(__new_start, _M_impl._M_start, __x, _M_get_Tp_allocator());
+    } catch (...) {
+      this->_M_destroy_nodes(__new_start._M_node, _M_impl._M_start._M_node);
+      throw;
+    }
+    _M_impl._M_start = __new_start;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename _InputIterator>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_range_append(_InputIterator __first, _InputIterator __last, std::input_iterator_tag) {
+    size_type __n = 0;
+    try {
+      for (; __first != __last; ++__first, (void)++__n)
+        emplace_back(*__first);
+    } catch (...) {
+      _M_erase_at_end(end() - difference_type(__n));
+      throw;
+    }
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename _ForwardIterator>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_range_append(_ForwardIterator __first, _ForwardIterator __last, std::forward_iterator_tag) {
+    const size_type __n = std::distance(__first, __last);
+    if (__n == 0)
+      return;
+    iterator __new_finish = _M_reserve_elements_at_back(__n);
+    try {
+      std::__uninitialized_copy_a(__first, __last, _M_impl._M_finish, _M_get_Tp_allocator());
+    } catch (...) {
+      this->_M_destroy_nodes(_M_impl._M_finish._M_node + 1, __new_finish._M_node + 1);
+      throw;
+    }
+    _M_impl._M_finish = __new_finish;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename _ForwardIterator>
+  void
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_range_prepend(_ForwardIterator __first, _ForwardIterator __last, size_type __n) {
+    iterator __new_start = _M_reserve_elements_at_front(__n);
+    try {
+      std::__uninitialized_copy_a(__first, __last, __new_start, _M_get_Tp_allocator());
+    } catch (...) {
+      this->_M_destroy_nodes(__new_start._M_node, _M_impl._M_start._M_node);
+      throw;
+    }
+    _M_impl._M_start = __new_start;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename _InputIterator>
+  typename block_deque<_Tp, _Nm, _Alloc>::iterator
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_range_insert(const_iterator __position, _InputIterator __first, _InputIterator __last,
+                  std::input_iterator_tag) {
+    const difference_type __offset = __position - cbegin();
+    if (__position == cend()) {
+      _M_range_append(__first, __last, std::input_iterator_tag());
+      return begin() + __offset;
+    }
+    // Count the elements before making room for them.
+    block_deque __tmp(__first, __last, get_allocator());
+    return _M_range_insert(begin() + __offset, std::make_move_iterator(__tmp.begin()),
+                           std::make_move_iterator(__tmp.end()), std::forward_iterator_tag());
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename _ForwardIterator>
+  typename block_deque<_Tp, _Nm, _Alloc>::iterator
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_range_insert(const_iterator __position, _ForwardIterator __first, _ForwardIterator __last,
+                  std::forward_iterator_tag) {
+    const difference_type __offset = __position - cbegin();
+    const size_type __n = std::distance(__first, __last);
+    if (__n == 0)
+      return begin() + __offset;
+    const bool __at_front = size_type(__offset) < size() / 2;
+    if (__at_front)
+      _M_range_prepend(__first, __last, __n);
+    else
+      _M_range_append(__first, __last, std::forward_iterator_tag());
+    return _M_rotate_into_place(__offset, __n, __at_front);
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  typename block_deque<_Tp, _Nm, _Alloc>::iterator
+  block_deque<_Tp, _Nm, _Alloc>::
+  _M_rotate_into_place(difference_type __offset, size_type __n, bool __at_front) {
+    const difference_type __len = __n;
+    if (__at_front)
+      std::rotate(begin(), begin() + __len, begin() + (__len + __offset));
+    else
+      std::rotate(begin() + __offset, end() - __len, end());
+    return begin() + __offset;
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // _BLOCK_DEQUE_TCC
@@ -0,0 +1,605 @@
+// Versatile string base with a compact inline buffer -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/compact_string_base.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/vstring.h}
+ */
+
+#ifndef _COMPACT_STRING_BASE_H
+#define _COMPACT_STRING_BASE_H 1
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
+{
+_GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  A __versa_string base that keeps short strings in the whole object.
+   *
+   *  A long string is the usual pointer, length and capacity, three words
+   *  with nothing to spare for a separate inline buffer.  A short string
+   *  overlays its characters on all three words, as libc++ does, which
+   *  fits 23 chars on LP64 where __sso_string_base fits 15 in a 32 byte
+   *  object.
+   *
+   *  The two are told apart by the high bit of the last byte of the
+   *  object.  For a long string that byte belongs to the capacity word,
+   *  which carries the bit and so limits the capacity to 2^(N-8).  For
+   *  a short string the last character holds the number of unused
+   *  characters, so it is zero, and doubles as the terminator, exactly
+   *  when the buffer is full.
+   *
+   *  Neither representation points into the object itself, so moving and
+   *  swapping are plain copies of the representation.
+  */
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    class __compact_string_base
+    : protected __vstring_utility<_CharT, _Traits, _Alloc>
+    {
+    public:
+      typedef _Traits					    traits_type;
+      typedef typename _Traits::char_type		    value_type;
+
+      typedef __vstring_utility<_CharT, _Traits, _Alloc>    _Util_Base;
+      typedef typename _Util_Base::_CharT_alloc_type        _CharT_alloc_type;
+      typedef typename _CharT_alloc_type::size_type	    size_type;
+
+    private:
+      struct _Long
+      {
+	_CharT*		_M_p;
+	size_type	_M_size;
+	size_type	_M_cap;
+      };
+
+      enum { _S_local_capacity = sizeof(_Long) / sizeof(_CharT) - 1 };
+
+#if __cplusplus >= 201103L
+      static_assert(sizeof(_Long) % sizeof(_CharT) == 0,
+		    "__compact_string_base character size must divide "
+		    "the size of the long representation");
+#endif
+
+      // Bit of the capacity word that lands in the last byte.
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      static const size_type _S_long_flag = 0x80;
+      static const int _S_cap_shift = 8;
+#else
+      static const size_type _S_long_flag
+	= size_type(0x80) << (__CHAR_BIT__ * (sizeof(size_type) - 1));
+      static const int _S_cap_shift = 0;
+#endif
+
+      union _Rep
+      {
+	_Long		_M_long;
+	_CharT		_M_local[_S_local_capacity + 1];
+	unsigned char	_M_bytes[sizeof(_Long)];
+      };
+
+      struct _Rep_hider
+      : public _CharT_alloc_type
+      {
+	_Rep_hider()
+	: _CharT_alloc_type() { }
+
+	_Rep_hider(const _CharT_alloc_type& __a)
+	: _CharT_alloc_type(__a) { }
+
+	_Rep _M_rep;
+      };
+
+      // Data Members:
+      _Rep_hider _M_dataplus;
+
+      bool
+      _M_is_local() const
+      { return !(_M_dataplus._M_rep._M_bytes[sizeof(_Long) - 1] & 0x80); }
+
+      size_type
+      _M_allocated_capacity() const
+      {
+	return (_M_dataplus._M_rep._M_long._M_cap & ~_S_long_flag)
+	       >> _S_cap_shift;
+      }
+
+      void
+      _M_set_long(_CharT* __p, size_type __capacity, size_type __length)
+      {
+	_Long& __l = _M_dataplus._M_rep._M_long;
+	__l._M_p = __p;
+	__l._M_size = __length;
+	__l._M_cap = (__capacity << _S_cap_shift) | _S_long_flag;
+      }
+
+      void
+      _M_set_local_length(size_type __n)
+      {
+	_CharT* __local = _M_dataplus._M_rep._M_local;
+	traits_type::assign(__local[__n], _CharT());
+	__local[_S_local_capacity] = _CharT(_S_local_capacity - __n);
+      }
+
+      // Create & Destroy
+      _CharT*
+      _M_create(size_type&, size_type);
+
+      void
+      _M_dispose()
+      {
+	if (!_M_is_local())
+	  _M_destroy(_M_dataplus._M_rep._M_long._M_p,
+		     _M_allocated_capacity());
+      }
+
+      void
+      _M_destroy(_CharT* __p, size_type __size) throw()
+      { _M_get_allocator().deallocate(__p, __size + 1); }
+
+      // _M_construct_aux is used to implement the 21.3.1 para 15 which
+      // requires special behaviour if _InIterator is an integral type
+      template<typename _InIterator>
+        void
+        _M_construct_aux(_InIterator __beg, _InIterator __end,
+			 std::__false_type)
+	{
+          typedef typename iterator_traits<_InIterator>::iterator_category _Tag;
+          _M_construct(__beg, __end, _Tag());
+	}
+
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 438. Ambiguity in the "do the right thing" clause
+      template<typename _Integer>
+        void
+        _M_construct_aux(_Integer __beg, _Integer __end, std::__true_type)
+	{ _M_construct_aux_2(static_cast<size_type>(__beg), __end); }
+
+      void
+      _M_construct_aux_2(size_type __req, _CharT __c)
+      { _M_construct(__req, __c); }
+
+      template<typename _InIterator>
+        void
+        _M_construct(_InIterator __beg, _InIterator __end)
+	{
+	  typedef typename std::__is_integer<_InIterator>::__type _Integral;
+	  _M_construct_aux(__beg, __end, _Integral());
+        }
+
+      // For Input Iterators, used in istreambuf_iterators, etc.
+      template<typename _InIterator>
+        void
+        _M_construct(_InIterator __beg, _InIterator __end,
+		     std::input_iterator_tag);
+
+      // For forward_iterators up to random_access_iterators, used for
+      // string::iterator, _CharT*, etc.
+      template<typename _FwdIterator>
+        void
+        _M_construct(_FwdIterator __beg, _FwdIterator __end,
+		     std::forward_iterator_tag);
+
+      void
+      _M_construct(size_type __req, _CharT __c);
+
+    public:
+      size_type
+      _M_max_size() const
+      {
+	const size_type __max = (_M_get_allocator().max_size() - 1) / 2;
+	const size_type __cap_max = (~_S_long_flag >> _S_cap_shift) - 1;
+	return __max < __cap_max ? __max : __cap_max;
+      }
+
+      _CharT*
+      _M_data() const
+      {
+	return _M_is_local()
+	       ? const_cast<_CharT*>(_M_dataplus._M_rep._M_local)
+	       : _M_dataplus._M_rep._M_long._M_p;
+      }
+
+      size_type
+      _M_length() const
+      {
+	return _M_is_local()
+	       ? size_type(_S_local_capacity)
+		 - size_type(_M_dataplus._M_rep._M_local[_S_local_capacity])
+	       : _M_dataplus._M_rep._M_long._M_size;
+      }
+
+      size_type
+      _M_capacity() const
+      {
+	return _M_is_local() ? size_type(_S_local_capacity)
+	                     : _M_allocated_capacity();
+      }
+
+      bool
+      _M_is_shared() const
+      { return false; }
+
+      void
+      _M_set_leaked() { }
+
+      void
+      _M_leak() { }
+
+      void
+      _M_set_length(size_type __n)
+      {
+	if (_M_is_local())
+	  _M_set_local_length(__n);
+	else
+	  {
+	    _M_dataplus._M_rep._M_long._M_size = __n;
+	    traits_type::assign(_M_dataplus._M_rep._M_long._M_p[__n],
+				_CharT());
+	  }
+      }
+
+      __compact_string_base()
+      : _M_dataplus()
+      { _M_set_local_length(0); }
+
+      __compact_string_base(const _Alloc& __a);
+
+      __compact_string_base(const __compact_string_base& __rcs);
+
+#if __cplusplus >= 201103L
+      __compact_string_base(__compact_string_base&& __rcs);
+#endif
+
+      __compact_string_base(size_type __n, _CharT __c, const _Alloc& __a);
+
+      template<typename _InputIterator>
+        __compact_string_base(_InputIterator __beg, _InputIterator __end,
+			      const _Alloc& __a);
+
+      ~__compact_string_base()
+      { _M_dispose(); }
+
+      _CharT_alloc_type&
+      _M_get_allocator()
+      { return _M_dataplus; }
+
+      const _CharT_alloc_type&
+      _M_get_allocator() const
+      { return _M_dataplus; }
+
+      void
+      _M_swap(__compact_string_base& __rcs);
+
+      void
+      _M_assign(const __compact_string_base& __rcs);
+
+      void
+      _M_reserve(size_type __res);
+
+      void
+      _M_mutate(size_type __pos, size_type __len1, const _CharT* __s,
+		size_type __len2);
+
+      void
+      _M_erase(size_type __pos, size_type __n);
+
+      void
+      _M_clear()
+      { _M_set_length(0); }
+
+      bool
+      _M_compare(const __compact_string_base&) const
+      { return false; }
+    };
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    const typename __compact_string_base<_CharT, _Traits, _Alloc>::size_type
+    __compact_string_base<_CharT, _Traits, _Alloc>::_S_long_flag;
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    const int
+    __compact_string_base<_CharT, _Traits, _Alloc>::_S_cap_shift;
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    _M_swap(__compact_string_base& __rcs)
+    {
+      if (this == &__rcs)
+	return;
+
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 431. Swapping containers with unequal allocators.
+      std::__alloc_swap<_CharT_alloc_type>::_S_do_it(_M_get_allocator(),
+						     __rcs._M_get_allocator());
+
+      const _Rep __tmp = _M_dataplus._M_rep;
+      _M_dataplus._M_rep = __rcs._M_dataplus._M_rep;
+      __rcs._M_dataplus._M_rep = __tmp;
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    _CharT*
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    _M_create(size_type& __capacity, size_type __old_capacity)
+    {
+      // _GLIBCXX_RESOLVE_LIB_DEFECTS
+      // 83.  String::npos vs. string::max_size()
+      if (__capacity > _M_max_size())
+	std::__throw_length_error(__N("__compact_string_base::_M_create"));
+
+      // The below implements an exponential growth policy, necessary to
+      // meet amortized linear time requirements of the library: see
+      // http://gcc.gnu.org/ml/libstdc++/2001-07/msg00085.html.
+      if (__capacity > __old_capacity && __capacity < 2 * __old_capacity)
+	{
+	  __capacity = 2 * __old_capacity;
+	  // Never allocate a string bigger than max_size.
+	  if (__capacity > _M_max_size())
+	    __capacity = _M_max_size();
+	}
+
+      // NB: Need an array of char_type[__capacity], plus a terminating
+      // null char_type() element.
+      return _M_get_allocator().allocate(__capacity + 1);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    __compact_string_base(const _Alloc& __a)
+    : _M_dataplus(__a)
+    { _M_set_local_length(0); }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    __compact_string_base(const __compact_string_base& __rcs)
+    : _M_dataplus(__rcs._M_get_allocator())
+    {
+      _M_set_local_length(0);
+      _M_construct(__rcs._M_data(), __rcs._M_data() + __rcs._M_length());
+    }
+
+#if __cplusplus >= 201103L
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    __compact_string_base(__compact_string_base&& __rcs)
+    : _M_dataplus(__rcs._M_get_allocator())
+    {
+      _M_dataplus._M_rep = __rcs._M_dataplus._M_rep;
+      __rcs._M_set_local_length(0);
+    }
+#endif
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    __compact_string_base(size_type __n, _CharT __c, const _Alloc& __a)
+    : _M_dataplus(__a)
+    {
+      _M_set_local_length(0);
+      _M_construct(__n, __c);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    template<typename _InputIterator>
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    __compact_string_base(_InputIterator __beg, _InputIterator __end,
+			  const _Alloc& __a)
+    : _M_dataplus(__a)
+    {
+      _M_set_local_length(0);
+      _M_construct(__beg, __end);
+    }
+
+  // NB: This is the special case for Input Iterators, used in
+  // istreambuf_iterators, etc.
+  // Input Iterators have a cost structure very different from
+  // pointers, calling for a different coding style.
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    template<typename _InIterator>
+      void
+      __compact_string_base<_CharT, _Traits, _Alloc>::
+      _M_construct(_InIterator __beg, _InIterator __end,
+		   std::input_iterator_tag)
+      {
+	size_type __len = 0;
+	size_type __capacity = size_type(_S_local_capacity);
+	_CharT* __data = _M_data();
+
+	while (__beg != __end && __len < __capacity)
+	  {
+	    __data[__len++] = *__beg;
+	    ++__beg;
+	  }
+
+	try
+	  {
+	    while (__beg != __end)
+	      {
+		if (__len == __capacity)
+		  {
+		    // Allocate more space.
+		    __capacity = __len + 1;
+		    _CharT* __another = _M_create(__capacity, __len);
+		    this->_S_copy(__another, __data, __len);
+		    _M_dispose();
+		    _M_set_long(__another, __capacity, __len);
+		    __data = __another;
+		  }
+		__data[__len++] = *__beg;
+		++__beg;
+	      }
+	  }
+	catch(...)
+	  {
+	    _M_dispose();
+	    throw;
+	  }
+
+	_M_set_length(__len);
+      }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    template<typename _InIterator>
+      void
+      __compact_string_base<_CharT, _Traits, _Alloc>::
+      _M_construct(_InIterator __beg, _InIterator __end,
+		   std::forward_iterator_tag)
+      {
+	// NB: Not required, but considered best practice.
+	if (__is_null_pointer(__beg) && __beg != __end)
+	  std::__throw_logic_error(__N("__compact_string_base::"
+				       "_M_construct null not valid"));
+
+	size_type __dnew = static_cast<size_type>(std::distance(__beg, __end));
+
+	if (__dnew > size_type(_S_local_capacity))
+	  _M_set_long(_M_create(__dnew, size_type(0)), __dnew, 0);
+
+	// Check for out_of_range and length_error exceptions.
+	try
+	  { this->_S_copy_chars(_M_data(), __beg, __end); }
+	catch(...)
+	  {
+	    _M_dispose();
+	    throw;
+	  }
+
+	_M_set_length(__dnew);
+      }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    _M_construct(size_type __n, _CharT __c)
+    {
+      if (__n > size_type(_S_local_capacity))
+	_M_set_long(_M_create(__n, size_type(0)), __n, 0);
+
+      if (__n)
+	this->_S_assign(_M_data(), __n, __c);
+
+      _M_set_length(__n);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    _M_assign(const __compact_string_base& __rcs)
+    {
+      if (this != &__rcs)
+	{
+	  const size_type __rsize = __rcs._M_length();
+	  const size_type __capacity = _M_capacity();
+
+	  if (__rsize > __capacity)
+	    {
+	      size_type __new_capacity = __rsize;
+	      _CharT* __tmp = _M_create(__new_capacity, __capacity);
+	      _M_dispose();
+	      _M_set_long(__tmp, __new_capacity, 0);
+	    }
+
+	  if (__rsize)
+	    this->_S_copy(_M_data(), __rcs._M_data(), __rsize);
+
+	  _M_set_length(__rsize);
+	}
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    _M_reserve(size_type __res)
+    {
+      const size_type __length = _M_length();
+
+      // Make sure we don't shrink below the current size.
+      if (__res < __length)
+	__res = __length;
+
+      const size_type __capacity = _M_capacity();
+      if (__res != __capacity)
+	{
+	  if (__res > __capacity
+	      || __res > size_type(_S_local_capacity))
+	    {
+	      _CharT* __tmp = _M_create(__res, __capacity);
+	      this->_S_copy(__tmp, _M_data(), __length + 1);
+	      _M_dispose();
+	      _M_set_long(__tmp, __res, __length);
+	    }
+	  else if (!_M_is_local())
+	    {
+	      // The characters overwrite the pointer, so save it first.
+	      _CharT* const __p = _M_data();
+	      this->_S_copy(_M_dataplus._M_rep._M_local, __p, __length);
+	      _M_destroy(__p, __capacity);
+	      _M_set_local_length(__length);
+	    }
+	}
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    _M_mutate(size_type __pos, size_type __len1, const _CharT* __s,
+	      size_type __len2)
+    {
+      const size_type __length = _M_length();
+      const size_type __how_much = __length - __pos - __len1;
+
+      size_type __new_capacity = __length + __len2 - __len1;
+      _CharT* __r = _M_create(__new_capacity, _M_capacity());
+      _CharT* const __data = _M_data();
+
+      if (__pos)
+	this->_S_copy(__r, __data, __pos);
+      if (__s && __len2)
+	this->_S_copy(__r + __pos, __s, __len2);
+      if (__how_much)
+	this->_S_copy(__r + __pos + __len2,
+		      __data + __pos + __len1, __how_much);
+
+      _M_dispose();
+      _M_set_long(__r, __new_capacity, __length);
+    }
+
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    void
+    __compact_string_base<_CharT, _Traits, _Alloc>::
+    _M_erase(size_type __pos, size_type __n)
+    {
+      const size_type __how_much = _M_length() - __pos - __n;
+      _CharT* const __data = _M_data();
+
+      if (__how_much && __n)
+	this->_S_move(__data + __pos, __data + __pos + __n, __how_much);
+
+      _M_set_length(_M_length() - __n);
+    }
+
+_GLIBCXX_END_NAMESPACE_VERSION
+} // namespace
+
+#endif /* _COMPACT_STRING_BASE_H */
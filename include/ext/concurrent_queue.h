@@ -0,0 +1,714 @@
+// Bounded lock-free queues -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/concurrent_queue.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _CONCURRENT_QUEUE_H
+#define _CONCURRENT_QUEUE_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <atomic>
+#include <bits/atomic_futex.h>
+#include <bits/gthr.h>
+#include <bits/stl_algobase.h>
+#include <bits/stl_iterator_base_funcs.h>
+#include <ext/alloc_traits.h>
+#include <memory>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  Lets threads sleep until another thread reports progress on a
+   *  queue, through a futex where the library has them.
+   *
+   *  A waiter registers in _M_waiters and reads the epoch, then checks
+   *  its condition once more before sleeping on the epoch.  A notifier
+   *  publishes its change, and bumps the epoch and wakes sleepers only
+   *  if someone is registered.  The seq_cst fences on both sides make
+   *  sure that either the notifier sees the waiter or the waiter sees
+   *  the change, so wakeups are not lost and an uncontended notify costs
+   *  a fence and a load.
+   *
+   *  Without futexes the waiter yields instead of sleeping.
+  */
+#if defined(_GLIBCXX_HAS_GTHREADS) && defined(_GLIBCXX_HAVE_LINUX_FUTEX) && ATOMIC_INT_LOCK_FREE > 1
+  struct _Queue_event : std::__atomic_futex_unsigned_base {
+#else
+  struct _Queue_event {
+#endif
+    std::atomic<unsigned> _M_epoch;
+    std::atomic<unsigned> _M_waiters;
+
+    _Queue_event() noexcept
+        : _M_epoch(0), _M_waiters(0) {}
+
+    // Registers a waiter; returns the epoch to hand to _M_wait.
+    unsigned
+    _M_prepare() noexcept {
+      _M_waiters.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return _M_epoch.load(std::memory_order_acquire);
+    }
+
+    // Sleeps unless the epoch has moved past __e, then unregisters.
+    void
+    _M_wait(unsigned __e) noexcept {
+#if defined(_GLIBCXX_HAS_GTHREADS) && defined(_GLIBCXX_HAVE_LINUX_FUTEX) && ATOMIC_INT_LOCK_FREE > 1
+      if (_M_epoch.load(std::memory_order_acquire) == __e)
+        _M_futex_wait_until((unsigned*)(void*)&_M_epoch, __e, false, {}, {});
+#else
+      (void)__e;
+      _S_yield();
+#endif
+      _M_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Unregisters a waiter whose condition held after _M_prepare.
+    void
+    _M_cancel() noexcept { _M_waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+    void
+    _M_notify() noexcept {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (_M_waiters.load(std::memory_order_relaxed)) {
+        _M_epoch.fetch_add(1, std::memory_order_release);
+#if defined(_GLIBCXX_HAS_GTHREADS) && defined(_GLIBCXX_HAVE_LINUX_FUTEX) && ATOMIC_INT_LOCK_FREE > 1
+        _M_futex_notify_all((unsigned*)(void*)&_M_epoch);
+#endif
+      }
+    }
+
+    static void
+    _S_yield() noexcept {
+#ifdef _GLIBCXX_USE_SCHED_YIELD
+      __gthread_yield();
+#endif
+    }
+
+    static void
+    _S_pause() noexcept {
+#if defined(__i386__) || defined(__x86_64__)
+      __builtin_ia32_pause();
+#endif
+    }
+  };
+
+  /// Common parts of the ring buffer queues: sizing and blocking loops.
+  template <bool _Blocking>
+  struct _Ring_queue_base {
+    // Keeps the indices written by different threads on separate lines.
+    static constexpr size_t _S_cache_line = 64;
+
+    // Failed attempts before a blocking operation sleeps or yields.
+    static constexpr unsigned _S_spin_count = 64;
+
+    static size_t
+    _S_round_capacity(size_t __n) noexcept {
+      size_t __cap = 2;
+      while (__cap < __n)
+        __cap *= 2;
+      return __cap;
+    }
+
+    _Queue_event _M_not_full;
+    _Queue_event _M_not_empty;
+
+    void
+    _M_notify(_Queue_event& __ev) noexcept {
+      if (_Blocking)
+        __ev._M_notify();
+    }
+
+    // Retries __try_op until it succeeds, spinning briefly, then sleeping
+    // on __ev if _Blocking and yielding otherwise.
+    template <typename _TryOp>
+    void
+    _M_wait_for(_Queue_event& __ev, _TryOp __try_op) {
+      for (unsigned __n = 0;; ++__n) {
+        if (__try_op())
+          return;
+        if (__n < _S_spin_count)
+          _Queue_event::_S_pause();
+        else if (!_Blocking)
+          _Queue_event::_S_yield();
+        else {
+          const unsigned __e = __ev._M_prepare();
+          bool __done;
+          try {
+            __done = __try_op();
+          } catch (...) {
+            __ev._M_cancel();
+            throw;
+          }
+          if (__done) {
+            __ev._M_cancel();
+            return;
+          }
+          __ev._M_wait(__e);
+        }
+      }
+    }
+  };
+
+  template <bool _Blocking>
+  constexpr size_t _Ring_queue_base<_Blocking>::_S_cache_line;
+
+  template <bool _Blocking>
+  constexpr unsigned _Ring_queue_base<_Blocking>::_S_spin_count;
+
+  /**
+   *  @brief A bounded single-producer, single-consumer queue.
+   *
+   *  @tparam _Tp  Type of element.
+   *  @tparam _Blocking  Whether push() and pop() sleep when they cannot
+   *                     proceed, rather than spin and yield.
+   *  @tparam _Alloc  Allocator type.
+   *
+   *  A ring buffer whose capacity is rounded up to a power of two.  One
+   *  thread may push and one other thread may pop concurrently; each
+   *  owns one index, on its own cache line, and caches the other's, so
+   *  try_push() and try_pop() are wait-free and usually touch no line
+   *  the other thread writes.
+   *
+   *  The non-blocking operations never block.  When _Blocking is true
+   *  every successful operation also checks for sleeping threads, which
+   *  costs a full fence; leave it false when the queue is only polled.
+  */
+  template <typename _Tp, bool _Blocking = false, typename _Alloc = std::allocator<_Tp>>
+  class spsc_queue : private _Ring_queue_base<_Blocking> {
+    typedef _Ring_queue_base<_Blocking> _Base;
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Tp>::other _Tp_alloc_type;
+    typedef __alloc_traits<_Tp_alloc_type> _Alloc_traits;
+
+    static_assert(std::is_pointer<typename _Alloc_traits::pointer>::value,
+                  "__gnu_cxx::spsc_queue requires an allocator with raw pointers");
+
+    using _Base::_S_cache_line;
+
+  public:
+    typedef _Tp value_type;
+    typedef size_t size_type;
+    typedef _Alloc allocator_type;
+
+    /// Creates an empty queue with room for at least @a __capacity elements.
+    explicit spsc_queue(size_type __capacity, const allocator_type& __a = allocator_type())
+        : _M_impl(_Tp_alloc_type(__a), _Base::_S_round_capacity(__capacity)) {}
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() noexcept {
+      for (size_t __h = _M_head.load(std::memory_order_relaxed),
+                  __t = _M_tail.load(std::memory_order_relaxed);
+           __h != __t; ++__h)
+        _Alloc_traits::destroy(_M_impl, _M_slot(__h));
+      _Alloc_traits::deallocate(_M_impl, _M_impl._M_buf, _M_impl._M_mask + 1);
+    }
+
+    size_type
+    capacity() const noexcept { return _M_impl._M_mask + 1; }
+
+    /// Number of elements; only a snapshot unless called by the producer
+    /// or the consumer.
+    size_type
+    size() const noexcept { return _M_tail.load(std::memory_order_acquire) - _M_head.load(std::memory_order_acquire); }
+
+    bool
+    empty() const noexcept { return size() == 0; }
+
+    allocator_type
+    get_allocator() const noexcept { return allocator_type(_M_impl); }
+
+    // producer side
+
+    /// Constructs an element at the back if there is room; returns
+    /// whether it did.  The arguments are untouched when it did not.
+    template <typename... _Args>
+    bool
+    try_emplace(_Args&&... __args) {
+      const size_t __t = _M_tail.load(std::memory_order_relaxed);
+      if (__t - _M_head_cache == capacity()) {
+        _M_head_cache = _M_head.load(std::memory_order_acquire);
+        if (__t - _M_head_cache == capacity())
+          return false;
+      }
+      _Alloc_traits::construct(_M_impl, _M_slot(__t), std::forward<_Args>(__args)...);
+      _M_tail.store(__t + 1, std::memory_order_release);
+      this->_M_notify(this->_M_not_empty);
+      return true;
+    }
+
+    bool
+    try_push(const value_type& __x) { return try_emplace(__x); }
+
+    bool
+    try_push(value_type&& __x) { return try_emplace(std::move(__x)); }
+
+    /// Waits for room, then constructs an element at the back.
+    template <typename... _Args>
+    void
+    emplace(_Args&&... __args) {
+      // Only the last, successful attempt uses the arguments.
+      this->_M_wait_for(this->_M_not_full, [&] { return try_emplace(std::forward<_Args>(__args)...); });
+    }
+
+    void
+    push(const value_type& __x) { emplace(__x); }
+
+    void
+    push(value_type&& __x) { emplace(std::move(__x)); }
+
+    /// Copies up to @a __n elements from @a __first into the queue with a
+    /// single update of the tail; returns how many fitted.
+    template <typename _InputIterator>
+    size_type
+    push_n(_InputIterator __first, size_type __n) {
+      const size_t __t = _M_tail.load(std::memory_order_relaxed);
+      if (__n > capacity() - (__t - _M_head_cache)) {
+        _M_head_cache = _M_head.load(std::memory_order_acquire);
+        __n = std::min(__n, capacity() - (__t - _M_head_cache));
+      }
+      size_t __i = 0;
+      try {
+        for (; __i < __n; ++__i, ++__first)
+          _Alloc_traits::construct(_M_impl, _M_slot(__t + __i), *__first);
+      } catch (...) {
+        _M_publish_tail(__t + __i);
+        throw;
+      }
+      _M_publish_tail(__t + __n);
+      return __n;
+    }
+
+    // consumer side
+
+    /// Moves the front element into @a __x and removes it if the queue is
+    /// not empty; returns whether it did.
+    bool
+    try_pop(value_type& __x) {
+      const size_t __h = _M_head.load(std::memory_order_relaxed);
+      if (__h == _M_tail_cache) {
+        _M_tail_cache = _M_tail.load(std::memory_order_acquire);
+        if (__h == _M_tail_cache)
+          return false;
+      }
+      _Tp* __p = _M_slot(__h);
+      __x = std::move(*__p);
+      _Alloc_traits::destroy(_M_impl, __p);
+      _M_head.store(__h + 1, std::memory_order_release);
+      this->_M_notify(this->_M_not_full);
+      return true;
+    }
+
+    /// Waits for an element, then moves it into @a __x.
+    void
+    pop(value_type& __x) {
+      this->_M_wait_for(this->_M_not_empty, [&] { return try_pop(__x); });
+    }
+
+    /// Moves up to @a __n elements to @a __out with a single update of
+    /// the head; returns how many there were.
+    template <typename _OutputIterator>
+    size_type
+    pop_n(_OutputIterator __out, size_type __n) {
+      const size_t __h = _M_head.load(std::memory_order_relaxed);
+      if (__n > _M_tail_cache - __h) {
+        _M_tail_cache = _M_tail.load(std::memory_order_acquire);
+        __n = std::min(__n, size_type(_M_tail_cache - __h));
+      }
+      size_t __i = 0;
+      try {
+        for (; __i < __n; ++__i, ++__out) {
+          _Tp* __p = _M_slot(__h + __i);
+          *__out = std::move(*__p);
+          _Alloc_traits::destroy(_M_impl, __p);
+        }
+      } catch (...) {
+        _M_publish_head(__h + __i);
+        throw;
+      }
+      _M_publish_head(__h + __n);
+      return __n;
+    }
+
+  private:
+    struct _Spsc_impl : public _Tp_alloc_type {
+      _Tp* _M_buf;
+      size_t _M_mask;
+
+      _Spsc_impl(_Tp_alloc_type&& __a, size_t __cap)
+          : _Tp_alloc_type(std::move(__a)),
+            _M_buf(_Alloc_traits::allocate(*this, __cap)), _M_mask(__cap - 1) {}
+    };
+
+    _Tp*
+    _M_slot(size_t __i) const noexcept { return _M_impl._M_buf + (__i & _M_impl._M_mask); }
+
+    void
+    _M_publish_tail(size_t __t) noexcept {
+      _M_tail.store(__t, std::memory_order_release);
+      this->_M_notify(this->_M_not_empty);
+    }
+
+    void
+    _M_publish_head(size_t __h) noexcept {
+      _M_head.store(__h, std::memory_order_release);
+      this->_M_notify(this->_M_not_full);
+    }
+
+    // Read by both sides, written by neither after construction.
+    _Spsc_impl _M_impl;
+
+    // Written by the consumer.
+    alignas(_S_cache_line) std::atomic<size_t> _M_head{0};
+    size_t _M_tail_cache = 0;
+
+    // Written by the producer.
+    alignas(_S_cache_line) std::atomic<size_t> _M_tail{0};
+    size_t _M_head_cache = 0;
+  };
+
+  /**
+   *  @brief A bounded multi-producer, multi-consumer queue.
+   *
+   *  @tparam _Tp  Type of element.
+   *  @tparam _Blocking  Whether push() and pop() sleep when they cannot
+   *                     proceed, rather than spin and yield.
+   *  @tparam _Alloc  Allocator type.
+   *
+   *  A ring buffer of cells that each carry a sequence number telling
+   *  which lap of the ring may use them next, after Dmitry Vyukov's
+   *  bounded MPMC queue.  Producers and consumers claim positions with
+   *  a compare-and-swap on their own, cache-line-padded index and then
+   *  work on their cell without further contention; the queue is
+   *  lock-free, but a thread stalled between claiming and publishing a
+   *  cell holds up the threads that come to that cell on the next lap.
+   *
+   *  A claimed cell must be published, so _Tp must be nothrow move
+   *  constructible; copies that may throw are made before claiming.  If
+   *  assigning a popped element throws, the element is lost.
+  */
+  template <typename _Tp, bool _Blocking = false, typename _Alloc = std::allocator<_Tp>>
+  class mpmc_queue : private _Ring_queue_base<_Blocking> {
+    typedef _Ring_queue_base<_Blocking> _Base;
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Tp>::other _Tp_alloc_type;
+
+    static_assert(std::is_nothrow_move_constructible<_Tp>::value,
+                  "__gnu_cxx::mpmc_queue requires a nothrow move constructible value_type");
+
+    using _Base::_S_cache_line;
+
+    struct _Cell {
+      std::atomic<size_t> _M_seq;
+      alignas(_Tp) unsigned char _M_storage[sizeof(_Tp)];
+
+      _Tp*
+      _M_valptr() noexcept { return static_cast<_Tp*>(static_cast<void*>(_M_storage)); }
+    };
+
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Cell>::other _Cell_alloc_type;
+    typedef __alloc_traits<_Cell_alloc_type> _Cell_alloc_traits;
+
+    static_assert(std::is_pointer<typename _Cell_alloc_traits::pointer>::value,
+                  "__gnu_cxx::mpmc_queue requires an allocator with raw pointers");
+
+  public:
+    typedef _Tp value_type;
+    typedef size_t size_type;
+    typedef _Alloc allocator_type;
+
+    /// Creates an empty queue with room for at least @a __capacity elements.
+    explicit mpmc_queue(size_type __capacity, const allocator_type& __a = allocator_type())
+        : _M_impl(_Cell_alloc_type(__a), _Base::_S_round_capacity(__capacity)) {}
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue() noexcept {
+      for (size_t __h = _M_head.load(std::memory_order_relaxed),
+                  __t = _M_tail.load(std::memory_order_relaxed);
+           __h != __t; ++__h)
+        _Cell_alloc_traits::destroy(_M_impl, _M_cell(__h)._M_valptr());
+      _Cell_alloc_traits::deallocate(_M_impl, _M_impl._M_cells, _M_impl._M_mask + 1);
+    }
+
+    size_type
+    capacity() const noexcept { return _M_impl._M_mask + 1; }
+
+    /// Number of claimed elements; only a snapshot.
+    size_type
+    size() const noexcept {
+      const size_t __h = _M_head.load(std::memory_order_acquire);
+      const size_t __t = _M_tail.load(std::memory_order_acquire);
+      return __t > __h ? __t - __h : 0;
+    }
+
+    bool
+    empty() const noexcept { return size() == 0; }
+
+    allocator_type
+    get_allocator() const noexcept { return allocator_type(_M_impl); }
+
+    /// Moves @a __x into the queue if there is room; returns whether it
+    /// did.  @a __x is untouched when it did not.
+    bool
+    try_push(value_type&& __x) noexcept {
+      _Cell* __c = _M_claim_tail();
+      if (!__c)
+        return false;
+      _Cell_alloc_traits::construct(_M_impl, __c->_M_valptr(), std::move(__x));
+      _S_publish_cell(__c, __c->_M_seq.load(std::memory_order_relaxed) + 1);
+      this->_M_notify(this->_M_not_empty);
+      return true;
+    }
+
+    bool
+    try_push(const value_type& __x) {
+      return _M_try_push_copy(__x, std::is_nothrow_copy_constructible<_Tp>());
+    }
+
+    void
+    push(value_type&& __x) {
+      this->_M_wait_for(this->_M_not_full, [&] { return try_push(std::move(__x)); });
+    }
+
+    void
+    push(const value_type& __x) {
+      value_type __tmp(__x);
+      push(std::move(__tmp));
+    }
+
+    /// Copies up to @a __n elements from @a __first into the queue;
+    /// returns how many fitted.  Runs of free cells are claimed at once
+    /// when constructing from *__first cannot throw.
+    template <typename _InputIterator>
+    size_type
+    push_n(_InputIterator __first, size_type __n) {
+      typedef decltype(*__first) _Ref;
+      return _M_push_n(__first, __n, std::is_nothrow_constructible<_Tp, _Ref>());
+    }
+
+    /// Moves the front element into @a __x and removes it if the queue is
+    /// not empty; returns whether it did.
+    bool
+    try_pop(value_type& __x) {
+      size_t __pos;
+      size_t __n = 1;
+      if (!_M_claim_head(__n, __pos))
+        return false;
+      _M_pop_cells(&__x, __pos, 1);
+      return true;
+    }
+
+    void
+    pop(value_type& __x) {
+      this->_M_wait_for(this->_M_not_empty, [&] { return try_pop(__x); });
+    }
+
+    /// Moves up to @a __n elements to @a __out, claiming them at once;
+    /// returns how many there were.
+    template <typename _OutputIterator>
+    size_type
+    pop_n(_OutputIterator __out, size_type __n) {
+      if (__n == 0)
+        return 0;
+      size_t __pos;
+      size_t __k = __n;
+      if (!_M_claim_head(__k, __pos))
+        return 0;
+      _M_pop_cells(__out, __pos, __k);
+      return __k;
+    }
+
+  private:
+    struct _Mpmc_impl : public _Cell_alloc_type {
+      _Cell* _M_cells;
+      size_t _M_mask;
+
+      _Mpmc_impl(_Cell_alloc_type&& __a, size_t __cap)
+          : _Cell_alloc_type(std::move(__a)),
+            _M_cells(_Cell_alloc_traits::allocate(*this, __cap)), _M_mask(__cap - 1) {
+        // Cell i is first free for the producer that claims position i.
+        for (size_t __i = 0; __i < __cap; ++__i)
+          ::new (&_M_cells[__i]._M_seq) std::atomic<size_t>(__i);
+      }
+    };
+
+    _Cell&
+    _M_cell(size_t __i) const noexcept { return _M_impl._M_cells[__i & _M_impl._M_mask]; }
+
+    static void
+    _S_publish_cell(_Cell* __c, size_t __seq) noexcept { __c->_M_seq.store(__seq, std::memory_order_release); }
+
+    bool
+    _M_try_push_copy(const value_type& __x, std::true_type) noexcept {
+      _Cell* __c = _M_claim_tail();
+      if (!__c)
+        return false;
+      _Cell_alloc_traits::construct(_M_impl, __c->_M_valptr(), __x);
+      _S_publish_cell(__c, __c->_M_seq.load(std::memory_order_relaxed) + 1);
+      this->_M_notify(this->_M_not_empty);
+      return true;
+    }
+
+    bool
+    _M_try_push_copy(const value_type& __x, std::false_type) {
+      value_type __tmp(__x);
+      return try_push(std::move(__tmp));
+    }
+
+    // Claims the next position for a producer; null if the queue is full.
+    _Cell*
+    _M_claim_tail() noexcept {
+      size_t __pos = _M_tail.load(std::memory_order_relaxed);
+      for (;;) {
+        _Cell* __c = &_M_cell(__pos);
+        const size_t __seq = __c->_M_seq.load(std::memory_order_acquire);
+        const ptrdiff_t __dif = ptrdiff_t(__seq - __pos);
+        if (__dif == 0) {
+          if (_M_tail.compare_exchange_weak(__pos, __pos + 1, std::memory_order_relaxed))
+            return __c;
+        } else if (__dif < 0)
+          return 0;
+        else
+          __pos = _M_tail.load(std::memory_order_relaxed);
+      }
+    }
+
+    // Claims up to __n consecutive full positions for a consumer; on
+    // success __n is set to the number claimed and __pos to the first.
+    _Cell*
+    _M_claim_head(size_t& __n, size_t& __pos) noexcept {
+      __pos = _M_head.load(std::memory_order_relaxed);
+      for (;;) {
+        size_t __k = 0;
+        while (__k < __n && _M_cell(__pos + __k)._M_seq.load(std::memory_order_acquire) == __pos + __k + 1)
+          ++__k;
+        if (__k == 0) {
+          const ptrdiff_t __dif = ptrdiff_t(_M_cell(__pos)._M_seq.load(std::memory_order_acquire) - (__pos + 1));
+          if (__dif < 0)
+            return 0;
+          __pos = _M_head.load(std::memory_order_relaxed);
+        } else if (_M_head.compare_exchange_weak(__pos, __pos + __k, std::memory_order_relaxed)) {
+          __n = __k;
+          return &_M_cell(__pos);
+        }
+      }
+    }
+
+    // Moves out and releases the claimed cells [__pos, __pos + __n).  The
+    // cells are released for the next lap even if an assignment throws.
+    template <typename _OutputIterator>
+    void
+    _M_pop_cells(_OutputIterator __out, size_t __pos, size_t __n) {
+      size_t __i = 0;
+      try {
+        for (; __i < __n; ++__i, ++__out) {
+          _Cell& __c = _M_cell(__pos + __i);
+          *__out = std::move(*__c._M_valptr());
+          _Cell_alloc_traits::destroy(_M_impl, __c._M_valptr());
+          _S_publish_cell(&__c, __pos + __i + capacity());
+        }
+      } catch (...) {
+        for (; __i < __n; ++__i) {
+          _Cell& __c = _M_cell(__pos + __i);
+          _Cell_alloc_traits::destroy(_M_impl, __c._M_valptr());
+          _S_publish_cell(&__c, __pos + __i + capacity());
+        }
+        this->_M_notify(this->_M_not_full);
+        throw;
+      }
+      this->_M_notify(this->_M_not_full);
+    }
+
+    template <typename _InputIterator>
+    size_type
+    _M_push_n(_InputIterator __first, size_type __n, std::true_type) noexcept {
+      size_type __done = 0;
+      while (__done < __n) {
+        // Claim a run of free cells with a single compare-and-swap.
+        size_t __pos = _M_tail.load(std::memory_order_relaxed);
+        size_t __k;
+        for (;;) {
+          __k = 0;
+          while (__done + __k < __n && _M_cell(__pos + __k)._M_seq.load(std::memory_order_acquire) == __pos + __k)
+            ++__k;
+          if (__k == 0) {
+            const ptrdiff_t __dif = ptrdiff_t(_M_cell(__pos)._M_seq.load(std::memory_order_acquire) - __pos);
+            if (__dif < 0)
+              break;
+            __pos = _M_tail.load(std::memory_order_relaxed);
+          } else if (_M_tail.compare_exchange_weak(__pos, __pos + __k, std::memory_order_relaxed))
+            break;
+        }
+        if (__k == 0)
+          break;
+        for (size_t __i = 0; __i < __k; ++__i, ++__first) {
+          _Cell& __c = _M_cell(__pos + __i);
+          _Cell_alloc_traits::construct(_M_impl, __c._M_valptr(), *__first);
+          _S_publish_cell(&__c, __pos + __i + 1);
+        }
+        __done += __k;
+      }
+      if (__done)
+        this->_M_notify(this->_M_not_empty);
+      return __done;
+    }
+
+    template <typename _InputIterator>
+    size_type
+    _M_push_n(_InputIterator __first, size_type __n, std::false_type) {
+      size_type __done = 0;
+      for (; __done < __n; ++__done, ++__first) {
+        value_type __tmp(*__first);
+        if (!try_push(std::move(__tmp)))
+          break;
+      }
+      return __done;
+    }
+
+    // Read by all threads, written by none after construction.
+    _Mpmc_impl _M_impl;
+
+    // Written by consumers.
+    alignas(_S_cache_line) std::atomic<size_t> _M_head{0};
+
+    // Written by producers.
+    alignas(_S_cache_line) std::atomic<size_t> _M_tail{0};
+  };
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++11
+
+#endif // _CONCURRENT_QUEUE_H
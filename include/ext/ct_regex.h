@@ -0,0 +1,890 @@
+// Compile-time regular expressions -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/ct_regex.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _CT_REGEX_H
+#define _CT_REGEX_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus > 201703L \
+    && (__cpp_nontype_template_parameter_class || __cpp_nontype_template_args >= 201911L)
+
+#include <algorithm>
+#include <iterator>
+#include <regex>
+#include <string_view>
+#include <type_traits>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// A string literal used as the template argument of ct_regex.
+  template <typename _CharT, size_t _Nm>
+  struct ct_pattern {
+    _CharT _M_str[_Nm];
+
+    constexpr ct_pattern(const _CharT (&__s)[_Nm]) noexcept : _M_str() {
+      for (size_t __i = 0; __i < _Nm; ++__i)
+        _M_str[__i] = __s[__i];
+    }
+
+    static constexpr size_t
+    size() noexcept { return _Nm - 1; }
+  };
+
+  enum class __ct_op : unsigned char {
+    _S_char,
+    _S_any,
+    _S_class,
+    _S_group,
+    _S_alt,
+    _S_repeat,
+    _S_bol,
+    _S_eol,
+    _S_word_bound,
+  };
+
+  // The escapes \d, \w, \s and their negations, as class bits.
+  enum : unsigned char {
+    __ct_digit = 1,
+    __ct_word = 2,
+    __ct_space = 4,
+    __ct_not_digit = 8,
+    __ct_not_word = 16,
+    __ct_not_space = 32,
+  };
+
+  template <typename _CharT>
+  constexpr bool
+  __ct_is_digit(_CharT __c) noexcept { return __c >= _CharT('0') && __c <= _CharT('9'); }
+
+  template <typename _CharT>
+  constexpr bool
+  __ct_is_word(_CharT __c) noexcept {
+    return __ct_is_digit(__c) || (__c >= _CharT('a') && __c <= _CharT('z'))
+        || (__c >= _CharT('A') && __c <= _CharT('Z')) || __c == _CharT('_');
+  }
+
+  template <typename _CharT>
+  constexpr bool
+  __ct_is_space(_CharT __c) noexcept {
+    return __c == _CharT(' ') || (__c >= _CharT('\t') && __c <= _CharT('\r'));
+  }
+
+  template <typename _CharT>
+  struct __ct_node {
+    __ct_op _M_op = __ct_op::_S_char;
+    _CharT _M_ch = _CharT();
+    int _M_next = -1;             // Next node of the sequence, or -1.
+    int _M_a = -1;                // Body, left alternative or first range.
+    int _M_b = -1;                // Right alternative or number of ranges.
+    int _M_min = 0;               // Repeat bounds, _M_max < 0 if unbounded.
+    int _M_max = -1;
+    unsigned _M_group = 0;        // Capture index, 0 for (?:...).
+    unsigned char _M_classes = 0; // For _S_class.
+    bool _M_neg = false;          // Negated class or \B.
+    bool _M_lazy = false;
+  };
+
+  // Reports an invalid pattern.  Not constexpr, so that reaching it while
+  // compiling a pattern is a compile-time error naming the problem.
+  inline void
+  __ct_regex_error(const char*) { }
+
+  // A parsed pattern of at most _Nm - 1 characters.  Nodes are stored in
+  // arrays and linked by index; the sequence starting at _M_root is the
+  // whole pattern.
+  template <typename _CharT, size_t _Nm>
+  struct __ct_program {
+    __ct_node<_CharT> _M_nodes[_Nm];
+    _CharT _M_ranges[2 * _Nm];
+    int _M_size = 0;
+    int _M_nranges = 0;
+    int _M_root = -1;
+    unsigned _M_groups = 0;
+
+    constexpr bool
+    _M_in_class(const __ct_node<_CharT>& __n, _CharT __ch) const noexcept {
+      typedef std::make_unsigned_t<_CharT> _UCharT;
+      const _UCharT __c = __ch;
+      bool __in = false;
+      for (int __i = __n._M_a; __i < __n._M_a + __n._M_b && !__in; ++__i)
+        __in = _UCharT(_M_ranges[2 * __i]) <= __c && __c <= _UCharT(_M_ranges[2 * __i + 1]);
+      const unsigned char __k = __n._M_classes;
+      __in = __in || ((__k & __ct_digit) && __ct_is_digit(__ch)) || ((__k & __ct_word) && __ct_is_word(__ch))
+          || ((__k & __ct_space) && __ct_is_space(__ch)) || ((__k & __ct_not_digit) && !__ct_is_digit(__ch))
+          || ((__k & __ct_not_word) && !__ct_is_word(__ch)) || ((__k & __ct_not_space) && !__ct_is_space(__ch));
+      return __in != __n._M_neg;
+    }
+
+    // The character every match begins with, as a node index, or -1.
+    constexpr int
+    _M_first_char(int __i) const noexcept {
+      while (__i >= 0 && _M_nodes[__i]._M_op == __ct_op::_S_group)
+        __i = _M_nodes[__i]._M_a;
+      return __i >= 0 && _M_nodes[__i]._M_op == __ct_op::_S_char ? __i : -1;
+    }
+  };
+
+  // Recursive descent parser for the ECMAScript subset ct_regex accepts.
+  template <typename _CharT, size_t _Nm>
+  struct __ct_parser {
+    const _CharT* _M_s;
+    size_t _M_len;
+    size_t _M_pos = 0;
+    __ct_program<_CharT, _Nm> _M_prog{};
+
+    constexpr bool
+    _M_at_end() const noexcept { return _M_pos == _M_len; }
+
+    constexpr bool
+    _M_peek(char __c) const noexcept { return !_M_at_end() && _M_s[_M_pos] == _CharT(__c); }
+
+    constexpr void
+    _M_fail(const char* __what) {
+      __ct_regex_error(__what);
+      _M_pos = _M_len;
+    }
+
+    constexpr int
+    _M_new(__ct_op __op) {
+      const int __id = _M_prog._M_size++;
+      _M_prog._M_nodes[__id]._M_op = __op;
+      return __id;
+    }
+
+    constexpr int
+    _M_disjunction() {
+      const int __left = _M_alternative();
+      if (!_M_peek('|'))
+        return __left;
+      ++_M_pos;
+      const int __right = _M_disjunction();
+      const int __n = _M_new(__ct_op::_S_alt);
+      _M_prog._M_nodes[__n]._M_a = __left;
+      _M_prog._M_nodes[__n]._M_b = __right;
+      return __n;
+    }
+
+    constexpr int
+    _M_alternative() {
+      int __head = -1, __tail = -1;
+      while (!_M_at_end() && !_M_peek('|') && !_M_peek(')')) {
+        const int __t = _M_term();
+        if (__t < 0)
+          break;
+        if (__head < 0)
+          __head = __t;
+        else
+          _M_prog._M_nodes[__tail]._M_next = __t;
+        __tail = __t;
+      }
+      return __head;
+    }
+
+    constexpr int
+    _M_term() {
+      if (_M_peek('^') || _M_peek('$'))
+        return _M_new(_M_s[_M_pos++] == _CharT('^') ? __ct_op::_S_bol : __ct_op::_S_eol);
+      if (_M_peek('\\') && _M_pos + 1 < _M_len
+          && (_M_s[_M_pos + 1] == _CharT('b') || _M_s[_M_pos + 1] == _CharT('B'))) {
+        const int __n = _M_new(__ct_op::_S_word_bound);
+        _M_prog._M_nodes[__n]._M_neg = _M_s[_M_pos + 1] == _CharT('B');
+        _M_pos += 2;
+        return __n;
+      }
+      const int __atom = _M_atom();
+      return __atom < 0 ? __atom : _M_quantifier(__atom);
+    }
+
+    constexpr int
+    _M_number() {
+      int __v = -1;
+      while (!_M_at_end() && __ct_is_digit(_M_s[_M_pos]))
+        __v = (__v < 0 ? 0 : __v * 10) + (_M_s[_M_pos++] - _CharT('0'));
+      return __v;
+    }
+
+    constexpr int
+    _M_quantifier(int __atom) {
+      int __min = 0, __max = -1;
+      if (_M_peek('*'))
+        ++_M_pos;
+      else if (_M_peek('+')) {
+        ++_M_pos;
+        __min = 1;
+      } else if (_M_peek('?')) {
+        ++_M_pos;
+        __max = 1;
+      } else if (_M_peek('{')) {
+        ++_M_pos;
+        __min = __max = _M_number();
+        if (__min < 0) {
+          _M_fail("ct_regex: invalid repeat count");
+          return -1;
+        }
+        if (_M_peek(',')) {
+          ++_M_pos;
+          __max = _M_number();
+        }
+        if (!_M_peek('}') || (__max >= 0 && __max < __min)) {
+          _M_fail("ct_regex: invalid repeat count");
+          return -1;
+        }
+        ++_M_pos;
+      } else
+        return __atom;
+      const int __n = _M_new(__ct_op::_S_repeat);
+      __ct_node<_CharT>& __r = _M_prog._M_nodes[__n];
+      __r._M_a = __atom;
+      __r._M_min = __min;
+      __r._M_max = __max;
+      if (_M_peek('?')) {
+        ++_M_pos;
+        __r._M_lazy = true;
+      }
+      return __n;
+    }
+
+    constexpr int
+    _M_hex(int __digits) {
+      int __v = 0;
+      for (; __digits > 0; --__digits) {
+        const _CharT __c = _M_at_end() ? _CharT() : _M_s[_M_pos++];
+        if (__ct_is_digit(__c))
+          __v = __v * 16 + (__c - _CharT('0'));
+        else if (__c >= _CharT('a') && __c <= _CharT('f'))
+          __v = __v * 16 + (__c - _CharT('a') + 10);
+        else if (__c >= _CharT('A') && __c <= _CharT('F'))
+          __v = __v * 16 + (__c - _CharT('A') + 10);
+        else {
+          _M_fail("ct_regex: invalid hexadecimal escape");
+          return 0;
+        }
+      }
+      return __v;
+    }
+
+    // Parses the escape after a backslash into a character or class bits.
+    constexpr bool
+    _M_escape(_CharT& __ch, unsigned char& __classes, bool __in_class) {
+      if (_M_at_end()) {
+        _M_fail("ct_regex: trailing backslash");
+        return false;
+      }
+      const _CharT __c = _M_s[_M_pos++];
+      switch (__c) {
+      case 'd': __classes = __ct_digit; break;
+      case 'D': __classes = __ct_not_digit; break;
+      case 'w': __classes = __ct_word; break;
+      case 'W': __classes = __ct_not_word; break;
+      case 's': __classes = __ct_space; break;
+      case 'S': __classes = __ct_not_space; break;
+      case 'n': __ch = _CharT('\n'); break;
+      case 't': __ch = _CharT('\t'); break;
+      case 'r': __ch = _CharT('\r'); break;
+      case 'f': __ch = _CharT('\f'); break;
+      case 'v': __ch = _CharT('\v'); break;
+      case '0': __ch = _CharT(); break;
+      case 'x': __ch = _CharT(_M_hex(2)); break;
+      case 'u': __ch = _CharT(_M_hex(4)); break;
+      case 'c':
+        if (_M_at_end() || !__ct_is_word(_M_s[_M_pos]) || __ct_is_digit(_M_s[_M_pos])) {
+          _M_fail("ct_regex: invalid control escape");
+          return false;
+        }
+        __ch = _CharT(_M_s[_M_pos++] % 32);
+        break;
+      case 'b':
+        if (!__in_class) {
+          _M_fail("ct_regex: invalid escape");
+          return false;
+        }
+        __ch = _CharT('\b');
+        break;
+      default:
+        if (__ct_is_digit(__c)) {
+          _M_fail("ct_regex: back-references are not supported");
+          return false;
+        }
+        if (__ct_is_word(__c)) {
+          _M_fail("ct_regex: invalid escape");
+          return false;
+        }
+        __ch = __c;
+      }
+      return true;
+    }
+
+    constexpr int
+    _M_bracket() {
+      const int __n = _M_new(__ct_op::_S_class);
+      __ct_node<_CharT>& __node = _M_prog._M_nodes[__n];
+      if (_M_peek('^')) {
+        ++_M_pos;
+        __node._M_neg = true;
+      }
+      __node._M_a = _M_prog._M_nranges;
+      while (!_M_at_end() && !_M_peek(']')) {
+        _CharT __lo = _M_s[_M_pos++];
+        unsigned char __classes = 0;
+        if (__lo == _CharT('\\') && !_M_escape(__lo, __classes, true))
+          return -1;
+        if (__classes) {
+          __node._M_classes |= __classes;
+          continue;
+        }
+        _CharT __hi = __lo;
+        if (_M_peek('-') && _M_pos + 1 < _M_len && _M_s[_M_pos + 1] != _CharT(']')) {
+          ++_M_pos;
+          __hi = _M_s[_M_pos++];
+          if (__hi == _CharT('\\') && !_M_escape(__hi, __classes, true))
+            return -1;
+          if (__classes || std::make_unsigned_t<_CharT>(__hi) < std::make_unsigned_t<_CharT>(__lo)) {
+            _M_fail("ct_regex: invalid range in bracket expression");
+            return -1;
+          }
+        }
+        _M_prog._M_ranges[2 * _M_prog._M_nranges] = __lo;
+        _M_prog._M_ranges[2 * _M_prog._M_nranges + 1] = __hi;
+        ++_M_prog._M_nranges;
+      }
+      if (!_M_peek(']')) {
+        _M_fail("ct_regex: unmatched '['");
+        return -1;
+      }
+      ++_M_pos;
+      __node._M_b = _M_prog._M_nranges - __node._M_a;
+      return __n;
+    }
+
+    constexpr int
+    _M_atom() {
+      const _CharT __c = _M_s[_M_pos++];
+      switch (__c) {
+      case '.':
+        return _M_new(__ct_op::_S_any);
+      case '[':
+        return _M_bracket();
+      case '(': {
+        unsigned __group = 0;
+        if (_M_peek('?')) {
+          if (_M_pos + 1 >= _M_len || _M_s[_M_pos + 1] != _CharT(':')) {
+            _M_fail("ct_regex: lookaheads are not supported");
+            return -1;
+          }
+          _M_pos += 2;
+        } else
+          __group = ++_M_prog._M_groups;
+        const int __body = _M_disjunction();
+        if (!_M_peek(')')) {
+          _M_fail("ct_regex: unmatched '('");
+          return -1;
+        }
+        ++_M_pos;
+        const int __n = _M_new(__ct_op::_S_group);
+        _M_prog._M_nodes[__n]._M_a = __body;
+        _M_prog._M_nodes[__n]._M_group = __group;
+        return __n;
+      }
+      case '*':
+      case '+':
+      case '?':
+      case '{':
+        _M_fail("ct_regex: nothing to repeat");
+        return -1;
+      case '\\': {
+        _CharT __ch = _CharT();
+        unsigned char __classes = 0;
+        if (!_M_escape(__ch, __classes, false))
+          return -1;
+        const int __n = _M_new(__classes ? __ct_op::_S_class : __ct_op::_S_char);
+        _M_prog._M_nodes[__n]._M_ch = __ch;
+        _M_prog._M_nodes[__n]._M_a = 0;
+        _M_prog._M_nodes[__n]._M_b = 0;
+        _M_prog._M_nodes[__n]._M_classes = __classes;
+        return __n;
+      }
+      default: {
+        const int __n = _M_new(__ct_op::_S_char);
+        _M_prog._M_nodes[__n]._M_ch = __c;
+        return __n;
+      }
+      }
+    }
+  };
+
+  template <typename _CharT, size_t _Nm>
+  constexpr __ct_program<_CharT, _Nm>
+  __ct_compile(const _CharT* __s) {
+    __ct_parser<_CharT, _Nm> __p{__s, _Nm - 1};
+    __p._M_prog._M_root = __p._M_disjunction();
+    if (!__p._M_at_end())
+      __p._M_fail("ct_regex: unmatched ')'");
+    return __p._M_prog;
+  }
+
+  template <typename _BiIter>
+  struct __ct_context {
+    _BiIter _M_begin;
+    _BiIter _M_end;
+    std::sub_match<_BiIter>* _M_subs;
+    std::regex_constants::match_flag_type _M_flags;
+    _BiIter _M_start{}; // Where the match being tried starts.
+
+    // As in std::regex_search, match_not_bow applies wherever a match is
+    // tried, and not at all with match_prev_avail.
+    bool
+    _M_word_boundary(_BiIter __p) const {
+      using namespace std::regex_constants;
+      if ((__p == _M_start && (_M_flags & match_not_bow) && !(_M_flags & match_prev_avail))
+          || (__p == _M_end && (_M_flags & match_not_eow)))
+        return false;
+      const bool __left = (__p != _M_begin || (_M_flags & match_prev_avail)) && __ct_is_word(*std::prev(__p));
+      const bool __right = __p != _M_end && __ct_is_word(*__p);
+      return __left != __right;
+    }
+  };
+
+  /**
+   *  Backtracking matcher for node _Ix of _Re's program and the nodes
+   *  following it.  Each node is a separate instantiation, so the
+   *  pattern is compiled into straight-line code; alternatives and
+   *  repeats pass what remains of the match as a continuation @a __k,
+   *  called with the position reached and returning whether the rest of
+   *  the pattern matched from there.
+   */
+  template <typename _Re, int _Ix>
+  struct __ct_matcher {
+    typedef typename _Re::char_type _CharT;
+
+    static constexpr const __ct_node<_CharT>&
+    _S_node() noexcept { return _Re::_S_program._M_nodes[_Ix < 0 ? 0 : _Ix]; }
+
+    // Whether the node matches exactly one character.
+    static constexpr bool _S_is_single = _Ix >= 0
+        && (_S_node()._M_op == __ct_op::_S_char || _S_node()._M_op == __ct_op::_S_any
+            || _S_node()._M_op == __ct_op::_S_class);
+
+    template <typename _Ch>
+    static bool
+    _S_single(const _Ch& __ch) {
+      constexpr const __ct_node<_CharT>& __n = _S_node();
+      const _CharT __c = __ch;
+      if constexpr (__n._M_op == __ct_op::_S_char)
+        return __c == __n._M_ch;
+      else if constexpr (__n._M_op == __ct_op::_S_any)
+        return __c != _CharT('\n') && __c != _CharT('\r');
+      else
+        return _Re::_S_program._M_in_class(__n, __c);
+    }
+
+    template <typename _BiIter, typename _Cont>
+    static bool
+    _S_match(_BiIter __p, __ct_context<_BiIter>& __c, const _Cont& __k) {
+      if constexpr (_Ix < 0)
+        return __k(__p);
+      else {
+        constexpr const __ct_node<_CharT>& __n = _S_node();
+        typedef __ct_matcher<_Re, __n._M_next> _Next;
+        typedef __ct_matcher<_Re, __n._M_a> _Body;
+        using namespace std::regex_constants;
+
+        if constexpr (_S_is_single) {
+          if (__p == __c._M_end || !_S_single(*__p))
+            return false;
+          return _Next::_S_match(++__p, __c, __k);
+        } else if constexpr (__n._M_op == __ct_op::_S_bol) {
+          if (__p != __c._M_begin || (__c._M_flags & (match_not_bol | match_prev_avail)))
+            return false;
+          return _Next::_S_match(__p, __c, __k);
+        } else if constexpr (__n._M_op == __ct_op::_S_eol) {
+          if (__p != __c._M_end || (__c._M_flags & match_not_eol))
+            return false;
+          return _Next::_S_match(__p, __c, __k);
+        } else if constexpr (__n._M_op == __ct_op::_S_word_bound) {
+          if (__c._M_word_boundary(__p) == __n._M_neg)
+            return false;
+          return _Next::_S_match(__p, __c, __k);
+        } else if constexpr (__n._M_op == __ct_op::_S_alt) {
+          auto __then = [&__c, &__k](_BiIter __q) { return _Next::_S_match(__q, __c, __k); };
+          return _Body::_S_match(__p, __c, __then) || __ct_matcher<_Re, __n._M_b>::_S_match(__p, __c, __then);
+        } else if constexpr (__n._M_op == __ct_op::_S_group) {
+          if constexpr (__n._M_group == 0) {
+            auto __then = [&__c, &__k](_BiIter __q) { return _Next::_S_match(__q, __c, __k); };
+            return _Body::_S_match(__p, __c, __then);
+          } else {
+            auto __then = [&__c, &__k, __p](_BiIter __q) {
+              std::sub_match<_BiIter>& __sub = __c._M_subs[__n._M_group];
+              const std::sub_match<_BiIter> __saved = __sub;
+              __sub.first = __p;
+              __sub.second = __q;
+              __sub.matched = true;
+              if (_Next::_S_match(__q, __c, __k))
+                return true;
+              __sub = __saved;
+              return false;
+            };
+            return _Body::_S_match(__p, __c, __then);
+          }
+        } else if constexpr (_Body::_S_is_single) {
+          // A repeated single character needs no recursion: count how far
+          // it extends, then try the rest from each possible end.
+          if constexpr (!__n._M_lazy) {
+            _BiIter __q = __p;
+            int __i = 0;
+            while ((__n._M_max < 0 || __i < __n._M_max) && __q != __c._M_end && _Body::_S_single(*__q)) {
+              ++__q;
+              ++__i;
+            }
+            if (__i < __n._M_min)
+              return false;
+            for (;; --__q, --__i) {
+              if (_Next::_S_match(__q, __c, __k))
+                return true;
+              if (__i == __n._M_min)
+                return false;
+            }
+          } else {
+            _BiIter __q = __p;
+            for (int __i = 0;; ++__i, ++__q) {
+              if (__i >= __n._M_min && _Next::_S_match(__q, __c, __k))
+                return true;
+              if ((__n._M_max >= 0 && __i >= __n._M_max) || __q == __c._M_end || !_Body::_S_single(*__q))
+                return false;
+            }
+          }
+        } else {
+          auto __then = [&__c, &__k](_BiIter __q) { return _Next::_S_match(__q, __c, __k); };
+          return _S_repeat(__p, __c, __then, 0);
+        }
+      }
+    }
+
+    // A repeat whose body is not a single character, after __count
+    // iterations.
+    template <typename _BiIter, typename _Cont>
+    static bool
+    _S_repeat(_BiIter __p, __ct_context<_BiIter>& __c, const _Cont& __k, int __count) {
+      constexpr const __ct_node<_CharT>& __n = _S_node();
+      typedef __ct_matcher<_Re, __n._M_a> _Body;
+      auto __more = [&__c, &__k, __p, __count](_BiIter __q) {
+        // An iteration that matched nothing leads nowhere new.
+        if (__q == __p && __count >= __n._M_min)
+          return false;
+        return _S_repeat(__q, __c, __k, __count + 1);
+      };
+      const bool __can_more = __n._M_max < 0 || __count < __n._M_max;
+      if constexpr (__n._M_lazy) {
+        if (__count >= __n._M_min && __k(__p))
+          return true;
+        return __can_more && _Body::_S_match(__p, __c, __more);
+      } else {
+        if (__can_more && _Body::_S_match(__p, __c, __more))
+          return true;
+        return __count >= __n._M_min && __k(__p);
+      }
+    }
+  };
+
+  /**
+   *  @brief  The results of a ct_regex match: the whole match and
+   *          _Nsub - 1 marked subexpressions.
+   *
+   *  Offers the read-only interface of std::match_results, with the
+   *  submatches stored in the object itself.
+   */
+  template <typename _BiIter, size_t _Nsub>
+  class ct_match_results {
+  public:
+    typedef std::sub_match<_BiIter> value_type;
+    typedef const value_type& const_reference;
+    typedef const_reference reference;
+    typedef const value_type* const_iterator;
+    typedef const_iterator iterator;
+    typedef typename std::iterator_traits<_BiIter>::difference_type difference_type;
+    typedef size_t size_type;
+    typedef typename std::iterator_traits<_BiIter>::value_type char_type;
+    typedef std::basic_string<char_type> string_type;
+
+    bool
+    ready() const noexcept { return _M_ready; }
+
+    /// _Nsub after a successful match, else 0.
+    size_type
+    size() const noexcept { return _M_matched ? _Nsub : 0; }
+
+    static constexpr size_type
+    max_size() noexcept { return _Nsub; }
+
+    bool
+    empty() const noexcept { return size() == 0; }
+
+    difference_type
+    length(size_type __sub = 0) const { return (*this)[__sub].length(); }
+
+    difference_type
+    position(size_type __sub = 0) const { return std::distance(_M_begin, (*this)[__sub].first); }
+
+    string_type
+    str(size_type __sub = 0) const { return string_type((*this)[__sub]); }
+
+    const_reference
+    operator[](size_type __sub) const noexcept { return __sub < size() ? _M_subs[__sub] : _M_unmatched; }
+
+    const_reference
+    prefix() const noexcept { return _M_prefix; }
+
+    const_reference
+    suffix() const noexcept { return _M_suffix; }
+
+    const_iterator
+    begin() const noexcept { return _M_subs; }
+
+    const_iterator
+    end() const noexcept { return _M_subs + size(); }
+
+    const_iterator
+    cbegin() const noexcept { return begin(); }
+
+    const_iterator
+    cend() const noexcept { return end(); }
+
+  private:
+    template <typename>
+    friend struct __ct_executor;
+
+    value_type _M_subs[_Nsub];
+    value_type _M_prefix;
+    value_type _M_suffix;
+    value_type _M_unmatched;
+    _BiIter _M_begin{};
+    bool _M_ready = false;
+    bool _M_matched = false;
+  };
+
+  template <typename _Re>
+  struct __ct_executor {
+    typedef __ct_matcher<_Re, _Re::_S_program._M_root> _Root;
+    static constexpr int _S_first = _Re::_S_program._M_first_char(_Re::_S_program._M_root);
+
+    // Finds the match; on success sets __c._M_subs[0].
+    template <typename _BiIter>
+    static bool
+    _S_run(__ct_context<_BiIter>& __c, bool __match_mode) {
+      using namespace std::regex_constants;
+      const bool __not_null = __c._M_flags & match_not_null;
+      _BiIter __start = __c._M_begin;
+      _BiIter __found = __start;
+      __c._M_start = __start;
+      bool __ret;
+      if (__match_mode) {
+        auto __k = [&__c, &__start, __not_null](_BiIter __q) {
+          return __q == __c._M_end && !(__not_null && __q == __start);
+        };
+        __ret = _Root::_S_match(__start, __c, __k);
+        __found = __c._M_end;
+      } else {
+        auto __k = [&__start, &__found, __not_null](_BiIter __q) {
+          if (__not_null && __q == __start)
+            return false;
+          __found = __q;
+          return true;
+        };
+        const bool __continuous = __c._M_flags & match_continuous;
+        for (;;) {
+          if constexpr (_S_first >= 0)
+            if (!__continuous) {
+              __start = std::find(__start, __c._M_end, _Re::_S_program._M_nodes[_S_first]._M_ch);
+              if (__start == __c._M_end) {
+                __ret = false;
+                break;
+              }
+            }
+          __c._M_start = __start;
+          if ((__ret = _Root::_S_match(__start, __c, __k)) || __continuous || __start == __c._M_end)
+            break;
+          ++__start;
+        }
+      }
+      if (__ret) {
+        __c._M_subs[0].first = __start;
+        __c._M_subs[0].second = __found;
+        __c._M_subs[0].matched = true;
+      }
+      return __ret;
+    }
+
+    template <typename _BiIter>
+    static bool
+    _S_test(_BiIter __first, _BiIter __last, std::regex_constants::match_flag_type __flags, bool __match_mode) {
+      std::sub_match<_BiIter> __subs[_Re::mark_count() + 1];
+      __ct_context<_BiIter> __c{__first, __last, __subs, __flags};
+      return _S_run(__c, __match_mode);
+    }
+
+    template <typename _BiIter, size_t _Nsub>
+    static bool
+    _S_exec(_BiIter __first, _BiIter __last, ct_match_results<_BiIter, _Nsub>& __m,
+            std::regex_constants::match_flag_type __flags, bool __match_mode) {
+      for (auto& __sub : __m._M_subs)
+        __sub = std::sub_match<_BiIter>();
+      __ct_context<_BiIter> __c{__first, __last, __m._M_subs, __flags};
+      const bool __ret = _S_run(__c, __match_mode);
+      __m._M_begin = __first;
+      __m._M_ready = true;
+      __m._M_matched = __ret;
+      __m._M_unmatched.first = __m._M_unmatched.second = __last;
+      for (auto& __sub : __m._M_subs)
+        if (!__ret || !__sub.matched)
+          __sub.first = __sub.second = __last;
+      __m._M_prefix.first = __first;
+      __m._M_prefix.second = __ret ? __m._M_subs[0].first : __first;
+      __m._M_prefix.matched = __m._M_prefix.first != __m._M_prefix.second;
+      __m._M_suffix.first = __ret ? __m._M_subs[0].second : __last;
+      __m._M_suffix.second = __last;
+      __m._M_suffix.matched = __ret && __m._M_suffix.first != __m._M_suffix.second;
+      return __ret;
+    }
+  };
+
+  /**
+   *  @brief  A regular expression compiled during template instantiation.
+   *
+   *  The pattern is parsed when ct_regex<"..."> is instantiated, and an
+   *  invalid pattern is a compile-time error.  Every node of the pattern
+   *  becomes code specialized for it, so matching neither interprets an
+   *  automaton nor allocates.  Results come in a ct_match_results, which
+   *  has the interface of std::match_results.
+   *
+   *  The ECMAScript subset accepted is: literal characters and the
+   *  escapes \\n \\t \\r \\f \\v \\0 \\xHH \\uHHHH \\cX and \\ followed by a
+   *  punctuation character; @c . (any character but \\n and \\r); the
+   *  classes \\d \\w \\s \\D \\W \\S and bracket expressions with ranges;
+   *  capturing and (?:) groups; @c |; the quantifiers * + ? {n} {n,}
+   *  {n,m} and their lazy forms; and the assertions ^ $ \\b \\B.
+   *  Character classes use the "C" locale and matching is case
+   *  sensitive.  Back-references and lookaheads are not supported.
+   *
+   *  The flags match_not_bol, match_not_eol, match_not_bow,
+   *  match_not_eow, match_not_null, match_continuous and
+   *  match_prev_avail behave as for std::regex_match and
+   *  std::regex_search.
+   *
+   *  Where a repeated subexpression can match the empty string, ct_regex
+   *  follows ECMAScript, which never repeats it once more on an empty
+   *  match, whereas std::regex_search allows that once.  The submatches
+   *  inside it may then differ: on "aab", (a*)*b leaves group 1 as "aa"
+   *  and (a|)+b as the second "a", where std::regex_search leaves it
+   *  empty.  When the subexpression tries the empty match first, as in
+   *  (|a)*, the whole match may differ too: on "a", ct_regex matches "a"
+   *  and std::regex_search the empty string.
+   */
+  template <ct_pattern _Pattern>
+  class ct_regex {
+  public:
+    typedef std::remove_const_t<std::remove_reference_t<decltype(_Pattern._M_str[0])>> char_type;
+    typedef std::regex_constants::match_flag_type flag_type;
+
+  private:
+    template <typename, int>
+    friend struct __ct_matcher;
+    template <typename>
+    friend struct __ct_executor;
+
+    static constexpr auto _S_program
+        = __ct_compile<char_type, sizeof(_Pattern._M_str) / sizeof(char_type)>(_Pattern._M_str);
+
+    typedef __ct_executor<ct_regex> _Executor;
+
+  public:
+    /// Number of marked subexpressions.
+    static constexpr size_t
+    mark_count() noexcept { return _S_program._M_groups; }
+
+    template <typename _BiIter>
+    using results = ct_match_results<_BiIter, mark_count() + 1>;
+
+    /// Whether the pattern matches all of [__first, __last).
+    template <typename _BiIter>
+    static bool
+    match(_BiIter __first, _BiIter __last, results<_BiIter>& __m,
+          flag_type __flags = std::regex_constants::match_default) {
+      return _Executor::_S_exec(__first, __last, __m, __flags, true);
+    }
+
+    template <typename _BiIter>
+    static bool
+    match(_BiIter __first, _BiIter __last, flag_type __flags = std::regex_constants::match_default) {
+      return _Executor::_S_test(__first, __last, __flags, true);
+    }
+
+    static bool
+    match(std::basic_string_view<char_type> __s, results<const char_type*>& __m,
+          flag_type __flags = std::regex_constants::match_default) {
+      return match(__s.data(), __s.data() + __s.size(), __m, __flags);
+    }
+
+    static bool
+    match(std::basic_string_view<char_type> __s, flag_type __flags = std::regex_constants::match_default) {
+      return match(__s.data(), __s.data() + __s.size(), __flags);
+    }
+
+    /// Whether the pattern matches some subsequence of [__first, __last).
+    /// The leftmost match is reported.
+    template <typename _BiIter>
+    static bool
+    search(_BiIter __first, _BiIter __last, results<_BiIter>& __m,
+           flag_type __flags = std::regex_constants::match_default) {
+      return _Executor::_S_exec(__first, __last, __m, __flags, false);
+    }
+
+    template <typename _BiIter>
+    static bool
+    search(_BiIter __first, _BiIter __last, flag_type __flags = std::regex_constants::match_default) {
+      return _Executor::_S_test(__first, __last, __flags, false);
+    }
+
+    static bool
+    search(std::basic_string_view<char_type> __s, results<const char_type*>& __m,
+           flag_type __flags = std::regex_constants::match_default) {
+      return search(__s.data(), __s.data() + __s.size(), __m, __flags);
+    }
+
+    static bool
+    search(std::basic_string_view<char_type> __s, flag_type __flags = std::regex_constants::match_default) {
+      return search(__s.data(), __s.data() + __s.size(), __flags);
+    }
+  };
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++20
+
+#endif // _CT_REGEX_H
@@ -0,0 +1,122 @@
+// Linear-time substring searcher -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/fast_searcher.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _FAST_SEARCHER_H
+#define _FAST_SEARCHER_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <algorithm>
+#include <bits/byte_search.h>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief  A searcher for std::search with worst-case linear time.
+   *
+   *  When the pattern and the searched range are contiguous sequences of
+   *  the same byte type (char, signed char, unsigned char, std::byte)
+   *  compared with std::equal_to, short patterns are located with a
+   *  vectorized first/last byte prefilter and long ones with the Two-Way
+   *  algorithm.  The prefilter hands over to Two-Way when verifying its
+   *  candidates gets expensive, so the search is O(n + m) on any input.
+   *  Construction costs O(m) and needs no tables.  Other element types and
+   *  predicates are searched like std::default_searcher.
+   *
+   *  As with the standard searchers, the pattern is not copied and must
+   *  outlive the searcher.
+   */
+  template <typename _RAIter, typename _BinaryPredicate = std::equal_to<>>
+  class fast_searcher {
+    typedef typename std::iterator_traits<_RAIter>::value_type _Val;
+
+    template <typename _Iter>
+    using _Contiguous_bytes =
+        std::__and_<std::is_pointer<decltype(std::__niter_base(std::declval<_Iter>()))>,
+                    std::__bool_constant<std::__is_byte<typename std::iterator_traits<_Iter>::value_type>::__value>>;
+
+    static constexpr bool _S_bytes =
+        _Contiguous_bytes<_RAIter>::value
+        && (std::is_same<_BinaryPredicate, std::equal_to<>>::value
+            || std::is_same<_BinaryPredicate, std::equal_to<_Val>>::value);
+
+    static const unsigned char*
+    _S_bytes_of(_RAIter __it) {
+      if constexpr (_S_bytes)
+        return reinterpret_cast<const unsigned char*>(std::__niter_base(__it));
+      else
+        return nullptr;
+    }
+
+  public:
+    fast_searcher(_RAIter __pat_first, _RAIter __pat_last,
+                  _BinaryPredicate __pred = _BinaryPredicate())
+        : _M_pat(__pat_first), _M_pat_end(__pat_last), _M_pred(std::move(__pred)),
+          _M_two_way(_S_bytes_of(__pat_first), _S_bytes ? __pat_last - __pat_first : 0) {}
+
+    template <typename _RandomAccessIterator2>
+    std::pair<_RandomAccessIterator2, _RandomAccessIterator2>
+    operator()(_RandomAccessIterator2 __first, _RandomAccessIterator2 __last) const {
+      typedef typename std::iterator_traits<_RandomAccessIterator2>::value_type _Val2;
+      if constexpr (_S_bytes && _Contiguous_bytes<_RandomAccessIterator2>::value
+                    && std::is_same<_Val, _Val2>::value) {
+        const unsigned char* __h = reinterpret_cast<const unsigned char*>(std::__niter_base(__first));
+        const unsigned char* __r = std::__byte_search(__h, __last - __first,
+                                                      _M_two_way._M_pat, _M_two_way._M_len,
+                                                      &_M_two_way);
+        if (!__r)
+          return std::make_pair(__last, __last);
+        const _RandomAccessIterator2 __match = __first + (__r - __h);
+        return std::make_pair(__match, __match + (_M_pat_end - _M_pat));
+      } else {
+        const _RandomAccessIterator2 __match = std::search(__first, __last, _M_pat, _M_pat_end, _M_pred);
+        if (__match == __last)
+          return std::make_pair(__match, __match);
+        return std::make_pair(__match, __match + (_M_pat_end - _M_pat));
+      }
+    }
+
+  private:
+    _RAIter _M_pat;
+    _RAIter _M_pat_end;
+    _BinaryPredicate _M_pred;
+    std::__two_way_matcher _M_two_way;
+  };
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++17
+
+#endif // _FAST_SEARCHER_H
@@ -0,0 +1,914 @@
+// Sorted-vector maps -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/flat_map.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _FLAT_MAP_H
+#define _FLAT_MAP_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <bits/functexcept.h>
+#include <ext/flat_tree.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief Iterator over a flat map: a key iterator and a mapped
+   *  iterator advanced in lock step.
+   *
+   *  Dereferencing yields a pair of references rather than a reference to
+   *  a pair, since keys and mapped values live in separate containers.
+  */
+  template <typename _KeyIterator, typename _MappedIterator>
+  struct _Flat_map_iterator {
+    typedef std::iterator_traits<_KeyIterator> _Key_traits;
+    typedef std::iterator_traits<_MappedIterator> _Mapped_traits;
+
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef std::pair<typename _Key_traits::value_type,
+                      typename _Mapped_traits::value_type>
+        value_type;
+    typedef std::pair<typename _Key_traits::reference,
+                      typename _Mapped_traits::reference>
+        reference;
+    typedef typename _Key_traits::difference_type difference_type;
+
+    // operator-> has to return something that owns the pair.
+    struct pointer {
+      reference _M_ref;
+
+      reference*
+      operator->() noexcept { return std::__addressof(_M_ref); }
+    };
+
+    _KeyIterator _M_key;
+    _MappedIterator _M_mapped;
+
+    _Flat_map_iterator()
+        : _M_key(), _M_mapped() {}
+
+    _Flat_map_iterator(_KeyIterator __k, _MappedIterator __m)
+        : _M_key(__k), _M_mapped(__m) {}
+
+    // iterator to const_iterator conversion
+    template <typename _KIt, typename _MIt,
+              typename = typename std::enable_if<std::is_convertible<_KIt, _KeyIterator>::value
+                                                 && std::is_convertible<_MIt, _MappedIterator>::value>::type>
+    _Flat_map_iterator(const _Flat_map_iterator<_KIt, _MIt>& __it)
+        : _M_key(__it._M_key), _M_mapped(__it._M_mapped) {}
+
+    reference
+    operator*() const { return reference(*_M_key, *_M_mapped); }
+
+    pointer
+    operator->() const { return pointer{**this}; }
+
+    reference
+    operator[](difference_type __n) const { return *(*this + __n); }
+
+    _Flat_map_iterator&
+    operator++() {
+      ++_M_key;
+      ++_M_mapped;
+      return *this;
+    }
+
+    _Flat_map_iterator
+    operator++(int) {
+      _Flat_map_iterator __tmp = *this;
+      ++*this;
+      return __tmp;
+    }
+
+    _Flat_map_iterator&
+    operator--() {
+      --_M_key;
+      --_M_mapped;
+      return *this;
+    }
+
+    _Flat_map_iterator
+    operator--(int) {
+      _Flat_map_iterator __tmp = *this;
+      --*this;
+      return __tmp;
+    }
+
+    _Flat_map_iterator&
+    operator+=(difference_type __n) {
+      _M_key += __n;
+      _M_mapped += __n;
+      return *this;
+    }
+
+    _Flat_map_iterator&
+    operator-=(difference_type __n) { return *this += -__n; }
+
+    _Flat_map_iterator
+    operator+(difference_type __n) const {
+      _Flat_map_iterator __tmp = *this;
+      return __tmp += __n;
+    }
+
+    _Flat_map_iterator
+    operator-(difference_type __n) const {
+      _Flat_map_iterator __tmp = *this;
+      return __tmp -= __n;
+    }
+
+    friend _Flat_map_iterator
+    operator+(difference_type __n, const _Flat_map_iterator& __it) { return __it + __n; }
+  };
+
+  // The key iterators alone decide position, and they are the same type
+  // for iterator and const_iterator, so mixed comparisons just work.
+  template <typename _KIt1, typename _MIt1, typename _KIt2, typename _MIt2>
+  inline bool
+  operator==(const _Flat_map_iterator<_KIt1, _MIt1>& __x,
+             const _Flat_map_iterator<_KIt2, _MIt2>& __y) { return __x._M_key == __y._M_key; }
+
+  template <typename _KIt1, typename _MIt1, typename _KIt2, typename _MIt2>
+  inline bool
+  operator!=(const _Flat_map_iterator<_KIt1, _MIt1>& __x,
+             const _Flat_map_iterator<_KIt2, _MIt2>& __y) { return __x._M_key != __y._M_key; }
+
+  template <typename _KIt1, typename _MIt1, typename _KIt2, typename _MIt2>
+  inline bool
+  operator<(const _Flat_map_iterator<_KIt1, _MIt1>& __x,
+            const _Flat_map_iterator<_KIt2, _MIt2>& __y) { return __x._M_key < __y._M_key; }
+
+  template <typename _KIt1, typename _MIt1, typename _KIt2, typename _MIt2>
+  inline bool
+  operator>(const _Flat_map_iterator<_KIt1, _MIt1>& __x,
+            const _Flat_map_iterator<_KIt2, _MIt2>& __y) { return __y._M_key < __x._M_key; }
+
+  template <typename _KIt1, typename _MIt1, typename _KIt2, typename _MIt2>
+  inline bool
+  operator<=(const _Flat_map_iterator<_KIt1, _MIt1>& __x,
+             const _Flat_map_iterator<_KIt2, _MIt2>& __y) { return !(__y._M_key < __x._M_key); }
+
+  template <typename _KIt1, typename _MIt1, typename _KIt2, typename _MIt2>
+  inline bool
+  operator>=(const _Flat_map_iterator<_KIt1, _MIt1>& __x,
+             const _Flat_map_iterator<_KIt2, _MIt2>& __y) { return !(__x._M_key < __y._M_key); }
+
+  template <typename _KIt1, typename _MIt1, typename _KIt2, typename _MIt2>
+  inline typename _Flat_map_iterator<_KIt1, _MIt1>::difference_type
+  operator-(const _Flat_map_iterator<_KIt1, _MIt1>& __x,
+            const _Flat_map_iterator<_KIt2, _MIt2>& __y) { return __x._M_key - __y._M_key; }
+
+  /**
+   *  @brief Common implementation of flat_map and flat_multimap.
+   *
+   *  Keys and mapped values are kept in two random access containers
+   *  (structure of arrays), both ordered by key, so a lookup only touches
+   *  the keys and a scan of keys() or values() is a plain array walk.
+   *  Insertion and erasure in the middle are O(size()); bulk insertion
+   *  appends and merges.
+  */
+  template <typename _Key, typename _Tp, typename _Compare,
+            typename _KeyContainer, typename _MappedContainer, bool _Multi>
+  class _Flat_map_impl {
+    static_assert(std::is_same<_Key, typename _KeyContainer::value_type>::value,
+                  "key_type must be the same as the key container's value_type");
+    static_assert(std::is_same<_Tp, typename _MappedContainer::value_type>::value,
+                  "mapped_type must be the same as the mapped container's value_type");
+
+  public:
+    typedef _Key key_type;
+    typedef _Tp mapped_type;
+    typedef std::pair<key_type, mapped_type> value_type;
+    typedef _Compare key_compare;
+    typedef std::pair<const key_type&, mapped_type&> reference;
+    typedef std::pair<const key_type&, const mapped_type&> const_reference;
+    typedef typename _KeyContainer::size_type size_type;
+    typedef typename _KeyContainer::difference_type difference_type;
+    typedef _Flat_map_iterator<typename _KeyContainer::const_iterator,
+                               typename _MappedContainer::iterator>
+        iterator;
+    typedef _Flat_map_iterator<typename _KeyContainer::const_iterator,
+                               typename _MappedContainer::const_iterator>
+        const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef _KeyContainer key_container_type;
+    typedef _MappedContainer mapped_container_type;
+
+    /// What extract() returns and replace() takes apart.
+    struct containers {
+      key_container_type keys;
+      mapped_container_type values;
+    };
+
+    class value_compare {
+      friend class _Flat_map_impl;
+
+    protected:
+      _Compare _M_comp;
+
+      value_compare(_Compare __c)
+          : _M_comp(__c) {}
+
+    public:
+      bool
+      operator()(const_reference __x, const_reference __y) const { return _M_comp(__x.first, __y.first); }
+    };
+
+  protected:
+    typedef typename std::conditional<_Multi, sorted_equivalent_t,
+                                      sorted_unique_t>::type _Sorted_t;
+    typedef typename std::conditional<_Multi, iterator,
+                                      std::pair<iterator, bool>>::type _Insert_return;
+
+    containers _M_c;
+    _Compare _M_comp;
+
+  public:
+    _Flat_map_impl()
+        : _M_c(), _M_comp() {}
+
+    explicit _Flat_map_impl(const _Compare& __comp)
+        : _M_c(), _M_comp(__comp) {}
+
+    /// Takes the two containers, which must have the same size, sorting
+    /// them by key and (for flat_map) keeping only the first element of
+    /// each run of equivalent keys.
+    _Flat_map_impl(key_container_type __keys, mapped_container_type __values,
+                   const _Compare& __comp = _Compare())
+        : _M_c{std::move(__keys), std::move(__values)}, _M_comp(__comp) {
+      __glibcxx_assert(_M_c.keys.size() == _M_c.values.size());
+      _M_sort_tail(0, false);
+    }
+
+    /// Takes the two containers as they are; the keys must already be
+    /// sorted (and unique for flat_map).
+    _Flat_map_impl(_Sorted_t, key_container_type __keys,
+                   mapped_container_type __values,
+                   const _Compare& __comp = _Compare())
+        : _M_c{std::move(__keys), std::move(__values)}, _M_comp(__comp) { __glibcxx_assert(_M_c.keys.size() == _M_c.values.size()); }
+
+    template <typename _InputIterator>
+    _Flat_map_impl(_InputIterator __first, _InputIterator __last,
+                   const _Compare& __comp = _Compare())
+        : _M_c(), _M_comp(__comp) { insert(__first, __last); }
+
+    template <typename _InputIterator>
+    _Flat_map_impl(_Sorted_t __s, _InputIterator __first, _InputIterator __last,
+                   const _Compare& __comp = _Compare())
+        : _M_c(), _M_comp(__comp) { insert(__s, __first, __last); }
+
+    _Flat_map_impl(std::initializer_list<value_type> __l,
+                   const _Compare& __comp = _Compare())
+        : _Flat_map_impl(__l.begin(), __l.end(), __comp) {}
+
+    _Flat_map_impl(_Sorted_t __s, std::initializer_list<value_type> __l,
+                   const _Compare& __comp = _Compare())
+        : _Flat_map_impl(__s, __l.begin(), __l.end(), __comp) {}
+
+    _Flat_map_impl&
+    operator=(std::initializer_list<value_type> __l) {
+      clear();
+      insert(__l);
+      return *this;
+    }
+
+    // iterators
+    iterator
+    begin() noexcept { return _M_iter(0); }
+
+    const_iterator
+    begin() const noexcept { return _M_iter(0); }
+
+    iterator
+    end() noexcept { return _M_iter(size()); }
+
+    const_iterator
+    end() const noexcept { return _M_iter(size()); }
+
+    reverse_iterator
+    rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator
+    rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator
+    rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator
+    rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator
+    cbegin() const noexcept { return begin(); }
+
+    const_iterator
+    cend() const noexcept { return end(); }
+
+    const_reverse_iterator
+    crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator
+    crend() const noexcept { return rend(); }
+
+    // capacity
+    bool
+    empty() const noexcept { return _M_c.keys.empty(); }
+
+    size_type
+    size() const noexcept { return _M_c.keys.size(); }
+
+    size_type
+    max_size() const noexcept { return std::min<size_type>(_M_c.keys.max_size(), _M_c.values.max_size()); }
+
+    // modifiers
+    template <typename... _Args>
+    _Insert_return
+    emplace(_Args&&... __args) {
+      value_type __v(std::forward<_Args>(__args)...);
+      return _S_result(_M_insert_kv(std::move(__v.first), std::move(__v.second)),
+                       std::integral_constant<bool, _Multi>());
+    }
+
+    template <typename... _Args>
+    iterator
+    emplace_hint(const_iterator __pos, _Args&&... __args) {
+      value_type __v(std::forward<_Args>(__args)...);
+      return _M_insert_hint(__pos, std::move(__v.first), std::move(__v.second));
+    }
+
+    _Insert_return
+    insert(const value_type& __x) { return emplace(__x); }
+
+    _Insert_return
+    insert(value_type&& __x) { return emplace(std::move(__x)); }
+
+    template <typename _Pair, typename = typename std::enable_if<std::is_constructible<value_type, _Pair>::value>::type>
+    _Insert_return
+    insert(_Pair&& __x) { return emplace(std::forward<_Pair>(__x)); }
+
+    iterator
+    insert(const_iterator __pos, const value_type& __x) { return emplace_hint(__pos, __x); }
+
+    iterator
+    insert(const_iterator __pos, value_type&& __x) { return emplace_hint(__pos, std::move(__x)); }
+
+    template <typename _Pair, typename = typename std::enable_if<std::is_constructible<value_type, _Pair>::value>::type>
+    iterator
+    insert(const_iterator __pos, _Pair&& __x) { return emplace_hint(__pos, std::forward<_Pair>(__x)); }
+
+    /// Appends [__first, __last), sorts the new elements and merges them
+    /// in: O(size() + N log N) instead of N separate O(size()) insertions.
+    template <typename _InputIterator>
+    void
+    insert(_InputIterator __first, _InputIterator __last) { _M_sort_tail(_M_append(__first, __last), false); }
+
+    /// Like insert(__first, __last) for a range already sorted by key
+    /// (and, for flat_map, unique), which makes the whole operation O(N).
+    template <typename _InputIterator>
+    void
+    insert(_Sorted_t, _InputIterator __first, _InputIterator __last) { _M_sort_tail(_M_append(__first, __last), true); }
+
+    void
+    insert(std::initializer_list<value_type> __l) { insert(__l.begin(), __l.end()); }
+
+    void
+    insert(_Sorted_t __s, std::initializer_list<value_type> __l) { insert(__s, __l.begin(), __l.end()); }
+
+    /// Moves the underlying containers out, leaving *this empty.
+    containers
+    extract() && {
+      containers __c = std::move(_M_c);
+      clear();
+      return __c;
+    }
+
+    /// Replaces the underlying containers; they must have the same size
+    /// and the keys must be sorted (and unique for flat_map).
+    void
+    replace(key_container_type&& __keys, mapped_container_type&& __values) {
+      __glibcxx_assert(__keys.size() == __values.size());
+      _M_c.keys = std::move(__keys);
+      _M_c.values = std::move(__values);
+    }
+
+    iterator
+    erase(iterator __pos) { return _M_erase(__pos - begin(), 1); }
+
+    iterator
+    erase(const_iterator __pos) { return _M_erase(__pos - cbegin(), 1); }
+
+    iterator
+    erase(const_iterator __first, const_iterator __last) { return _M_erase(__first - cbegin(), __last - __first); }
+
+    size_type
+    erase(const key_type& __x) {
+      std::pair<iterator, iterator> __p = equal_range(__x);
+      const size_type __n = __p.second - __p.first;
+      _M_erase(__p.first - begin(), __n);
+      return __n;
+    }
+
+    void
+    swap(_Flat_map_impl& __x) noexcept(std::__is_nothrow_swappable<_KeyContainer>::value&& std::__is_nothrow_swappable<_MappedContainer>::value&& std::__is_nothrow_swappable<_Compare>::value) {
+      using std::swap;
+      swap(_M_c.keys, __x._M_c.keys);
+      swap(_M_c.values, __x._M_c.values);
+      swap(_M_comp, __x._M_comp);
+    }
+
+    void
+    clear() noexcept {
+      _M_c.keys.clear();
+      _M_c.values.clear();
+    }
+
+    // observers
+    key_compare
+    key_comp() const { return _M_comp; }
+
+    value_compare
+    value_comp() const { return value_compare(_M_comp); }
+
+    const key_container_type&
+    keys() const noexcept { return _M_c.keys; }
+
+    const mapped_container_type&
+    values() const noexcept { return _M_c.values; }
+
+    // map operations
+    iterator
+    find(const key_type& __x) { return _M_iter(_M_find(__x)); }
+
+    const_iterator
+    find(const key_type& __x) const { return _M_iter(_M_find(__x)); }
+
+    size_type
+    count(const key_type& __x) const { return _M_count(__x); }
+
+    bool
+    contains(const key_type& __x) const { return _M_find(__x) != size(); }
+
+    iterator
+    lower_bound(const key_type& __x) { return _M_iter(_M_lower(__x)); }
+
+    const_iterator
+    lower_bound(const key_type& __x) const { return _M_iter(_M_lower(__x)); }
+
+    iterator
+    upper_bound(const key_type& __x) { return _M_iter(_M_upper(__x)); }
+
+    const_iterator
+    upper_bound(const key_type& __x) const { return _M_iter(_M_upper(__x)); }
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type& __x) {
+      const size_type __i = _M_lower(__x);
+      return std::pair<iterator, iterator>(_M_iter(__i), _M_iter(_M_upper(__x, __i)));
+    }
+
+    std::pair<const_iterator, const_iterator>
+    equal_range(const key_type& __x) const {
+      const size_type __i = _M_lower(__x);
+      return std::pair<const_iterator, const_iterator>(_M_iter(__i), _M_iter(_M_upper(__x, __i)));
+    }
+
+#if __cplusplus >= 201402L
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    iterator
+    find(const _Kt& __x) { return _M_iter(_M_find(__x)); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    const_iterator
+    find(const _Kt& __x) const { return _M_iter(_M_find(__x)); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    size_type
+    count(const _Kt& __x) const { return _M_count(__x); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    bool
+    contains(const _Kt& __x) const { return _M_find(__x) != size(); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    iterator
+    lower_bound(const _Kt& __x) { return _M_iter(_M_lower(__x)); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    const_iterator
+    lower_bound(const _Kt& __x) const { return _M_iter(_M_lower(__x)); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    iterator
+    upper_bound(const _Kt& __x) { return _M_iter(_M_upper(__x)); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    const_iterator
+    upper_bound(const _Kt& __x) const { return _M_iter(_M_upper(__x)); }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    std::pair<iterator, iterator>
+    equal_range(const _Kt& __x) {
+      const size_type __i = _M_lower(__x);
+      return std::pair<iterator, iterator>(_M_iter(__i), _M_iter(_M_upper(__x, __i)));
+    }
+
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    std::pair<const_iterator, const_iterator>
+    equal_range(const _Kt& __x) const {
+      const size_type __i = _M_lower(__x);
+      return std::pair<const_iterator, const_iterator>(_M_iter(__i), _M_iter(_M_upper(__x, __i)));
+    }
+#endif
+
+    friend bool
+    operator==(const _Flat_map_impl& __x, const _Flat_map_impl& __y) { return __x._M_c.keys == __y._M_c.keys && __x._M_c.values == __y._M_c.values; }
+
+    friend bool
+    operator<(const _Flat_map_impl& __x, const _Flat_map_impl& __y) { return std::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end()); }
+
+    friend bool
+    operator!=(const _Flat_map_impl& __x, const _Flat_map_impl& __y) { return !(__x == __y); }
+
+    friend bool
+    operator>(const _Flat_map_impl& __x, const _Flat_map_impl& __y) { return __y < __x; }
+
+    friend bool
+    operator<=(const _Flat_map_impl& __x, const _Flat_map_impl& __y) { return !(__y < __x); }
+
+    friend bool
+    operator>=(const _Flat_map_impl& __x, const _Flat_map_impl& __y) { return !(__x < __y); }
+
+  protected:
+    // Members only flat_map exposes, since they assume unique keys.
+
+    mapped_type&
+    operator[](const key_type& __k) { return try_emplace(__k).first->second; }
+
+    mapped_type&
+    operator[](key_type&& __k) { return try_emplace(std::move(__k)).first->second; }
+
+    mapped_type&
+    at(const key_type& __k) {
+      const size_type __i = _M_find(__k);
+      if (__i == size())
+        std::__throw_out_of_range(__N("flat_map::at"));
+      return _M_c.values[__i];
+    }
+
+    const mapped_type&
+    at(const key_type& __k) const {
+      const size_type __i = _M_find(__k);
+      if (__i == size())
+        std::__throw_out_of_range(__N("flat_map::at"));
+      return _M_c.values[__i];
+    }
+
+    template <typename... _Args>
+    std::pair<iterator, bool>
+    try_emplace(const key_type& __k, _Args&&... __args) { return _M_try_emplace(__k, std::forward<_Args>(__args)...); }
+
+    template <typename... _Args>
+    std::pair<iterator, bool>
+    try_emplace(key_type&& __k, _Args&&... __args) { return _M_try_emplace(std::move(__k), std::forward<_Args>(__args)...); }
+
+    template <typename... _Args>
+    iterator
+    try_emplace(const_iterator __pos, const key_type& __k, _Args&&... __args) { return _M_try_emplace_hint(__pos, __k, std::forward<_Args>(__args)...); }
+
+    template <typename... _Args>
+    iterator
+    try_emplace(const_iterator __pos, key_type&& __k, _Args&&... __args) { return _M_try_emplace_hint(__pos, std::move(__k), std::forward<_Args>(__args)...); }
+
+    template <typename _Obj>
+    std::pair<iterator, bool>
+    insert_or_assign(const key_type& __k, _Obj&& __obj) { return _M_insert_or_assign(__k, std::forward<_Obj>(__obj)); }
+
+    template <typename _Obj>
+    std::pair<iterator, bool>
+    insert_or_assign(key_type&& __k, _Obj&& __obj) { return _M_insert_or_assign(std::move(__k), std::forward<_Obj>(__obj)); }
+
+    template <typename _Obj>
+    iterator
+    insert_or_assign(const_iterator __pos, const key_type& __k, _Obj&& __obj) { return _M_insert_or_assign_hint(__pos, __k, std::forward<_Obj>(__obj)); }
+
+    template <typename _Obj>
+    iterator
+    insert_or_assign(const_iterator __pos, key_type&& __k, _Obj&& __obj) { return _M_insert_or_assign_hint(__pos, std::move(__k), std::forward<_Obj>(__obj)); }
+
+    template <typename _Kt, typename... _Args>
+    std::pair<iterator, bool>
+    _M_try_emplace(_Kt&& __k, _Args&&... __args) {
+      const size_type __i = _M_lower(__k);
+      if (__i != size() && !_M_comp(__k, _M_c.keys[__i]))
+        return std::pair<iterator, bool>(_M_iter(__i), false);
+      return std::pair<iterator, bool>(_M_insert_at(__i, std::forward<_Kt>(__k), std::forward<_Args>(__args)...), true);
+    }
+
+    template <typename _Kt, typename... _Args>
+    iterator
+    _M_try_emplace_hint(const_iterator __pos, _Kt&& __k, _Args&&... __args) {
+      const size_type __i = __pos - cbegin();
+      if ((__i == 0 || _M_comp(_M_c.keys[__i - 1], __k)) && (__i == size() || _M_comp(__k, _M_c.keys[__i])))
+        return _M_insert_at(__i, std::forward<_Kt>(__k), std::forward<_Args>(__args)...);
+      return _M_try_emplace(std::forward<_Kt>(__k), std::forward<_Args>(__args)...).first;
+    }
+
+    template <typename _Kt, typename _Obj>
+    std::pair<iterator, bool>
+    _M_insert_or_assign(_Kt&& __k, _Obj&& __obj) {
+      const size_type __i = _M_lower(__k);
+      if (__i != size() && !_M_comp(__k, _M_c.keys[__i])) {
+        _M_c.values[__i] = std::forward<_Obj>(__obj);
+        return std::pair<iterator, bool>(_M_iter(__i), false);
+      }
+      return std::pair<iterator, bool>(_M_insert_at(__i, std::forward<_Kt>(__k), std::forward<_Obj>(__obj)), true);
+    }
+
+    template <typename _Kt, typename _Obj>
+    iterator
+    _M_insert_or_assign_hint(const_iterator __pos, _Kt&& __k, _Obj&& __obj) {
+      const size_type __i = __pos - cbegin();
+      if ((__i == 0 || _M_comp(_M_c.keys[__i - 1], __k)) && (__i == size() || _M_comp(__k, _M_c.keys[__i])))
+        return _M_insert_at(__i, std::forward<_Kt>(__k), std::forward<_Obj>(__obj));
+      return _M_insert_or_assign(std::forward<_Kt>(__k), std::forward<_Obj>(__obj)).first;
+    }
+
+    iterator
+    _M_iter(size_type __i) noexcept { return iterator(_M_c.keys.cbegin() + __i, _M_c.values.begin() + __i); }
+
+    const_iterator
+    _M_iter(size_type __i) const noexcept { return const_iterator(_M_c.keys.cbegin() + __i, _M_c.values.cbegin() + __i); }
+
+    static std::pair<iterator, bool>
+    _S_result(std::pair<iterator, bool> __r, std::false_type) { return __r; }
+
+    static iterator
+    _S_result(std::pair<iterator, bool> __r, std::true_type) { return __r.first; }
+
+    template <typename _Kt>
+    size_type
+    _M_lower(const _Kt& __x) const { return __flat_lower_bound(_M_c.keys.begin(), _M_c.keys.end(), __x, _M_comp) - _M_c.keys.begin(); }
+
+    template <typename _Kt>
+    size_type
+    _M_upper(const _Kt& __x, size_type __from = 0) const { return __flat_upper_bound(_M_c.keys.begin() + __from, _M_c.keys.end(), __x, _M_comp) - _M_c.keys.begin(); }
+
+    // Index of an element with key equivalent to __x, or size().
+    template <typename _Kt>
+    size_type
+    _M_find(const _Kt& __x) const {
+      const size_type __i = _M_lower(__x);
+      return (__i == size() || _M_comp(__x, _M_c.keys[__i])) ? size() : __i;
+    }
+
+    template <typename _Kt>
+    size_type
+    _M_count(const _Kt& __x) const {
+      const size_type __i = _M_lower(__x);
+      if (!_Multi)
+        return __i != size() && !_M_comp(__x, _M_c.keys[__i]);
+      return _M_upper(__x, __i) - __i;
+    }
+
+    // Inserts the key and a mapped value built from __args at index __i.
+    // If the second insertion throws the key is taken out again, so the
+    // containers never get out of step.
+    template <typename _Kt, typename... _Args>
+    iterator
+    _M_insert_at(size_type __i, _Kt&& __k, _Args&&... __args) {
+      _M_c.keys.insert(_M_c.keys.begin() + __i, std::forward<_Kt>(__k));
+      try {
+        _M_c.values.emplace(_M_c.values.begin() + __i, std::forward<_Args>(__args)...);
+      }
+      catch(...) {
+        _M_c.keys.erase(_M_c.keys.begin() + __i);
+        throw;
+      }
+      return _M_iter(__i);
+    }
+
+    // Equivalent keys go after the existing ones, as in _Rb_tree.
+    std::pair<iterator, bool>
+    _M_insert_kv(key_type&& __k, mapped_type&& __m) {
+      if (_Multi)
+        return std::pair<iterator, bool>(_M_insert_at(_M_upper(__k), std::move(__k), std::move(__m)), true);
+      return _M_try_emplace(std::move(__k), std::move(__m));
+    }
+
+    // Uses __pos when it is the right place for the key, like the hinted
+    // _Rb_tree insertions, and falls back to a search otherwise.
+    iterator
+    _M_insert_hint(const_iterator __pos, key_type&& __k, mapped_type&& __m) {
+      const size_type __i = __pos - cbegin();
+      const bool __after_prev = __i == 0 || (_Multi ? !_M_comp(__k, _M_c.keys[__i - 1]) : _M_comp(_M_c.keys[__i - 1], __k));
+      const bool __before_next = __i == size() || (_Multi ? !_M_comp(_M_c.keys[__i], __k) : _M_comp(__k, _M_c.keys[__i]));
+      if (__after_prev && __before_next)
+        return _M_insert_at(__i, std::move(__k), std::move(__m));
+      return _M_insert_kv(std::move(__k), std::move(__m)).first;
+    }
+
+    iterator
+    _M_erase(size_type __i, size_type __n) {
+      _M_c.keys.erase(_M_c.keys.begin() + __i, _M_c.keys.begin() + (__i + __n));
+      _M_c.values.erase(_M_c.values.begin() + __i, _M_c.values.begin() + (__i + __n));
+      return _M_iter(__i);
+    }
+
+    // Appends [__first, __last) to both containers and returns the old
+    // size.  On an exception both are cleared.
+    template <typename _InputIterator>
+    size_type
+    _M_append(_InputIterator __first, _InputIterator __last) {
+      const size_type __n = size();
+      try {
+        for (; __first != __last; ++__first) {
+          value_type __v(*__first);
+          _M_c.keys.insert(_M_c.keys.end(), std::move(__v.first));
+          _M_c.values.insert(_M_c.values.end(), std::move(__v.second));
+        }
+      }
+      catch(...) {
+        clear();
+        throw;
+      }
+      return __n;
+    }
+
+    void
+    _M_sort_tail(size_type __n, bool __sorted);
+  };
+
+  /**
+   *  Restores the invariant after elements were appended at index __n:
+   *  sorts them unless __sorted, merges them with the old ones and, for
+   *  flat_map, drops all but the first of each run of equivalent keys, so
+   *  existing elements win over new ones.
+   *
+   *  Keys and mapped values have to be permuted together, so the merge is
+   *  done on an index vector and both containers are then rebuilt in that
+   *  order.  The common case of a sorted range that belongs after every
+   *  existing key costs nothing beyond the append.  If anything throws
+   *  the containers are cleared rather than left unsorted.
+  */
+  template <typename _Key, typename _Tp, typename _Compare,
+            typename _KeyContainer, typename _MappedContainer, bool _Multi>
+  void
+  _Flat_map_impl<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer, _Multi>::
+      _M_sort_tail(size_type __n, bool __sorted) {
+    const size_type __len = size();
+    if (__n == __len)
+      return;
+
+    const key_container_type& __keys = _M_c.keys;
+    const _Compare& __comp = _M_comp;
+    if (__sorted && (__n == 0 || (_Multi ? !__comp(__keys[__n], __keys[__n - 1]) : __comp(__keys[__n - 1], __keys[__n]))))
+      return;
+
+    try {
+      std::vector<size_type> __idx(__len);
+      for (size_type __i = 0; __i < __len; ++__i)
+        __idx[__i] = __i;
+      auto __by_key = [&__keys, &__comp](size_type __a, size_type __b) { return __comp(__keys[__a], __keys[__b]); };
+      if (!__sorted)
+        std::stable_sort(__idx.begin() + __n, __idx.end(), __by_key);
+
+      std::vector<size_type> __order;
+      __order.reserve(__len);
+      std::merge(__idx.begin(), __idx.begin() + __n, __idx.begin() + __n, __idx.end(),
+                 std::back_inserter(__order), __by_key);
+      if (!_Multi)
+        __order.erase(std::unique(__order.begin(), __order.end(),
+                                  [&__keys, &__comp](size_type __a, size_type __b) { return !__comp(__keys[__a], __keys[__b]); }),
+                      __order.end());
+
+      containers __c;
+      for (size_type __i : __order) {
+        __c.keys.insert(__c.keys.end(), std::move(_M_c.keys[__i]));
+        __c.values.insert(__c.values.end(), std::move(_M_c.values[__i]));
+      }
+      _M_c = std::move(__c);
+    }
+    catch(...) {
+      clear();
+      throw;
+    }
+  }
+
+  /**
+   *  @brief A map with unique keys stored as two sorted sequences.
+   *
+   *  @tparam _Key  Type of key objects.
+   *  @tparam _Tp  Type of mapped objects.
+   *  @tparam _Compare  Comparison function object type.
+   *  @tparam _KeyContainer  Random access container holding the keys.
+   *  @tparam _MappedContainer  Random access container holding the mapped
+   *  values.
+   *
+   *  Meets the interface of std::map apart from node handles, with
+   *  pair<const key_type&, mapped_type&> as its reference type, and adds
+   *  the sorted_unique overloads, keys()/values(), and extract() and
+   *  replace() for the underlying containers.  Insertions and erasures
+   *  invalidate all iterators.
+  */
+  template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>,
+            typename _KeyContainer = std::vector<_Key>,
+            typename _MappedContainer = std::vector<_Tp>>
+  class flat_map
+      : public _Flat_map_impl<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer, false> {
+    typedef _Flat_map_impl<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer, false> _Base;
+
+  public:
+    using _Base::_Base;
+    using _Base::operator[];
+    using _Base::at;
+    using _Base::try_emplace;
+    using _Base::insert_or_assign;
+
+    flat_map() = default;
+
+    flat_map&
+    operator=(std::initializer_list<typename _Base::value_type> __l) {
+      _Base::operator=(__l);
+      return *this;
+    }
+
+    void
+    swap(flat_map& __x) noexcept(noexcept(__x._Base::swap(__x))) { _Base::swap(__x); }
+  };
+
+  /**
+   *  @brief A map with possibly equivalent keys stored as two sorted
+   *  sequences.
+   *
+   *  Like flat_map without operator[], at(), try_emplace() and
+   *  insert_or_assign(); equivalent keys stay in insertion order, and
+   *  sorted_equivalent replaces sorted_unique.
+  */
+  template <typename _Key, typename _Tp, typename _Compare = std::less<_Key>,
+            typename _KeyContainer = std::vector<_Key>,
+            typename _MappedContainer = std::vector<_Tp>>
+  class flat_multimap
+      : public _Flat_map_impl<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer, true> {
+    typedef _Flat_map_impl<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer, true> _Base;
+
+  public:
+    using _Base::_Base;
+
+    flat_multimap() = default;
+
+    flat_multimap&
+    operator=(std::initializer_list<typename _Base::value_type> __l) {
+      _Base::operator=(__l);
+      return *this;
+    }
+
+    void
+    swap(flat_multimap& __x) noexcept(noexcept(__x._Base::swap(__x))) { _Base::swap(__x); }
+  };
+
+  template <typename _Key, typename _Tp, typename _Compare,
+            typename _KeyContainer, typename _MappedContainer>
+  inline void
+  swap(flat_map<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer>& __x,
+       flat_map<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer>& __y) noexcept(noexcept(__x.swap(__y))) { __x.swap(__y); }
+
+  template <typename _Key, typename _Tp, typename _Compare,
+            typename _KeyContainer, typename _MappedContainer>
+  inline void
+  swap(flat_multimap<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer>& __x,
+       flat_multimap<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer>& __y) noexcept(noexcept(__x.swap(__y))) { __x.swap(__y); }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++11
+
+#endif // _FLAT_MAP_H
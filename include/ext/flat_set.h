@@ -0,0 +1,487 @@
+// Sorted-vector sets -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/flat_set.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _FLAT_SET_H
+#define _FLAT_SET_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <ext/flat_tree.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief Common implementation of flat_set and flat_multiset.
+   *
+   *  The keys are kept sorted in a random access container, by default a
+   *  std::vector, so lookups are binary searches over contiguous memory
+   *  and iteration is a linear scan.  Insertion and erasure in the middle
+   *  are O(size()); bulk insertion appends and merges.
+  */
+  template <typename _Key, typename _Compare, typename _KeyContainer, bool _Multi>
+  class _Flat_set_impl {
+    static_assert(std::is_same<_Key, typename _KeyContainer::value_type>::value,
+                  "value_type must be the same as the container's value_type");
+
+    typedef typename _KeyContainer::iterator _Cont_iterator;
+
+  public:
+    typedef _Key key_type;
+    typedef _Key value_type;
+    typedef _Compare key_compare;
+    typedef _Compare value_compare;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef typename _KeyContainer::size_type size_type;
+    typedef typename _KeyContainer::difference_type difference_type;
+    typedef typename _KeyContainer::const_iterator iterator;
+    typedef typename _KeyContainer::const_iterator const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef _KeyContainer container_type;
+
+  protected:
+    typedef typename std::conditional<_Multi, sorted_equivalent_t,
+                                      sorted_unique_t>::type _Sorted_t;
+    typedef typename std::conditional<_Multi, iterator,
+                                      std::pair<iterator, bool>>::type _Insert_return;
+
+    _KeyContainer _M_cont;
+    _Compare _M_comp;
+
+  public:
+    _Flat_set_impl()
+        : _M_cont(), _M_comp() {}
+
+    explicit _Flat_set_impl(const _Compare& __comp)
+        : _M_cont(), _M_comp(__comp) {}
+
+    /// Takes the keys of @a __cont, sorting them and (for flat_set)
+    /// dropping all but the first of each run of equivalent keys.
+    explicit _Flat_set_impl(container_type __cont,
+                            const _Compare& __comp = _Compare())
+        : _M_cont(std::move(__cont)), _M_comp(__comp) { _M_sort_tail(0, false); }
+
+    /// Takes @a __cont as is; it must already be sorted (and unique for
+    /// flat_set).
+    _Flat_set_impl(_Sorted_t, container_type __cont,
+                   const _Compare& __comp = _Compare())
+        : _M_cont(std::move(__cont)), _M_comp(__comp) {}
+
+    template <typename _InputIterator>
+    _Flat_set_impl(_InputIterator __first, _InputIterator __last,
+                   const _Compare& __comp = _Compare())
+        : _M_cont(), _M_comp(__comp) { insert(__first, __last); }
+
+    template <typename _InputIterator>
+    _Flat_set_impl(_Sorted_t __s, _InputIterator __first, _InputIterator __last,
+                   const _Compare& __comp = _Compare())
+        : _M_cont(), _M_comp(__comp) { insert(__s, __first, __last); }
+
+    _Flat_set_impl(std::initializer_list<value_type> __l,
+                   const _Compare& __comp = _Compare())
+        : _Flat_set_impl(__l.begin(), __l.end(), __comp) {}
+
+    _Flat_set_impl(_Sorted_t __s, std::initializer_list<value_type> __l,
+                   const _Compare& __comp = _Compare())
+        : _Flat_set_impl(__s, __l.begin(), __l.end(), __comp) {}
+
+    _Flat_set_impl&
+    operator=(std::initializer_list<value_type> __l) {
+      clear();
+      insert(__l);
+      return *this;
+    }
+
+    // iterators
+    iterator
+    begin() const noexcept { return _M_cont.begin(); }
+
+    iterator
+    end() const noexcept { return _M_cont.end(); }
+
+    reverse_iterator
+    rbegin() const noexcept { return reverse_iterator(end()); }
+
+    reverse_iterator
+    rend() const noexcept { return reverse_iterator(begin()); }
+
+    iterator
+    cbegin() const noexcept { return begin(); }
+
+    iterator
+    cend() const noexcept { return end(); }
+
+    reverse_iterator
+    crbegin() const noexcept { return rbegin(); }
+
+    reverse_iterator
+    crend() const noexcept { return rend(); }
+
+    // capacity
+    bool
+    empty() const noexcept { return _M_cont.empty(); }
+
+    size_type
+    size() const noexcept { return _M_cont.size(); }
+
+    size_type
+    max_size() const noexcept { return _M_cont.max_size(); }
+
+    // modifiers
+    template <typename... _Args>
+    _Insert_return
+    emplace(_Args&&... __args) {
+      return _S_result(_M_insert_value(value_type(std::forward<_Args>(__args)...)),
+                       std::integral_constant<bool, _Multi>());
+    }
+
+    template <typename... _Args>
+    iterator
+    emplace_hint(const_iterator __pos, _Args&&... __args) { return _M_insert_hint(__pos, value_type(std::forward<_Args>(__args)...)); }
+
+    _Insert_return
+    insert(const value_type& __x) { return _S_result(_M_insert_value(__x), std::integral_constant<bool, _Multi>()); }
+
+    _Insert_return
+    insert(value_type&& __x) { return _S_result(_M_insert_value(std::move(__x)), std::integral_constant<bool, _Multi>()); }
+
+    iterator
+    insert(const_iterator __pos, const value_type& __x) { return _M_insert_hint(__pos, __x); }
+
+    iterator
+    insert(const_iterator __pos, value_type&& __x) { return _M_insert_hint(__pos, std::move(__x)); }
+
+    /// Appends [__first, __last), sorts the new keys and merges them in:
+    /// O(size() + N log N) instead of N separate O(size()) insertions.
+    template <typename _InputIterator>
+    void
+    insert(_InputIterator __first, _InputIterator __last) {
+      const size_type __n = size();
+      _M_cont.insert(_M_cont.end(), __first, __last);
+      _M_sort_tail(__n, false);
+    }
+
+    /// Like insert(__first, __last) for an already sorted (and, for
+    /// flat_set, unique) range, which makes the whole operation O(N).
+    template <typename _InputIterator>
+    void
+    insert(_Sorted_t, _InputIterator __first, _InputIterator __last) {
+      const size_type __n = size();
+      _M_cont.insert(_M_cont.end(), __first, __last);
+      _M_sort_tail(__n, true);
+    }
+
+    void
+    insert(std::initializer_list<value_type> __l) { insert(__l.begin(), __l.end()); }
+
+    void
+    insert(_Sorted_t __s, std::initializer_list<value_type> __l) { insert(__s, __l.begin(), __l.end()); }
+
+    /// Moves the underlying container out, leaving *this empty.
+    container_type
+    extract() && {
+      container_type __cont = std::move(_M_cont);
+      _M_cont.clear();
+      return __cont;
+    }
+
+    /// Replaces the underlying container; @a __cont must be sorted (and
+    /// unique for flat_set).
+    void
+    replace(container_type&& __cont) { _M_cont = std::move(__cont); }
+
+    iterator
+    erase(const_iterator __pos) { return _M_cont.erase(__pos); }
+
+    iterator
+    erase(const_iterator __first, const_iterator __last) { return _M_cont.erase(__first, __last); }
+
+    size_type
+    erase(const key_type& __x) {
+      std::pair<iterator, iterator> __p = equal_range(__x);
+      const size_type __n = __p.second - __p.first;
+      _M_cont.erase(__p.first, __p.second);
+      return __n;
+    }
+
+    void
+    swap(_Flat_set_impl& __x) noexcept(std::__is_nothrow_swappable<_KeyContainer>::value&& std::__is_nothrow_swappable<_Compare>::value) {
+      using std::swap;
+      swap(_M_cont, __x._M_cont);
+      swap(_M_comp, __x._M_comp);
+    }
+
+    void
+    clear() noexcept { _M_cont.clear(); }
+
+    // observers
+    key_compare
+    key_comp() const { return _M_comp; }
+
+    value_compare
+    value_comp() const { return _M_comp; }
+
+    // set operations
+    iterator
+    find(const key_type& __x) const { return _M_find(__x); }
+
+#if __cplusplus >= 201402L
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    iterator
+    find(const _Kt& __x) const { return _M_find(__x); }
+#endif
+
+    size_type
+    count(const key_type& __x) const { return _M_count(__x); }
+
+#if __cplusplus >= 201402L
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    size_type
+    count(const _Kt& __x) const { return _M_count(__x); }
+#endif
+
+    bool
+    contains(const key_type& __x) const { return _M_find(__x) != end(); }
+
+#if __cplusplus >= 201402L
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    bool
+    contains(const _Kt& __x) const { return _M_find(__x) != end(); }
+#endif
+
+    iterator
+    lower_bound(const key_type& __x) const { return __flat_lower_bound(begin(), end(), __x, _M_comp); }
+
+#if __cplusplus >= 201402L
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    iterator
+    lower_bound(const _Kt& __x) const { return __flat_lower_bound(begin(), end(), __x, _M_comp); }
+#endif
+
+    iterator
+    upper_bound(const key_type& __x) const { return __flat_upper_bound(begin(), end(), __x, _M_comp); }
+
+#if __cplusplus >= 201402L
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    iterator
+    upper_bound(const _Kt& __x) const { return __flat_upper_bound(begin(), end(), __x, _M_comp); }
+#endif
+
+    std::pair<iterator, iterator>
+    equal_range(const key_type& __x) const { return _M_equal_range(__x); }
+
+#if __cplusplus >= 201402L
+    template <typename _Kt, typename _Req = std::__has_is_transparent_t<_Compare, _Kt>>
+    std::pair<iterator, iterator>
+    equal_range(const _Kt& __x) const { return _M_equal_range(__x); }
+#endif
+
+    friend bool
+    operator==(const _Flat_set_impl& __x, const _Flat_set_impl& __y) { return __x._M_cont == __y._M_cont; }
+
+    friend bool
+    operator<(const _Flat_set_impl& __x, const _Flat_set_impl& __y) { return std::lexicographical_compare(__x.begin(), __x.end(), __y.begin(), __y.end()); }
+
+    friend bool
+    operator!=(const _Flat_set_impl& __x, const _Flat_set_impl& __y) { return !(__x == __y); }
+
+    friend bool
+    operator>(const _Flat_set_impl& __x, const _Flat_set_impl& __y) { return __y < __x; }
+
+    friend bool
+    operator<=(const _Flat_set_impl& __x, const _Flat_set_impl& __y) { return !(__y < __x); }
+
+    friend bool
+    operator>=(const _Flat_set_impl& __x, const _Flat_set_impl& __y) { return !(__x < __y); }
+
+  protected:
+    static std::pair<iterator, bool>
+    _S_result(std::pair<iterator, bool> __r, std::false_type) { return __r; }
+
+    static iterator
+    _S_result(std::pair<iterator, bool> __r, std::true_type) { return __r.first; }
+
+    template <typename _Kt>
+    iterator
+    _M_find(const _Kt& __x) const {
+      const iterator __i = lower_bound(__x);
+      return (__i == end() || _M_comp(__x, *__i)) ? end() : __i;
+    }
+
+    template <typename _Kt>
+    size_type
+    _M_count(const _Kt& __x) const {
+      if (!_Multi)
+        return _M_find(__x) != end();
+      std::pair<iterator, iterator> __p = _M_equal_range(__x);
+      return __p.second - __p.first;
+    }
+
+    template <typename _Kt>
+    std::pair<iterator, iterator>
+    _M_equal_range(const _Kt& __x) const {
+      const iterator __i = lower_bound(__x);
+      return std::pair<iterator, iterator>(__i, __flat_upper_bound(__i, end(), __x, _M_comp));
+    }
+
+    // Equivalent keys go after the existing ones, as in _Rb_tree.
+    template <typename _Arg>
+    std::pair<iterator, bool>
+    _M_insert_value(_Arg&& __x) {
+      iterator __i;
+      if (_Multi)
+        __i = upper_bound(__x);
+      else {
+        __i = lower_bound(__x);
+        if (__i != end() && !_M_comp(__x, *__i))
+          return std::pair<iterator, bool>(__i, false);
+      }
+      return std::pair<iterator, bool>(_M_cont.insert(__i, std::forward<_Arg>(__x)), true);
+    }
+
+    // Uses __pos when it is the right place for __x, like the hinted
+    // _Rb_tree insertions, and falls back to a search otherwise.
+    template <typename _Arg>
+    iterator
+    _M_insert_hint(const_iterator __pos, _Arg&& __x) {
+      const bool __after_prev = __pos == begin() || (_Multi ? !_M_comp(__x, *(__pos - 1)) : _M_comp(*(__pos - 1), __x));
+      const bool __before_next = __pos == end() || (_Multi ? !_M_comp(*__pos, __x) : _M_comp(__x, *__pos));
+      if (__after_prev && __before_next)
+        return _M_cont.insert(__pos, std::forward<_Arg>(__x));
+      return _M_insert_value(std::forward<_Arg>(__x)).first;
+    }
+
+    // Restores the invariant after elements were appended at position
+    // __n: sorts them unless __sorted, merges them with the old ones and
+    // drops duplicates for flat_set.  Elements that compare equivalent
+    // keep their order, so existing keys win over new ones.  If anything
+    // throws the container is cleared rather than left unsorted.
+    void
+    _M_sort_tail(size_type __n, bool __sorted) {
+      const _Cont_iterator __first = _M_cont.begin();
+      const _Cont_iterator __mid = __first + __n;
+      const _Cont_iterator __last = _M_cont.end();
+      try {
+        if (!__sorted)
+          std::stable_sort(__mid, __last, _M_comp);
+        if (__n != 0 && __mid != __last && _M_comp(*__mid, *(__mid - 1)))
+          std::inplace_merge(__first, __mid, __last, _M_comp);
+        if (!_Multi) {
+          _Compare& __comp = _M_comp;
+          _M_cont.erase(std::unique(__first, __last,
+                                    [&__comp](const value_type& __a, const value_type& __b) { return !__comp(__a, __b); }),
+                        __last);
+        }
+      }
+      catch(...) {
+        _M_cont.clear();
+        throw;
+      }
+    }
+  };
+
+  /**
+   *  @brief A set of unique keys stored as a sorted sequence.
+   *
+   *  @tparam _Key  Type of key objects.
+   *  @tparam _Compare  Comparison function object type.
+   *  @tparam _KeyContainer  Random access container holding the keys.
+   *
+   *  Meets the interface of std::set apart from node handles, and adds
+   *  the sorted_unique overloads plus extract() and replace() for the
+   *  underlying container.  Insertions and erasures invalidate all
+   *  iterators.
+  */
+  template <typename _Key, typename _Compare = std::less<_Key>,
+            typename _KeyContainer = std::vector<_Key>>
+  class flat_set : public _Flat_set_impl<_Key, _Compare, _KeyContainer, false> {
+    typedef _Flat_set_impl<_Key, _Compare, _KeyContainer, false> _Base;
+
+  public:
+    using _Base::_Base;
+
+    flat_set() = default;
+
+    flat_set&
+    operator=(std::initializer_list<_Key> __l) {
+      _Base::operator=(__l);
+      return *this;
+    }
+
+    void
+    swap(flat_set& __x) noexcept(noexcept(__x._Base::swap(__x))) { _Base::swap(__x); }
+  };
+
+  /**
+   *  @brief A set of possibly equivalent keys stored as a sorted sequence.
+   *
+   *  Like flat_set, but keeps equivalent keys in insertion order, and
+   *  takes sorted_equivalent instead of sorted_unique.
+  */
+  template <typename _Key, typename _Compare = std::less<_Key>,
+            typename _KeyContainer = std::vector<_Key>>
+  class flat_multiset : public _Flat_set_impl<_Key, _Compare, _KeyContainer, true> {
+    typedef _Flat_set_impl<_Key, _Compare, _KeyContainer, true> _Base;
+
+  public:
+    using _Base::_Base;
+
+    flat_multiset() = default;
+
+    flat_multiset&
+    operator=(std::initializer_list<_Key> __l) {
+      _Base::operator=(__l);
+      return *this;
+    }
+
+    void
+    swap(flat_multiset& __x) noexcept(noexcept(__x._Base::swap(__x))) { _Base::swap(__x); }
+  };
+
+  template <typename _Key, typename _Compare, typename _KeyContainer>
+  inline void
+  swap(flat_set<_Key, _Compare, _KeyContainer>& __x,
+       flat_set<_Key, _Compare, _KeyContainer>& __y) noexcept(noexcept(__x.swap(__y))) { __x.swap(__y); }
+
+  template <typename _Key, typename _Compare, typename _KeyContainer>
+  inline void
+  swap(flat_multiset<_Key, _Compare, _KeyContainer>& __x,
+       flat_multiset<_Key, _Compare, _KeyContainer>& __y) noexcept(noexcept(__x.swap(__y))) { __x.swap(__y); }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++11
+
+#endif // _FLAT_SET_H
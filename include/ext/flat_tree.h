@@ -0,0 +1,111 @@
+// Common parts of the flat associative containers -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/flat_tree.h
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/flat_map.h, ext/flat_set.h}
+ */
+
+#ifndef _FLAT_TREE_H
+#define _FLAT_TREE_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <bits/stl_tree.h> // for __has_is_transparent_t
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Tag telling a flat_set or flat_map that a range or container is
+  /// already sorted and free of equivalent keys.
+  struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+  };
+
+  constexpr sorted_unique_t sorted_unique{};
+
+  /// Tag telling a flat_multiset or flat_multimap that a range or
+  /// container is already sorted.
+  struct sorted_equivalent_t {
+    explicit sorted_equivalent_t() = default;
+  };
+
+  constexpr sorted_equivalent_t sorted_equivalent{};
+
+  /**
+   *  @brief Branchless std::lower_bound for random access iterators.
+   *
+   *  Every step halves the range and moves its start with a conditional
+   *  add rather than a branch, so the loop compiles to cmov and runs a
+   *  fixed number of iterations for a given length; for the small tables
+   *  the flat containers are meant for that beats a mispredicted branch
+   *  per level.
+  */
+  template <typename _RandomAccessIterator, typename _Tp, typename _Compare>
+  _RandomAccessIterator
+  __flat_lower_bound(_RandomAccessIterator __first, _RandomAccessIterator __last,
+                     const _Tp& __val, _Compare& __comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _Distance;
+
+    // Invariant: the result lies in [__first, __first + __len].
+    _Distance __len = __last - __first;
+    while (__len > 0) {
+      const _Distance __half = __len / 2;
+      __first += __comp(__first[__half], __val) ? __len - __half : 0;
+      __len = __half;
+    }
+    return __first;
+  }
+
+  /// Branchless std::upper_bound, see __flat_lower_bound.
+  template <typename _RandomAccessIterator, typename _Tp, typename _Compare>
+  _RandomAccessIterator
+  __flat_upper_bound(_RandomAccessIterator __first, _RandomAccessIterator __last,
+                     const _Tp& __val, _Compare& __comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _Distance;
+
+    _Distance __len = __last - __first;
+    while (__len > 0) {
+      const _Distance __half = __len / 2;
+      __first += __comp(__val, __first[__half]) ? 0 : __len - __half;
+      __len = __half;
+    }
+    return __first;
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++11
+
+#endif // _FLAT_TREE_H
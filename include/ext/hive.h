@@ -0,0 +1,567 @@
+// Bucketed container with stable element addresses -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/hive.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _HIVE_H
+#define _HIVE_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <bits/functexcept.h>
+#include <bits/stl_algobase.h>
+#include <bits/stl_iterator.h>
+#include <ext/alloc_traits.h>
+#include <initializer_list>
+#include <memory>
+
+#include <debug/assertions.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  A block of a hive: _M_capacity slots, each holding either an element
+   *  or nothing, plus a skip field that lets iteration jump over runs of
+   *  empty slots.
+   *
+   *  The skip field uses the jump-counting scheme: an occupied slot has
+   *  skip 0, and the first and last slot of every maximal run of empty
+   *  slots hold the length of the run (the slots in between are not kept
+   *  up to date).  _M_skip has one extra, always zero, entry so the slot
+   *  after the last one can be examined freely.
+   *
+   *  The first slot of every run is also a node in a doubly linked free
+   *  list, threaded through the empty slots themselves, which is where
+   *  insertions go before the end of the hive is extended.
+  */
+  template <typename _Tp>
+  struct _Hive_block {
+    typedef unsigned short _Skip_t;
+
+    // Marks the end of a free list.
+    static constexpr _Skip_t _S_none = _Skip_t(-1);
+
+    struct _Free_links {
+      _Skip_t _M_prev;
+      _Skip_t _M_next;
+    };
+
+    struct _Slot {
+      alignas(_Tp) alignas(_Free_links) unsigned char _M_bytes[sizeof(_Tp) > sizeof(_Free_links) ? sizeof(_Tp) : sizeof(_Free_links)];
+
+      _Tp*
+      _M_ptr() noexcept { return static_cast<_Tp*>(static_cast<void*>(_M_bytes)); }
+
+      const _Tp*
+      _M_ptr() const noexcept { return static_cast<const _Tp*>(static_cast<const void*>(_M_bytes)); }
+
+      _Free_links&
+      _M_links() noexcept { return *static_cast<_Free_links*>(static_cast<void*>(_M_bytes)); }
+    };
+
+    _Slot* _M_slots;
+    _Skip_t* _M_skip;
+    _Hive_block* _M_prev;
+    _Hive_block* _M_next;
+    // Neighbours in the list of blocks that have a non-empty free list.
+    _Hive_block* _M_prev_free;
+    _Hive_block* _M_next_free;
+    size_t _M_capacity;
+    size_t _M_size;
+    _Skip_t _M_free_head;
+  };
+
+  template <typename _Tp>
+  constexpr typename _Hive_block<_Tp>::_Skip_t _Hive_block<_Tp>::_S_none;
+
+  /// Bidirectional iterator over the elements of a hive.
+  template <typename _Tp, bool _Const>
+  struct _Hive_iterator {
+    typedef _Hive_block<typename std::remove_const<_Tp>::type> _Block;
+
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename std::remove_const<_Tp>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::conditional<_Const, const value_type*, value_type*>::type pointer;
+    typedef typename std::conditional<_Const, const value_type&, value_type&>::type reference;
+
+    _Block* _M_block;
+    size_t _M_idx;
+
+    _Hive_iterator() noexcept
+        : _M_block(), _M_idx() {}
+
+    _Hive_iterator(_Block* __b, size_t __i) noexcept
+        : _M_block(__b), _M_idx(__i) {}
+
+    // iterator to const_iterator conversion
+    template <bool _C2, typename = typename std::enable_if<_Const && !_C2>::type>
+    _Hive_iterator(const _Hive_iterator<_Tp, _C2>& __it) noexcept
+        : _M_block(__it._M_block), _M_idx(__it._M_idx) {}
+
+    reference
+    operator*() const noexcept { return *_M_block->_M_slots[_M_idx]._M_ptr(); }
+
+    pointer
+    operator->() const noexcept { return _M_block->_M_slots[_M_idx]._M_ptr(); }
+
+    _Hive_iterator&
+    operator++() noexcept {
+      ++_M_idx;
+      _M_idx += _M_block->_M_skip[_M_idx];
+      // Only the last block stops short of its capacity, at end().
+      if (_M_idx == _M_block->_M_capacity && _M_block->_M_next) {
+        _M_block = _M_block->_M_next;
+        _M_idx = _M_block->_M_skip[0];
+      }
+      return *this;
+    }
+
+    _Hive_iterator
+    operator++(int) noexcept {
+      _Hive_iterator __tmp = *this;
+      ++*this;
+      return __tmp;
+    }
+
+    _Hive_iterator&
+    operator--() noexcept {
+      for (;;) {
+        if (_M_idx != 0) {
+          const size_t __j = _M_idx - 1;
+          const size_t __run = _M_block->_M_skip[__j];
+          if (__run <= __j) {
+            _M_idx = __j - __run;
+            return *this;
+          }
+        }
+        // Blocks before the last one are always filled to capacity.
+        _M_block = _M_block->_M_prev;
+        _M_idx = _M_block->_M_capacity;
+      }
+    }
+
+    _Hive_iterator
+    operator--(int) noexcept {
+      _Hive_iterator __tmp = *this;
+      --*this;
+      return __tmp;
+    }
+
+    friend bool
+    operator==(const _Hive_iterator& __x, const _Hive_iterator& __y) noexcept { return __x._M_block == __y._M_block && __x._M_idx == __y._M_idx; }
+
+    friend bool
+    operator!=(const _Hive_iterator& __x, const _Hive_iterator& __y) noexcept { return !(__x == __y); }
+  };
+
+  /// Storage management for hive: the block list and its allocation.
+  template <typename _Tp, typename _Alloc>
+  struct _Hive_base {
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Tp>::other _Tp_alloc_type;
+    typedef _Hive_block<_Tp> _Block;
+    typedef typename _Block::_Slot _Slot;
+    typedef typename _Block::_Skip_t _Skip_t;
+
+    static_assert(std::is_pointer<typename __alloc_traits<_Tp_alloc_type>::pointer>::value,
+                  "__gnu_cxx::hive requires an allocator with raw pointers");
+
+    // Bounds on the number of slots per block; see _M_next_capacity.
+    static constexpr size_t _S_min_block = 8;
+    static constexpr size_t _S_max_block = 8192;
+
+    struct _Hive_impl : public _Tp_alloc_type {
+      _Block* _M_first;
+      _Block* _M_last;
+      // Head of the list of blocks with empty slots to reuse.
+      _Block* _M_free_blocks;
+      // Slots [0, _M_end) of _M_last have been used; every other block
+      // has used all of its slots.
+      size_t _M_end;
+      size_t _M_size;
+      size_t _M_capacity;
+
+      _Hive_impl() noexcept(std::is_nothrow_default_constructible<_Tp_alloc_type>::value)
+          : _Tp_alloc_type() { _M_reset(); }
+
+      _Hive_impl(const _Tp_alloc_type& __a) noexcept
+          : _Tp_alloc_type(__a) { _M_reset(); }
+
+      _Hive_impl(_Hive_impl&& __x) noexcept
+          : _Tp_alloc_type(std::move(__x)) {
+        _M_steal(__x);
+      }
+
+      void
+      _M_reset() noexcept {
+        _M_first = _M_last = _M_free_blocks = 0;
+        _M_end = _M_size = _M_capacity = 0;
+      }
+
+      void
+      _M_steal(_Hive_impl& __x) noexcept {
+        _M_first = __x._M_first;
+        _M_last = __x._M_last;
+        _M_free_blocks = __x._M_free_blocks;
+        _M_end = __x._M_end;
+        _M_size = __x._M_size;
+        _M_capacity = __x._M_capacity;
+        __x._M_reset();
+      }
+
+      void
+      _M_swap_data(_Hive_impl& __x) noexcept {
+        std::swap(_M_first, __x._M_first);
+        std::swap(_M_last, __x._M_last);
+        std::swap(_M_free_blocks, __x._M_free_blocks);
+        std::swap(_M_end, __x._M_end);
+        std::swap(_M_size, __x._M_size);
+        std::swap(_M_capacity, __x._M_capacity);
+      }
+    };
+    // _Hive_impl ==========================================================
+
+    _Hive_impl _M_impl;
+
+    _Hive_base() = default;
+
+    _Hive_base(const _Tp_alloc_type& __a) noexcept
+        : _M_impl(__a) {}
+
+    _Hive_base(_Hive_base&&) = default;
+
+    ~_Hive_base() noexcept { _M_deallocate_blocks(); }
+
+    _Tp_alloc_type&
+    _M_get_Tp_allocator() noexcept { return _M_impl; }
+
+    const _Tp_alloc_type&
+    _M_get_Tp_allocator() const noexcept { return _M_impl; }
+
+    // Blocks grow with the hive, so the number of blocks, and with it the
+    // per-block overhead, stays logarithmic until _S_max_block.
+    size_t
+    _M_next_capacity() const noexcept { return std::min(_S_max_block, std::max(_S_min_block, _M_impl._M_size)); }
+
+    _Block*
+    _M_allocate_block(size_t __cap);
+
+    void
+    _M_deallocate_block(_Block* __b) noexcept;
+
+    void
+    _M_deallocate_blocks() noexcept {
+      for (_Block* __b = _M_impl._M_first; __b;) {
+        _Block* __next = __b->_M_next;
+        _M_deallocate_block(__b);
+        __b = __next;
+      }
+      _M_impl._M_reset();
+    }
+  };
+
+  /**
+   *  @brief A container with stable element addresses, O(1) insertion
+   *  and erasure, and iteration over mostly contiguous memory.
+   *
+   *  @tparam _Tp  Type of element.
+   *  @tparam _Alloc  Allocator type.
+   *
+   *  Elements live in blocks of slots that grow with the container.
+   *  Erasing an element leaves an empty slot that iteration skips in one
+   *  step however many neighbours are empty too, and that the next
+   *  insertion reuses; elements are never moved.  The order of elements
+   *  is therefore unspecified: insert() returns where the element went.
+   *
+   *  Insertion invalidates only end(); erasure invalidates iterators to
+   *  the erased element and end().  Pointers and references to other
+   *  elements stay valid until they are erased.
+  */
+  template <typename _Tp, typename _Alloc = std::allocator<_Tp>>
+  class hive : protected _Hive_base<_Tp, _Alloc> {
+    static_assert(std::is_same<typename std::remove_cv<_Tp>::type, _Tp>::value,
+                  "__gnu_cxx::hive must have a non-const, non-volatile value_type");
+
+    typedef _Hive_base<_Tp, _Alloc> _Base;
+    typedef typename _Base::_Tp_alloc_type _Tp_alloc_type;
+    typedef __alloc_traits<_Tp_alloc_type> _Alloc_traits;
+    typedef typename _Base::_Block _Block;
+    typedef typename _Base::_Slot _Slot;
+    typedef typename _Base::_Skip_t _Skip_t;
+
+  public:
+    typedef _Tp value_type;
+    typedef typename _Alloc_traits::pointer pointer;
+    typedef typename _Alloc_traits::const_pointer const_pointer;
+    typedef typename _Alloc_traits::reference reference;
+    typedef typename _Alloc_traits::const_reference const_reference;
+    typedef _Hive_iterator<_Tp, false> iterator;
+    typedef _Hive_iterator<_Tp, true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef _Alloc allocator_type;
+
+  protected:
+    using _Base::_M_get_Tp_allocator;
+    using _Base::_M_impl;
+
+  public:
+    hive() = default;
+
+    explicit hive(const allocator_type& __a) noexcept
+        : _Base(_Tp_alloc_type(__a)) {}
+
+    explicit hive(size_type __n, const allocator_type& __a = allocator_type())
+        : _Base(_Tp_alloc_type(__a)) {
+      for (; __n; --__n)
+        emplace();
+    }
+
+    hive(size_type __n, const value_type& __value,
+         const allocator_type& __a = allocator_type())
+        : _Base(_Tp_alloc_type(__a)) { insert(__n, __value); }
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    hive(_InputIterator __first, _InputIterator __last,
+         const allocator_type& __a = allocator_type())
+        : _Base(_Tp_alloc_type(__a)) { insert(__first, __last); }
+
+    hive(std::initializer_list<value_type> __l,
+         const allocator_type& __a = allocator_type())
+        : _Base(_Tp_alloc_type(__a)) { insert(__l.begin(), __l.end()); }
+
+    hive(const hive& __x)
+        : _Base(_Alloc_traits::_S_select_on_copy(__x._M_get_Tp_allocator())) { insert(__x.begin(), __x.end()); }
+
+    hive(const hive& __x, const allocator_type& __a)
+        : _Base(_Tp_alloc_type(__a)) { insert(__x.begin(), __x.end()); }
+
+    /// Takes the blocks of @a __x; no element is moved or copied.
+    hive(hive&&) noexcept = default;
+
+    hive(hive&& __x, const allocator_type& __a)
+        : _Base(_Tp_alloc_type(__a)) {
+      if (_M_get_Tp_allocator() == __x._M_get_Tp_allocator())
+        _M_impl._M_steal(__x._M_impl);
+      else
+        for (iterator __i = __x.begin(); __i != __x.end(); ++__i)
+          emplace(std::move(*__i));
+    }
+
+    ~hive() noexcept { _M_destroy_elements(); }
+
+    hive&
+    operator=(const hive& __x);
+
+    hive&
+    operator=(hive&& __x) noexcept(_Alloc_traits::_S_nothrow_move());
+
+    hive&
+    operator=(std::initializer_list<value_type> __l) {
+      clear();
+      insert(__l.begin(), __l.end());
+      return *this;
+    }
+
+    allocator_type
+    get_allocator() const noexcept { return allocator_type(_M_get_Tp_allocator()); }
+
+    // iterators
+    iterator
+    begin() noexcept {
+      _Block* __b = _M_impl._M_first;
+      return __b ? iterator(__b, __b->_M_skip[0]) : iterator();
+    }
+
+    const_iterator
+    begin() const noexcept {
+      _Block* __b = _M_impl._M_first;
+      return __b ? const_iterator(__b, __b->_M_skip[0]) : const_iterator();
+    }
+
+    iterator
+    end() noexcept { return iterator(_M_impl._M_last, _M_impl._M_end); }
+
+    const_iterator
+    end() const noexcept { return const_iterator(_M_impl._M_last, _M_impl._M_end); }
+
+    reverse_iterator
+    rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator
+    rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator
+    rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator
+    rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator
+    cbegin() const noexcept { return begin(); }
+
+    const_iterator
+    cend() const noexcept { return end(); }
+
+    const_reverse_iterator
+    crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator
+    crend() const noexcept { return rend(); }
+
+    // capacity
+    bool
+    empty() const noexcept { return _M_impl._M_size == 0; }
+
+    size_type
+    size() const noexcept { return _M_impl._M_size; }
+
+    size_type
+    max_size() const noexcept { return _Alloc_traits::max_size(_M_get_Tp_allocator()); }
+
+    /// Number of slots in all blocks, used or not.
+    size_type
+    capacity() const noexcept { return _M_impl._M_capacity; }
+
+    // modifiers
+
+    /// Constructs an element in the first reusable slot, or after the
+    /// last used one, and returns an iterator to it.
+    template <typename... _Args>
+    iterator
+    emplace(_Args&&... __args);
+
+    iterator
+    insert(const value_type& __x) { return emplace(__x); }
+
+    iterator
+    insert(value_type&& __x) { return emplace(std::move(__x)); }
+
+    void
+    insert(size_type __n, const value_type& __x) {
+      for (; __n; --__n)
+        emplace(__x);
+    }
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    void
+    insert(_InputIterator __first, _InputIterator __last) {
+      for (; __first != __last; ++__first)
+        emplace(*__first);
+    }
+
+    void
+    insert(std::initializer_list<value_type> __l) { insert(__l.begin(), __l.end()); }
+
+    /// Destroys the element at @a __pos and returns an iterator to the
+    /// element after it.
+    iterator
+    erase(const_iterator __pos);
+
+    iterator
+    erase(const_iterator __first, const_iterator __last) {
+      // end() moves when the last block is emptied, so track it.
+      if (__last == cend())
+        while (__first != cend())
+          __first = erase(__first);
+      else
+        while (__first != __last)
+          __first = erase(__first);
+      return iterator(__first._M_block, __first._M_idx);
+    }
+
+    void
+    swap(hive& __x) noexcept {
+      __glibcxx_assert(_Alloc_traits::propagate_on_container_swap::value || _M_get_Tp_allocator() == __x._M_get_Tp_allocator());
+      _M_impl._M_swap_data(__x._M_impl);
+      _Alloc_traits::_S_on_swap(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+    }
+
+    void
+    clear() noexcept {
+      _M_destroy_elements();
+      this->_M_deallocate_blocks();
+    }
+
+    // operations
+
+    /// Returns an iterator to the element @a __p points to, which must be
+    /// an element of this hive.
+    iterator
+    get_iterator(const_pointer __p) noexcept;
+
+    const_iterator
+    get_iterator(const_pointer __p) const noexcept { return const_cast<hive*>(this)->get_iterator(__p); }
+
+  private:
+    void
+    _M_destroy_elements() noexcept {
+      if (!std::is_trivially_destructible<_Tp>::value)
+        for (iterator __i = begin(); __i != end(); ++__i)
+          _Alloc_traits::destroy(_M_impl, std::__addressof(*__i));
+    }
+
+    // Maintenance of the free lists.  _M_push_free and _M_unlink_free
+    // also put blocks on and take them off the list of blocks with
+    // empty slots.
+    void
+    _M_push_free(_Block* __b, size_t __i) noexcept;
+
+    void
+    _M_unlink_free(_Block* __b, size_t __i) noexcept;
+
+    void
+    _M_move_free(_Block* __b, size_t __from, size_t __to) noexcept;
+
+    void
+    _M_unlink_free_block(_Block* __b) noexcept;
+
+    iterator
+    _M_erase_block(_Block* __b) noexcept;
+
+    _Block*
+    _M_add_block();
+  };
+
+  template <typename _Tp, typename _Alloc>
+  inline void
+  swap(hive<_Tp, _Alloc>& __x, hive<_Tp, _Alloc>& __y) noexcept { __x.swap(__y); }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#include <ext/hive.tcc>
+
+#endif // C++11
+
+#endif // _HIVE_H
@@ -0,0 +1,319 @@
+// Bucketed container with stable element addresses -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/hive.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/hive.h}
+ */
+
+#ifndef _HIVE_TCC
+#define _HIVE_TCC 1
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template <typename _Tp, typename _Alloc>
+  constexpr size_t _Hive_base<_Tp, _Alloc>::_S_min_block;
+
+  template <typename _Tp, typename _Alloc>
+  constexpr size_t _Hive_base<_Tp, _Alloc>::_S_max_block;
+
+  template <typename _Tp, typename _Alloc>
+  typename _Hive_base<_Tp, _Alloc>::_Block*
+  _Hive_base<_Tp, _Alloc>::
+      _M_allocate_block(size_t __cap) {
+    typedef typename __alloc_traits<_Tp_alloc_type>::template rebind<_Block>::other _Block_alloc_type;
+    typedef typename __alloc_traits<_Tp_alloc_type>::template rebind<_Slot>::other _Slot_alloc_type;
+    typedef typename __alloc_traits<_Tp_alloc_type>::template rebind<_Skip_t>::other _Skip_alloc_type;
+    _Block_alloc_type __block_alloc(_M_impl);
+    _Slot_alloc_type __slot_alloc(_M_impl);
+    _Skip_alloc_type __skip_alloc(_M_impl);
+
+    _Block* __b = __alloc_traits<_Block_alloc_type>::allocate(__block_alloc, 1);
+    __b->_M_slots = 0;
+    try {
+      __b->_M_slots = __alloc_traits<_Slot_alloc_type>::allocate(__slot_alloc, __cap);
+      __b->_M_skip = __alloc_traits<_Skip_alloc_type>::allocate(__skip_alloc, __cap + 1);
+    } catch (...) {
+      if (__b->_M_slots)
+        __alloc_traits<_Slot_alloc_type>::deallocate(__slot_alloc, __b->_M_slots, __cap);
+      __alloc_traits<_Block_alloc_type>::deallocate(__block_alloc, __b, 1);
+      throw;
+    }
+    std::fill_n(__b->_M_skip, __cap + 1, _Skip_t());
+    __b->_M_prev = __b->_M_next = 0;
+    __b->_M_prev_free = __b->_M_next_free = 0;
+    __b->_M_capacity = __cap;
+    __b->_M_size = 0;
+    __b->_M_free_head = _Block::_S_none;
+    return __b;
+  }
+
+  template <typename _Tp, typename _Alloc>
+  void
+  _Hive_base<_Tp, _Alloc>::
+      _M_deallocate_block(_Block* __b) noexcept {
+    typedef typename __alloc_traits<_Tp_alloc_type>::template rebind<_Block>::other _Block_alloc_type;
+    typedef typename __alloc_traits<_Tp_alloc_type>::template rebind<_Slot>::other _Slot_alloc_type;
+    typedef typename __alloc_traits<_Tp_alloc_type>::template rebind<_Skip_t>::other _Skip_alloc_type;
+    _Block_alloc_type __block_alloc(_M_impl);
+    _Slot_alloc_type __slot_alloc(_M_impl);
+    _Skip_alloc_type __skip_alloc(_M_impl);
+
+    __alloc_traits<_Skip_alloc_type>::deallocate(__skip_alloc, __b->_M_skip, __b->_M_capacity + 1);
+    __alloc_traits<_Slot_alloc_type>::deallocate(__slot_alloc, __b->_M_slots, __b->_M_capacity);
+    __alloc_traits<_Block_alloc_type>::deallocate(__block_alloc, __b, 1);
+  }
+
+  template <typename _Tp, typename _Alloc>
+  hive<_Tp, _Alloc>&
+  hive<_Tp, _Alloc>::
+  operator=(const hive& __x) {
+    if (&__x == this)
+      return *this;
+    clear();
+    if (_Alloc_traits::_S_propagate_on_copy_assign())
+      std::__alloc_on_copy(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+    insert(__x.begin(), __x.end());
+    return *this;
+  }
+
+  template <typename _Tp, typename _Alloc>
+  hive<_Tp, _Alloc>&
+  hive<_Tp, _Alloc>::
+  operator=(hive&& __x) noexcept(_Alloc_traits::_S_nothrow_move()) {
+    if (&__x == this)
+      return *this;
+    clear();
+    if (_Alloc_traits::_S_propagate_on_move_assign() || _M_get_Tp_allocator() == __x._M_get_Tp_allocator()) {
+      std::__alloc_on_move(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+      _M_impl._M_steal(__x._M_impl);
+    } else {
+      for (iterator __i = __x.begin(); __i != __x.end(); ++__i)
+        emplace(std::move(*__i));
+      __x.clear();
+    }
+    return *this;
+  }
+
+  template <typename _Tp, typename _Alloc>
+  template <typename... _Args>
+  typename hive<_Tp, _Alloc>::iterator
+  hive<_Tp, _Alloc>::
+      emplace(_Args&&... __args) {
+    if (_Block* __b = _M_impl._M_free_blocks) {
+      // Reuse the first slot of the run at the head of the free list.
+      const size_t __s = __b->_M_free_head;
+      _Slot& __slot = __b->_M_slots[__s];
+      const _Skip_t __next = __slot._M_links()._M_next;
+      try {
+        _Alloc_traits::construct(_M_impl, __slot._M_ptr(), std::forward<_Args>(__args)...);
+      } catch (...) {
+        __slot._M_links() = {_Block::_S_none, __next};
+        throw;
+      }
+      _Skip_t* __skip = __b->_M_skip;
+      const size_t __len = __skip[__s];
+      __skip[__s] = 0;
+      if (__len == 1) {
+        __b->_M_free_head = __next;
+        if (__next != _Block::_S_none)
+          __b->_M_slots[__next]._M_links()._M_prev = _Block::_S_none;
+        else
+          _M_unlink_free_block(__b);
+      } else {
+        // The rest of the run starts one slot later.
+        const size_t __t = __s + 1;
+        __skip[__t] = __skip[__s + __len - 1] = _Skip_t(__len - 1);
+        __b->_M_slots[__t]._M_links() = {_Block::_S_none, __next};
+        if (__next != _Block::_S_none)
+          __b->_M_slots[__next]._M_links()._M_prev = _Skip_t(__t);
+        __b->_M_free_head = _Skip_t(__t);
+      }
+      ++__b->_M_size;
+      ++_M_impl._M_size;
+      return iterator(__b, __s);
+    }
+
+    _Block* __b = _M_impl._M_last;
+    if (!__b || _M_impl._M_end == __b->_M_capacity)
+      __b = _M_add_block();
+    const size_t __s = _M_impl._M_end;
+    _Alloc_traits::construct(_M_impl, __b->_M_slots[__s]._M_ptr(), std::forward<_Args>(__args)...);
+    ++_M_impl._M_end;
+    ++__b->_M_size;
+    ++_M_impl._M_size;
+    return iterator(__b, __s);
+  }
+
+  template <typename _Tp, typename _Alloc>
+  typename hive<_Tp, _Alloc>::iterator
+  hive<_Tp, _Alloc>::
+      erase(const_iterator __pos) {
+    _Block* __b = __pos._M_block;
+    const size_t __i = __pos._M_idx;
+    _Alloc_traits::destroy(_M_impl, __b->_M_slots[__i]._M_ptr());
+    --_M_impl._M_size;
+    if (--__b->_M_size == 0)
+      return _M_erase_block(__b);
+
+    // Join the slot with the runs of empty slots on either side.
+    _Skip_t* __skip = __b->_M_skip;
+    const size_t __l = __i ? __skip[__i - 1] : 0;
+    const size_t __r = __skip[__i + 1];
+    if (__l == 0 && __r == 0) {
+      __skip[__i] = 1;
+      _M_push_free(__b, __i);
+    } else if (__r == 0)
+      __skip[__i - __l] = __skip[__i] = _Skip_t(__l + 1);
+    else if (__l == 0) {
+      __skip[__i] = __skip[__i + __r] = _Skip_t(__r + 1);
+      _M_move_free(__b, __i + 1, __i);
+    } else {
+      __skip[__i - __l] = __skip[__i + __r] = _Skip_t(__l + __r + 1);
+      _M_unlink_free(__b, __i + 1);
+    }
+
+    iterator __next(__b, __i + __r + 1);
+    if (__next._M_idx == __b->_M_capacity && __b->_M_next)
+      __next = iterator(__b->_M_next, __b->_M_next->_M_skip[0]);
+    return __next;
+  }
+
+  template <typename _Tp, typename _Alloc>
+  typename hive<_Tp, _Alloc>::iterator
+  hive<_Tp, _Alloc>::
+      get_iterator(const_pointer __p) noexcept {
+    const _Slot* __s = reinterpret_cast<const _Slot*>(__p);
+    for (_Block* __b = _M_impl._M_first; __b; __b = __b->_M_next)
+      if (std::less_equal<const _Slot*>()(__b->_M_slots, __s) && std::less<const _Slot*>()(__s, __b->_M_slots + __b->_M_capacity))
+        return iterator(__b, size_t(__s - __b->_M_slots));
+    return end();
+  }
+
+  template <typename _Tp, typename _Alloc>
+  void
+  hive<_Tp, _Alloc>::
+      _M_push_free(_Block* __b, size_t __i) noexcept {
+    const _Skip_t __head = __b->_M_free_head;
+    __b->_M_slots[__i]._M_links() = {_Block::_S_none, __head};
+    if (__head != _Block::_S_none)
+      __b->_M_slots[__head]._M_links()._M_prev = _Skip_t(__i);
+    else {
+      __b->_M_prev_free = 0;
+      __b->_M_next_free = _M_impl._M_free_blocks;
+      if (_M_impl._M_free_blocks)
+        _M_impl._M_free_blocks->_M_prev_free = __b;
+      _M_impl._M_free_blocks = __b;
+    }
+    __b->_M_free_head = _Skip_t(__i);
+  }
+
+  template <typename _Tp, typename _Alloc>
+  void
+  hive<_Tp, _Alloc>::
+      _M_unlink_free(_Block* __b, size_t __i) noexcept {
+    const typename _Block::_Free_links __links = __b->_M_slots[__i]._M_links();
+    if (__links._M_prev != _Block::_S_none)
+      __b->_M_slots[__links._M_prev]._M_links()._M_next = __links._M_next;
+    else
+      __b->_M_free_head = __links._M_next;
+    if (__links._M_next != _Block::_S_none)
+      __b->_M_slots[__links._M_next]._M_links()._M_prev = __links._M_prev;
+    if (__b->_M_free_head == _Block::_S_none)
+      _M_unlink_free_block(__b);
+  }
+
+  template <typename _Tp, typename _Alloc>
+  void
+  hive<_Tp, _Alloc>::
+      _M_move_free(_Block* __b, size_t __from, size_t __to) noexcept {
+    const typename _Block::_Free_links __links = __b->_M_slots[__from]._M_links();
+    __b->_M_slots[__to]._M_links() = __links;
+    if (__links._M_prev != _Block::_S_none)
+      __b->_M_slots[__links._M_prev]._M_links()._M_next = _Skip_t(__to);
+    else
+      __b->_M_free_head = _Skip_t(__to);
+    if (__links._M_next != _Block::_S_none)
+      __b->_M_slots[__links._M_next]._M_links()._M_prev = _Skip_t(__to);
+  }
+
+  template <typename _Tp, typename _Alloc>
+  void
+  hive<_Tp, _Alloc>::
+      _M_unlink_free_block(_Block* __b) noexcept {
+    if (__b->_M_prev_free)
+      __b->_M_prev_free->_M_next_free = __b->_M_next_free;
+    else
+      _M_impl._M_free_blocks = __b->_M_next_free;
+    if (__b->_M_next_free)
+      __b->_M_next_free->_M_prev_free = __b->_M_prev_free;
+    __b->_M_prev_free = __b->_M_next_free = 0;
+  }
+
+  template <typename _Tp, typename _Alloc>
+  typename hive<_Tp, _Alloc>::iterator
+  hive<_Tp, _Alloc>::
+      _M_erase_block(_Block* __b) noexcept {
+    if (__b->_M_free_head != _Block::_S_none)
+      _M_unlink_free_block(__b);
+    _Block* __next = __b->_M_next;
+    if (!__next) {
+      // Keep the last block so that a hive emptied and refilled at its
+      // end does not allocate on every pass.
+      std::fill_n(__b->_M_skip, _M_impl._M_end + 1, _Skip_t());
+      __b->_M_free_head = _Block::_S_none;
+      _M_impl._M_end = 0;
+      return end();
+    }
+    if (__b->_M_prev)
+      __b->_M_prev->_M_next = __next;
+    else
+      _M_impl._M_first = __next;
+    __next->_M_prev = __b->_M_prev;
+    _M_impl._M_capacity -= __b->_M_capacity;
+    this->_M_deallocate_block(__b);
+    return iterator(__next, __next->_M_skip[0]);
+  }
+
+  template <typename _Tp, typename _Alloc>
+  typename hive<_Tp, _Alloc>::_Block*
+  hive<_Tp, _Alloc>::
+      _M_add_block() {
+    _Block* __b = this->_M_allocate_block(this->_M_next_capacity());
+    __b->_M_prev = _M_impl._M_last;
+    if (_M_impl._M_last)
+      _M_impl._M_last->_M_next = __b;
+    else
+      _M_impl._M_first = __b;
+    _M_impl._M_last = __b;
+    _M_impl._M_end = 0;
+    _M_impl._M_capacity += __b->_M_capacity;
+    return __b;
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // _HIVE_TCC
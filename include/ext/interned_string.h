@@ -0,0 +1,352 @@
+// Interned strings -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/interned_string.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _INTERNED_STRING_H
+#define _INTERNED_STRING_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <atomic>
+#include <bits/functional_hash.h>
+#include <ext/concurrence.h>
+#include <new>
+#include <optional>
+#include <string_view>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Counters describing the intern table of one string type.
+  struct interning_stats {
+    size_t strings;        ///< Distinct non-empty strings interned.
+    size_t bytes;          ///< Character storage, including terminators.
+    size_t table_capacity; ///< Slots in the hash table.
+    size_t lookups;        ///< Calls to intern or lookup.
+    size_t hits;           ///< Lookups that found an existing string.
+  };
+
+  /**
+   *  The process-wide, append-only table behind basic_interned_string.
+   *  Readers probe the current slot array without locking; writers
+   *  serialize on a mutex, store each new entry with release semantics
+   *  and, when the array fills up, publish a larger copy.  Entries and
+   *  superseded arrays are never freed, so a reader never sees a
+   *  dangling pointer.
+   */
+  template <typename _CharT, typename _Traits>
+  class __intern_table {
+    typedef std::basic_string_view<_CharT, _Traits> _View;
+
+  public:
+    // The characters follow the header, null-terminated.
+    struct _Entry {
+      size_t _M_hash;
+      size_t _M_len;
+
+      const _CharT*
+      _M_data() const noexcept { return reinterpret_cast<const _CharT*>(this + 1); }
+    };
+
+    // Deliberately never destroyed, so interned strings stay valid while
+    // other static objects are destroyed.
+    static __intern_table&
+    _S_instance() {
+      static __intern_table* __table = new __intern_table;
+      return *__table;
+    }
+
+    static size_t
+    _S_hash(_View __s) noexcept { return std::_Hash_impl::hash(__s.data(), __s.size() * sizeof(_CharT)); }
+
+    // The entry equal to __s, or null.  Lock-free.
+    const _Entry*
+    _M_find(_View __s) noexcept {
+      const size_t __h = _S_hash(__s);
+      const _Entry* __e = _S_probe(_M_slots.load(std::memory_order_acquire), __s, __h);
+      _M_count_lookup(__e);
+      return __e;
+    }
+
+    const _Entry*
+    _M_intern(_View __s) {
+      const size_t __h = _S_hash(__s);
+      if (const _Entry* __e = _S_probe(_M_slots.load(std::memory_order_acquire), __s, __h)) {
+        _M_count_lookup(__e);
+        return __e;
+      }
+
+      __scoped_lock __lock(_M_mutex);
+      _Slots* __t = _M_slots.load(std::memory_order_relaxed);
+      const _Entry* __e = _S_probe(__t, __s, __h);
+      _M_count_lookup(__e);
+      if (__e)
+        return __e;
+      if (2 * (_M_strings + 1) > __t->_M_mask + 1)
+        __t = _M_grow(__t);
+      __e = _M_store(__s, __h);
+      _S_insert(__t, __e, std::memory_order_release);
+      ++_M_strings;
+      return __e;
+    }
+
+    interning_stats
+    _M_stats() {
+      __scoped_lock __lock(_M_mutex);
+      return {_M_strings, _M_bytes, _M_slots.load(std::memory_order_relaxed)->_M_mask + 1,
+              _M_lookups.load(std::memory_order_relaxed), _M_hits.load(std::memory_order_relaxed)};
+    }
+
+  private:
+    struct _Slots {
+      size_t _M_mask;
+      std::atomic<const _Entry*>* _M_slot;
+      _Slots* _M_prev; // Superseded array, kept for readers still probing it.
+    };
+
+    static constexpr size_t _S_initial_slots = 256;
+    static constexpr size_t _S_chunk_size = 64 * 1024;
+
+    __intern_table()
+        : _M_slots(_S_new_slots(_S_initial_slots, nullptr)), _M_strings(0), _M_bytes(0),
+          _M_chunk(nullptr), _M_chunk_left(0), _M_lookups(0), _M_hits(0) {}
+
+    static _Slots*
+    _S_new_slots(size_t __n, _Slots* __prev) {
+      _Slots* __t = new _Slots;
+      __try {
+        __t->_M_slot = new std::atomic<const _Entry*>[__n]();
+      }
+      __catch(...) {
+        delete __t;
+        __throw_exception_again;
+      }
+      __t->_M_mask = __n - 1;
+      __t->_M_prev = __prev;
+      return __t;
+    }
+
+    static const _Entry*
+    _S_probe(const _Slots* __t, _View __s, size_t __h) noexcept {
+      for (size_t __i = __h & __t->_M_mask;; __i = (__i + 1) & __t->_M_mask) {
+        const _Entry* __e = __t->_M_slot[__i].load(std::memory_order_acquire);
+        if (!__e)
+          return nullptr;
+        if (__e->_M_hash == __h && __e->_M_len == __s.size()
+            && _Traits::compare(__e->_M_data(), __s.data(), __s.size()) == 0)
+          return __e;
+      }
+    }
+
+    static void
+    _S_insert(_Slots* __t, const _Entry* __e, std::memory_order __order) noexcept {
+      size_t __i = __e->_M_hash & __t->_M_mask;
+      while (__t->_M_slot[__i].load(std::memory_order_relaxed))
+        __i = (__i + 1) & __t->_M_mask;
+      __t->_M_slot[__i].store(__e, __order);
+    }
+
+    // Fills an array twice the size and makes it current.  Called with
+    // the mutex held.
+    _Slots*
+    _M_grow(_Slots* __old) {
+      _Slots* __t = _S_new_slots(2 * (__old->_M_mask + 1), __old);
+      for (size_t __i = 0; __i <= __old->_M_mask; ++__i)
+        if (const _Entry* __e = __old->_M_slot[__i].load(std::memory_order_relaxed))
+          _S_insert(__t, __e, std::memory_order_relaxed);
+      _M_slots.store(__t, std::memory_order_release);
+      return __t;
+    }
+
+    // Copies __s into the arena.  Long strings get a block of their own
+    // so they do not waste the rest of a chunk.  Called with the mutex
+    // held.
+    const _Entry*
+    _M_store(_View __s, size_t __h) {
+      const size_t __align = alignof(_Entry);
+      const size_t __bytes = (sizeof(_Entry) + (__s.size() + 1) * sizeof(_CharT) + __align - 1) & ~(__align - 1);
+      void* __p;
+      if (__bytes > _S_chunk_size / 4)
+        __p = ::operator new(__bytes);
+      else {
+        if (__bytes > _M_chunk_left) {
+          _M_chunk = static_cast<char*>(::operator new(_S_chunk_size));
+          _M_chunk_left = _S_chunk_size;
+        }
+        __p = _M_chunk;
+        _M_chunk += __bytes;
+        _M_chunk_left -= __bytes;
+      }
+      _Entry* __e = ::new (__p) _Entry{__h, __s.size()};
+      _CharT* __d = reinterpret_cast<_CharT*>(__e + 1);
+      _Traits::copy(__d, __s.data(), __s.size());
+      _Traits::assign(__d[__s.size()], _CharT());
+      _M_bytes += (__s.size() + 1) * sizeof(_CharT);
+      return __e;
+    }
+
+    void
+    _M_count_lookup(const _Entry* __e) noexcept {
+      _M_lookups.fetch_add(1, std::memory_order_relaxed);
+      if (__e)
+        _M_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic<_Slots*> _M_slots;
+    __mutex _M_mutex;
+    size_t _M_strings;
+    size_t _M_bytes;
+    char* _M_chunk;
+    size_t _M_chunk_left;
+    std::atomic<size_t> _M_lookups;
+    std::atomic<size_t> _M_hits;
+  };
+
+  /**
+   *  @brief  A handle to an immutable string stored once per process.
+   *
+   *  Equal strings interned anywhere in the program share one copy, so
+   *  equality is a pointer comparison and hashing returns a hash stored
+   *  with the characters.  The hash equals that of the corresponding
+   *  std::basic_string_view, so the two can be mixed in heterogeneous
+   *  lookups.  Interning is thread-safe; finding a string that is
+   *  already in the table takes no lock.  Interned characters are never
+   *  freed.
+   */
+  template <typename _CharT, typename _Traits = std::char_traits<_CharT>>
+  class basic_interned_string {
+    typedef __intern_table<_CharT, _Traits> _Table;
+    typedef typename _Table::_Entry _Entry;
+
+  public:
+    typedef _Traits traits_type;
+    typedef _CharT value_type;
+    typedef size_t size_type;
+    typedef const _CharT* const_iterator;
+    typedef std::basic_string_view<_CharT, _Traits> string_view_type;
+
+    /// The empty string.
+    constexpr basic_interned_string() noexcept : _M_entry(nullptr) {}
+
+    /// Interns @a __s, copying it into the table if it is not there yet.
+    explicit basic_interned_string(string_view_type __s)
+        : _M_entry(__s.empty() ? nullptr : _Table::_S_instance()._M_intern(__s)) {}
+
+    explicit basic_interned_string(const _CharT* __s) : basic_interned_string(string_view_type(__s)) {}
+
+    /// The interned string equal to @a __s, if there is one.  Never
+    /// inserts, but the first use of the table allocates it.
+    static std::optional<basic_interned_string>
+    lookup(string_view_type __s) {
+      if (__s.empty())
+        return basic_interned_string();
+      if (const _Entry* __e = _Table::_S_instance()._M_find(__s))
+        return basic_interned_string(__e);
+      return std::nullopt;
+    }
+
+    /// Statistics for the table holding this string type.
+    static interning_stats
+    stats() { return _Table::_S_instance()._M_stats(); }
+
+    const _CharT*
+    data() const noexcept { return _M_entry ? _M_entry->_M_data() : _S_empty; }
+
+    const _CharT*
+    c_str() const noexcept { return data(); }
+
+    size_type
+    size() const noexcept { return _M_entry ? _M_entry->_M_len : 0; }
+
+    size_type
+    length() const noexcept { return size(); }
+
+    _GLIBCXX_NODISCARD bool
+    empty() const noexcept { return !_M_entry; }
+
+    const_iterator
+    begin() const noexcept { return data(); }
+
+    const_iterator
+    end() const noexcept { return data() + size(); }
+
+    string_view_type
+    view() const noexcept { return string_view_type(data(), size()); }
+
+    operator string_view_type() const noexcept { return view(); }
+
+    /// Equal to std::hash<string_view_type>()(view()).
+    size_t
+    hash() const noexcept { return _M_entry ? _M_entry->_M_hash : _Table::_S_hash(string_view_type()); }
+
+    friend bool
+    operator==(const basic_interned_string& __x, const basic_interned_string& __y) noexcept {
+      return __x._M_entry == __y._M_entry;
+    }
+
+    friend bool
+    operator!=(const basic_interned_string& __x, const basic_interned_string& __y) noexcept {
+      return __x._M_entry != __y._M_entry;
+    }
+
+  private:
+    explicit basic_interned_string(const _Entry* __e) noexcept : _M_entry(__e) {}
+
+    static constexpr _CharT _S_empty[1] = {};
+
+    const _Entry* _M_entry;
+  };
+
+  typedef basic_interned_string<char> interned_string;
+#ifdef _GLIBCXX_USE_WCHAR_T
+  typedef basic_interned_string<wchar_t> winterned_string;
+#endif
+  typedef basic_interned_string<char16_t> u16interned_string;
+  typedef basic_interned_string<char32_t> u32interned_string;
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+namespace std _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// std::hash specialization for basic_interned_string.
+  template <typename _CharT, typename _Traits>
+  struct hash<__gnu_cxx::basic_interned_string<_CharT, _Traits>>
+      : public __hash_base<size_t, __gnu_cxx::basic_interned_string<_CharT, _Traits>> {
+    size_t
+    operator()(const __gnu_cxx::basic_interned_string<_CharT, _Traits>& __s) const noexcept { return __s.hash(); }
+  };
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++17
+
+#endif // _INTERNED_STRING_H
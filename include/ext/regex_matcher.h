@@ -0,0 +1,205 @@
+// Reusable regex matcher -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/regex_matcher.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _REGEX_MATCHER_H
+#define _REGEX_MATCHER_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <iterator>
+#include <regex>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief  Matches one regex many times without allocating.
+   *
+   *  Works as std::regex_match and std::regex_search do, but keeps the
+   *  buffers the matcher needs from one call to the next, and reuses the
+   *  storage of the match_results passed in.  Once both have grown large
+   *  enough for the regex and the inputs, a match allocates nothing, apart
+   *  from lookaheads.
+   *
+   *  The regex must outlive the matcher.  A matcher must not be used by
+   *  two threads at once; copies share the regex but not the buffers.
+   */
+  template <typename _BiIter, typename _CharT = typename std::iterator_traits<_BiIter>::value_type,
+            typename _TraitsT = std::regex_traits<_CharT>,
+            typename _Alloc = std::allocator<std::sub_match<_BiIter>>>
+  class regex_matcher {
+  public:
+    typedef std::basic_regex<_CharT, _TraitsT> regex_type;
+    typedef std::match_results<_BiIter, _Alloc> results_type;
+    typedef std::regex_constants::match_flag_type match_flag_type;
+
+    explicit regex_matcher(const regex_type& __re) noexcept : _M_re(&__re) {}
+
+    // The regex would be destroyed before the matcher is used.
+    regex_matcher(const regex_type&&) = delete;
+
+    const regex_type&
+    regex() const noexcept { return *_M_re; }
+
+    /// As std::regex_match(__s, __e, __m, regex(), __flags).
+    bool
+    match(_BiIter __s, _BiIter __e, results_type& __m,
+          match_flag_type __flags = std::regex_constants::match_default) {
+      return _M_run<true>(__s, __e, __m, __flags);
+    }
+
+    /// As std::regex_search(__s, __e, __m, regex(), __flags).
+    bool
+    search(_BiIter __s, _BiIter __e, results_type& __m,
+           match_flag_type __flags = std::regex_constants::match_default) {
+      return _M_run<false>(__s, __e, __m, __flags);
+    }
+
+  private:
+    template <bool __match_mode>
+    bool
+    _M_run(_BiIter __s, _BiIter __e, results_type& __m, match_flag_type __flags) {
+      return std::__detail::__regex_algo_impl<_BiIter, _Alloc, _CharT, _TraitsT,
+                                              std::__detail::_RegexExecutorPolicy::_S_auto, __match_mode>(
+          __s, __e, __m, *_M_re, __flags, size_t(-1), &_M_context);
+    }
+
+    const regex_type* _M_re;
+    std::__detail::_Match_context<_BiIter, _Alloc> _M_context;
+  };
+
+  /**
+   *  @brief  Iterates over the matches of a regex without allocating.
+   *
+   *  Finds the same matches as std::regex_iterator, but keeps the buffers
+   *  of the matcher from one match to the next, as regex_matcher does.
+   *  std::regex_iterator cannot hold them without changing its layout.
+   *
+   *  Copies share the regex but not the buffers.
+   */
+  template <typename _BiIter, typename _CharT = typename std::iterator_traits<_BiIter>::value_type,
+            typename _TraitsT = std::regex_traits<_CharT>>
+  class regex_matcher_iterator {
+  public:
+    typedef std::basic_regex<_CharT, _TraitsT> regex_type;
+    typedef std::match_results<_BiIter> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::regex_constants::match_flag_type match_flag_type;
+
+    /// The end-of-sequence iterator.
+    regex_matcher_iterator() = default;
+
+    regex_matcher_iterator(_BiIter __a, _BiIter __b, const regex_type& __re,
+                           match_flag_type __m = std::regex_constants::match_default)
+        : _M_begin(__a), _M_end(__b), _M_pregex(&__re), _M_flags(__m) {
+      if (!_M_search(_M_begin, _M_flags))
+        *this = regex_matcher_iterator();
+    }
+
+    // The regex would be destroyed before the iterator is used.
+    regex_matcher_iterator(_BiIter, _BiIter, const regex_type&&,
+                           match_flag_type = std::regex_constants::match_default) = delete;
+
+    bool
+    operator==(const regex_matcher_iterator& __rhs) const noexcept {
+      if (_M_pregex == nullptr && __rhs._M_pregex == nullptr)
+        return true;
+      return _M_pregex == __rhs._M_pregex && _M_begin == __rhs._M_begin && _M_end == __rhs._M_end &&
+             _M_flags == __rhs._M_flags && _M_match[0] == __rhs._M_match[0];
+    }
+
+    bool
+    operator!=(const regex_matcher_iterator& __rhs) const noexcept { return !(*this == __rhs); }
+
+    const value_type&
+    operator*() const noexcept { return _M_match; }
+
+    const value_type*
+    operator->() const noexcept { return &_M_match; }
+
+    /// As std::regex_iterator::operator++.
+    regex_matcher_iterator&
+    operator++() {
+      if (!_M_match[0].matched)
+        return *this;
+      auto __start = _M_match[0].second;
+      auto __prefix_first = _M_match[0].second;
+      if (_M_match[0].first == _M_match[0].second) {
+        if (__start == _M_end) {
+          _M_pregex = nullptr;
+          return *this;
+        }
+        if (_M_search(__start, _M_flags | std::regex_constants::match_not_null |
+                                   std::regex_constants::match_continuous)) {
+          std::__detail::__regex_iter_rebase(_M_match, _M_begin, __prefix_first);
+          return *this;
+        }
+        ++__start;
+      }
+      _M_flags |= std::regex_constants::match_prev_avail;
+      if (_M_search(__start, _M_flags))
+        std::__detail::__regex_iter_rebase(_M_match, _M_begin, __prefix_first);
+      else
+        _M_pregex = nullptr;
+      return *this;
+    }
+
+    regex_matcher_iterator
+    operator++(int) {
+      auto __tmp = *this;
+      ++(*this);
+      return __tmp;
+    }
+
+  private:
+    bool
+    _M_search(_BiIter __start, match_flag_type __flags) {
+      return std::__detail::__regex_algo_impl<_BiIter, typename value_type::allocator_type, _CharT, _TraitsT,
+                                              std::__detail::_RegexExecutorPolicy::_S_auto, false>(
+          __start, _M_end, _M_match, *_M_pregex, __flags, size_t(-1), &_M_context);
+    }
+
+    _BiIter _M_begin{};
+    _BiIter _M_end{};
+    const regex_type* _M_pregex = nullptr;
+    match_flag_type _M_flags{};
+    value_type _M_match;
+    std::__detail::_Match_context<_BiIter, typename value_type::allocator_type> _M_context;
+  };
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++11
+
+#endif // _REGEX_MATCHER_H
@@ -0,0 +1,297 @@
+// Regular expression sets -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/regex_set.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _REGEX_SET_H
+#define _REGEX_SET_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <initializer_list>
+#include <memory>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Which of the matching patterns a regex set search reports.
+  enum class regex_set_select {
+    all,             ///< Every pattern that matches.
+    first,           ///< The matching pattern with the lowest index.
+    leftmost_longest ///< The pattern of the leftmost longest match.
+  };
+
+  /**
+   *  @brief  The patterns of a basic_regex_set that matched.
+   *
+   *  Pattern indices are in increasing order.  match() is the matched
+   *  range for a match or a leftmost_longest search, and is unmatched
+   *  otherwise.
+   */
+  template <typename _BiIter>
+  class regex_set_results {
+  public:
+    typedef size_t value_type;
+    typedef std::vector<size_t>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    typedef size_t size_type;
+
+    bool
+    ready() const noexcept { return _M_ready; }
+
+    /// Number of patterns reported.
+    size_type
+    size() const noexcept { return _M_patterns.size(); }
+
+    bool
+    empty() const noexcept { return _M_patterns.empty(); }
+
+    /// Index of the @a __n th pattern reported.
+    size_t
+    operator[](size_type __n) const noexcept { return _M_patterns[__n]; }
+
+    const_iterator
+    begin() const noexcept { return _M_patterns.begin(); }
+
+    const_iterator
+    end() const noexcept { return _M_patterns.end(); }
+
+    const std::sub_match<_BiIter>&
+    match() const noexcept { return _M_match; }
+
+  private:
+    template <typename, typename>
+    friend class basic_regex_set;
+
+    std::vector<size_t> _M_patterns;
+    std::sub_match<_BiIter> _M_match;
+    bool _M_ready = false;
+  };
+
+  /**
+   *  @brief  Matches many regular expressions in one pass.
+   *
+   *  The patterns are compiled by the std::basic_regex front end and
+   *  joined into one automaton, whose accept states tell which pattern
+   *  matched.  A search then scans the input once with the lazy DFA that
+   *  std::regex_search uses, instead of once per pattern.  Wide character
+   *  types, and the match flags the DFA cannot handle, are run as a
+   *  breadth-first simulation of the same automaton.  Patterns with
+   *  back-references or lookaheads cannot share it and are run one at a
+   *  time.
+   *
+   *  Patterns are identified by their index in the sequence given to the
+   *  constructor.  Whether a pattern matches is as for std::regex_match
+   *  and std::regex_search, except that the leftmost_longest selection
+   *  always prefers the longest match, as POSIX does; for patterns run
+   *  one at a time it uses the length std::regex_search finds.
+   */
+  template <typename _CharT, typename _TraitsT = std::regex_traits<_CharT>>
+  class basic_regex_set {
+  public:
+    typedef _CharT value_type;
+    typedef _TraitsT traits_type;
+    typedef typename traits_type::string_type string_type;
+    typedef typename traits_type::locale_type locale_type;
+    typedef std::regex_constants::syntax_option_type flag_type;
+    typedef std::regex_constants::match_flag_type match_flag_type;
+
+    /// An empty set, which never matches.
+    basic_regex_set() : _M_flags(std::regex_constants::ECMAScript), _M_size(0) {}
+
+    /**
+     *  @brief  Compiles the patterns in [__first, __last).
+     *  @throw  std::regex_error  If a pattern is not valid.
+     *
+     *  Each element must be convertible to string_type.
+     */
+    template <typename _FwdIter>
+    basic_regex_set(_FwdIter __first, _FwdIter __last, flag_type __f = std::regex_constants::ECMAScript)
+        : _M_flags(__f), _M_size(0) { _M_compile(__first, __last); }
+
+    basic_regex_set(std::initializer_list<string_type> __l, flag_type __f = std::regex_constants::ECMAScript)
+        : _M_flags(__f), _M_size(0) { _M_compile(__l.begin(), __l.end()); }
+
+    /// Number of patterns.
+    size_t
+    size() const noexcept { return _M_size; }
+
+    bool
+    empty() const noexcept { return _M_size == 0; }
+
+    flag_type
+    flags() const noexcept { return _M_flags; }
+
+    /**
+     *  @brief  Finds the patterns that match all of [__first, __last).
+     *  @return  Whether any does.
+     */
+    template <typename _BiIter>
+    bool
+    match(_BiIter __first, _BiIter __last, regex_set_results<_BiIter>& __m,
+          regex_set_select __sel = regex_set_select::all,
+          match_flag_type __flags = std::regex_constants::match_default) const {
+      return _M_run(__first, __last, __m, __sel, __flags, true);
+    }
+
+    template <typename _BiIter>
+    bool
+    match(_BiIter __first, _BiIter __last, match_flag_type __flags = std::regex_constants::match_default) const {
+      regex_set_results<_BiIter> __m;
+      return _M_run(__first, __last, __m, regex_set_select::first, __flags, true);
+    }
+
+    template <typename _ST, typename _SA>
+    bool
+    match(const std::basic_string<_CharT, _ST, _SA>& __s,
+          regex_set_results<typename std::basic_string<_CharT, _ST, _SA>::const_iterator>& __m,
+          regex_set_select __sel = regex_set_select::all,
+          match_flag_type __flags = std::regex_constants::match_default) const {
+      return match(__s.begin(), __s.end(), __m, __sel, __flags);
+    }
+
+    // Prevent unsafe attempts to get results from a temporary string.
+    template <typename _ST, typename _SA>
+    bool
+    match(const std::basic_string<_CharT, _ST, _SA>&&,
+          regex_set_results<typename std::basic_string<_CharT, _ST, _SA>::const_iterator>&,
+          regex_set_select = regex_set_select::all,
+          match_flag_type = std::regex_constants::match_default) const = delete;
+
+    template <typename _ST, typename _SA>
+    bool
+    match(const std::basic_string<_CharT, _ST, _SA>& __s,
+          match_flag_type __flags = std::regex_constants::match_default) const {
+      return match(__s.begin(), __s.end(), __flags);
+    }
+
+    /**
+     *  @brief  Finds the patterns that match in [__first, __last).
+     *  @return  Whether any does.
+     */
+    template <typename _BiIter>
+    bool
+    search(_BiIter __first, _BiIter __last, regex_set_results<_BiIter>& __m,
+           regex_set_select __sel = regex_set_select::all,
+           match_flag_type __flags = std::regex_constants::match_default) const {
+      return _M_run(__first, __last, __m, __sel, __flags, false);
+    }
+
+    template <typename _BiIter>
+    bool
+    search(_BiIter __first, _BiIter __last, match_flag_type __flags = std::regex_constants::match_default) const {
+      regex_set_results<_BiIter> __m;
+      return _M_run(__first, __last, __m, regex_set_select::first, __flags, false);
+    }
+
+    template <typename _ST, typename _SA>
+    bool
+    search(const std::basic_string<_CharT, _ST, _SA>& __s,
+           regex_set_results<typename std::basic_string<_CharT, _ST, _SA>::const_iterator>& __m,
+           regex_set_select __sel = regex_set_select::all,
+           match_flag_type __flags = std::regex_constants::match_default) const {
+      return search(__s.begin(), __s.end(), __m, __sel, __flags);
+    }
+
+    // Prevent unsafe attempts to get results from a temporary string.
+    template <typename _ST, typename _SA>
+    bool
+    search(const std::basic_string<_CharT, _ST, _SA>&&,
+           regex_set_results<typename std::basic_string<_CharT, _ST, _SA>::const_iterator>&,
+           regex_set_select = regex_set_select::all,
+           match_flag_type = std::regex_constants::match_default) const = delete;
+
+    template <typename _ST, typename _SA>
+    bool
+    search(const std::basic_string<_CharT, _ST, _SA>& __s,
+           match_flag_type __flags = std::regex_constants::match_default) const {
+      return search(__s.begin(), __s.end(), __flags);
+    }
+
+  private:
+    typedef std::__detail::_NFA<_TraitsT> _NFAT;
+    typedef std::__detail::_StateIdT _StateIdT;
+    typedef std::__detail::_Lazy_dfa<_TraitsT> _DfaT;
+
+    // How _M_bfs records the patterns matching.
+    enum _Bfs_mode {
+      _S_bfs_at_end,   // Those with a match ending at the end.
+      _S_bfs_anywhere, // Those with a match ending anywhere.
+      _S_bfs_last      // Those with the match ending last.
+    };
+
+    template <typename _FwdIter>
+    void
+    _M_compile(_FwdIter __first, _FwdIter __last);
+
+    static bool
+    _S_can_share(const _NFAT& __nfa);
+
+    template <typename _BiIter>
+    bool
+    _M_run(_BiIter __first, _BiIter __last, regex_set_results<_BiIter>& __m, regex_set_select __sel,
+           match_flag_type __flags, bool __match_mode) const;
+
+    template <typename _BiIter>
+    bool
+    _M_longest(_BiIter __first, _BiIter __last, match_flag_type __flags, std::vector<bool>& __found,
+               _BiIter& __start, _BiIter& __end) const;
+
+    template <typename _BiIter>
+    bool
+    _M_bfs(_BiIter __begin, _BiIter __s, _BiIter __e, match_flag_type __flags, bool __anchored, _Bfs_mode __mode,
+           std::vector<bool>& __found, _BiIter& __last) const;
+
+    flag_type _M_flags;
+    size_t _M_size;
+    // The patterns that share an automaton; null if none do.
+    std::shared_ptr<const _NFAT> _M_automaton;
+    // Their own automata, whose traits the matchers copied into
+    // _M_automaton refer to.
+    std::vector<std::shared_ptr<const _NFAT>> _M_parts;
+    // The others, with their index.
+    std::vector<std::pair<size_t, std::basic_regex<_CharT, _TraitsT>>> _M_singles;
+  };
+
+  typedef basic_regex_set<char> regex_set;
+#ifdef _GLIBCXX_USE_WCHAR_T
+  typedef basic_regex_set<wchar_t> wregex_set;
+#endif
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#include <ext/regex_set.tcc>
+
+#endif // C++11
+
+#endif // _REGEX_SET_H
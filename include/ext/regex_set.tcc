@@ -0,0 +1,306 @@
+// Regular expression sets implementation -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/regex_set.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/regex_set.h}
+ */
+
+#ifndef _REGEX_SET_TCC
+#define _REGEX_SET_TCC 1
+
+#include <algorithm>
+#include <iterator>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template <typename _CharT, typename _TraitsT>
+  template <typename _FwdIter>
+  void
+  basic_regex_set<_CharT, _TraitsT>::
+      _M_compile(_FwdIter __first, _FwdIter __last) {
+    auto __nfa = std::make_shared<_NFAT>(locale_type(), _M_flags);
+    std::vector<_StateIdT> __starts;
+    for (; __first != __last; ++__first, ++_M_size) {
+      const string_type __pattern(*__first);
+      std::__detail::_Compiler<_TraitsT> __c(__pattern.data(), __pattern.data() + __pattern.size(),
+                                             __nfa->_M_traits.getloc(), _M_flags);
+      const std::shared_ptr<const _NFAT> __part = __c._M_get_nfa();
+      if (!_S_can_share(*__part)) {
+        _M_singles.emplace_back(_M_size, std::basic_regex<_CharT, _TraitsT>(__pattern, _M_flags));
+        continue;
+      }
+
+      // Append the states, renumbered, and tag the accept state with the
+      // pattern index.
+      const _StateIdT __offset = __nfa->size();
+      for (const auto& __state : *__part) {
+        auto __s = __state;
+        if (__s._M_next >= 0)
+          __s._M_next += __offset;
+        if (__s._M_has_alt())
+          __s._M_alt += __offset;
+        else if (__s._M_opcode() == std::__detail::_S_opcode_accept)
+          __s._M_subexpr = _M_size;
+        __nfa->_M_insert_state(std::move(__s));
+      }
+      __starts.push_back(__part->_M_start() + __offset);
+      __nfa->_M_flags = __part->_M_options();
+      _M_parts.push_back(__part);
+    }
+    if (__starts.empty())
+      return;
+
+    // One alternative per pattern.
+    _StateIdT __start = __starts.back();
+    for (size_t __i = __starts.size() - 1; __i-- > 0;)
+      __start = __nfa->_M_insert_alt(__start, __starts[__i], false);
+    __nfa->_M_start_state = __start;
+    _M_automaton = std::move(__nfa);
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  bool
+  basic_regex_set<_CharT, _TraitsT>::
+      _S_can_share(const _NFAT& __nfa) {
+    if (__nfa._M_has_backref)
+      return false;
+    for (const auto& __state : __nfa)
+      if (__state._M_opcode() == std::__detail::_S_opcode_subexpr_lookahead
+          || __state._M_opcode() == std::__detail::_S_opcode_backref)
+        return false;
+    return true;
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  template <typename _BiIter>
+  bool
+  basic_regex_set<_CharT, _TraitsT>::
+      _M_run(_BiIter __first, _BiIter __last, regex_set_results<_BiIter>& __m, regex_set_select __sel,
+             match_flag_type __flags, bool __match_mode) const {
+    std::vector<bool> __found(_M_size);
+    std::sub_match<_BiIter> __range;
+    __range.first = __range.second = __last;
+
+    if (__sel == regex_set_select::leftmost_longest && !__match_mode) {
+      _BiIter __start = __last, __end = __last;
+      if (_M_longest(__first, __last, __flags, __found, __start, __end)) {
+        __range.first = __start;
+        __range.second = __end;
+        __range.matched = true;
+      }
+    } else {
+      if (_M_automaton) {
+        const bool __anchored = __match_mode || (__flags & std::regex_constants::match_continuous);
+        _BiIter __unused = __last;
+        if (_DfaT::_S_scan_set(*_M_automaton, __first, __last, __flags, __match_mode, __found) < 0)
+          _M_bfs(__first, __first, __last, __flags, __anchored, __match_mode ? _S_bfs_at_end : _S_bfs_anywhere,
+                 __found, __unused);
+      }
+      const size_t __lowest = std::find(__found.begin(), __found.end(), true) - __found.begin();
+      for (const auto& __single : _M_singles) {
+        if (__sel == regex_set_select::first && __lowest < __single.first)
+          break;
+        if (__match_mode ? std::regex_match(__first, __last, __single.second, __flags)
+                         : std::regex_search(__first, __last, __single.second, __flags)) {
+          __found[__single.first] = true;
+          if (__sel == regex_set_select::first)
+            break;
+        }
+      }
+      if (__match_mode) {
+        __range.first = __first;
+        __range.matched = true;
+      }
+    }
+
+    __m._M_patterns.clear();
+    for (size_t __i = 0; __i < _M_size; ++__i)
+      if (__found[__i]) {
+        __m._M_patterns.push_back(__i);
+        if (__sel != regex_set_select::all)
+          break;
+      }
+    if (__m._M_patterns.empty())
+      __range = std::sub_match<_BiIter>();
+    if (!__range.matched)
+      __range.first = __range.second = __last;
+    __m._M_match = __range;
+    __m._M_ready = true;
+    return !__m._M_patterns.empty();
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  template <typename _BiIter>
+  bool
+  basic_regex_set<_CharT, _TraitsT>::
+      _M_longest(_BiIter __first, _BiIter __last, match_flag_type __flags, std::vector<bool>& __found,
+                 _BiIter& __start, _BiIter& __end) const {
+    bool __any = false;
+    if (_M_automaton) {
+      int __r = _DfaT::_S_scan_longest(*_M_automaton, __first, __last, __flags, __found, __start, __end);
+      if (__r < 0) {
+        // Check there is a match at all before trying each start.
+        __found.assign(__found.size(), false);
+        const bool __continuous = __flags & std::regex_constants::match_continuous;
+        __r = _M_bfs(__first, __first, __last, __flags, __continuous, _S_bfs_anywhere, __found, __end);
+        if (__r) {
+          __found.assign(__found.size(), false);
+          for (__start = __first; !_M_bfs(__first, __start, __last, __flags, true, _S_bfs_last, __found, __end);
+               ++__start)
+            ;
+        }
+      }
+      __any = __r == 1;
+    }
+
+    // Leftmost wins, then longest, then the lowest pattern index.
+    for (const auto& __single : _M_singles) {
+      std::match_results<_BiIter> __sm;
+      if (!std::regex_search(__first, __last, __sm, __single.second, __flags))
+        continue;
+      if (__any) {
+        const auto __pos = __sm.position(0);
+        const auto __best_pos = std::distance(__first, __start);
+        const auto __best_len = std::distance(__start, __end);
+        if (__pos > __best_pos || (__pos == __best_pos && __sm.length(0) < __best_len))
+          continue;
+        if (__pos < __best_pos || __sm.length(0) > __best_len)
+          __found.assign(__found.size(), false);
+      }
+      __found[__single.first] = true;
+      __start = __sm[0].first;
+      __end = __sm[0].second;
+      __any = true;
+    }
+    return __any;
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  template <typename _BiIter>
+  bool
+  basic_regex_set<_CharT, _TraitsT>::
+      _M_bfs(_BiIter __begin, _BiIter __s, _BiIter __e, match_flag_type __flags, bool __anchored, _Bfs_mode __mode,
+             std::vector<bool>& __found, _BiIter& __last) const {
+    using namespace std::regex_constants;
+    const _NFAT& __nfa = *_M_automaton;
+    static const _CharT __w[2] = {'w'};
+    const auto __word_class = __nfa._M_traits.lookup_classname(__w, __w + 1);
+    auto __is_word = [&__nfa, __word_class](_CharT __c) { return __nfa._M_traits.isctype(__c, __word_class); };
+    const bool __not_null = __flags & match_not_null;
+    const bool __not_bow = (__flags & match_not_bow) && !(__flags & match_prev_avail);
+
+    // A thread is 2 * state + whether it has consumed a character.
+    std::vector<_StateIdT> __cur(1, 2 * __nfa._M_start()), __next, __stack, __matchers;
+    std::vector<size_t> __mark(2 * __nfa.size());
+    size_t __generation = 0;
+    bool __ret = false;
+    for (_BiIter __p = __s;; ++__p) {
+      const bool __at_end = __p == __e;
+      const bool __bol = __p == __begin && !(__flags & (match_not_bol | match_prev_avail));
+      const bool __eol = __at_end && !(__flags & match_not_eol);
+      bool __boundary = false;
+      if (!(__at_end && (__flags & match_not_eow))) {
+        const bool __left = (__p != __begin || (__flags & match_prev_avail)) && __is_word(*std::prev(__p));
+        __boundary = __left != (!__at_end && __is_word(*__p));
+      }
+
+      // Follow the transitions that consume nothing.
+      ++__generation;
+      __matchers.clear();
+      bool __accepted = false;
+      __stack.assign(__cur.begin(), __cur.end());
+      while (!__stack.empty()) {
+        const _StateIdT __t = __stack.back();
+        __stack.pop_back();
+        if (__t < 0 || __mark[__t] == __generation)
+          continue;
+        __mark[__t] = __generation;
+        const auto& __state = __nfa[__t / 2];
+        const _StateIdT __next_t = 2 * __state._M_next + __t % 2;
+        switch (__state._M_opcode()) {
+        case std::__detail::_S_opcode_alternative:
+        case std::__detail::_S_opcode_repeat:
+          __stack.push_back(__next_t);
+          __stack.push_back(2 * __state._M_alt + __t % 2);
+          break;
+        case std::__detail::_S_opcode_subexpr_begin:
+        case std::__detail::_S_opcode_subexpr_end:
+        case std::__detail::_S_opcode_dummy:
+          __stack.push_back(__next_t);
+          break;
+        case std::__detail::_S_opcode_line_begin_assertion:
+          if (__bol)
+            __stack.push_back(__next_t);
+          break;
+        case std::__detail::_S_opcode_line_end_assertion:
+          if (__eol)
+            __stack.push_back(__next_t);
+          break;
+        case std::__detail::_S_opcode_word_boundary:
+          // As in std::regex_search, match_not_bow holds wherever a match
+          // is tried, which is where a thread has consumed nothing, unless
+          // match_prev_avail is given.
+          if ((__boundary && !(__not_bow && __t % 2 == 0)) == !__state._M_neg)
+            __stack.push_back(__next_t);
+          break;
+        case std::__detail::_S_opcode_match:
+          __matchers.push_back(__t);
+          break;
+        case std::__detail::_S_opcode_accept:
+          if ((__mode == _S_bfs_at_end && !__at_end) || (__not_null && __t % 2 == 0))
+            break;
+          if (__mode == _S_bfs_last && !__accepted) {
+            __found.assign(__found.size(), false);
+            __last = __p;
+          }
+          __accepted = true;
+          __found[__state._M_subexpr] = true;
+          break;
+        default:
+          break;
+        }
+      }
+      __ret = __ret || __accepted;
+      if (__at_end)
+        break;
+
+      __next.clear();
+      for (auto __t : __matchers)
+        if (__nfa[__t / 2]._M_matches(*__p))
+          __next.push_back(2 * __nfa[__t / 2]._M_next + 1);
+      if (!__anchored)
+        __next.push_back(2 * __nfa._M_start());
+      if (__next.empty())
+        break;
+      __cur.swap(__next);
+    }
+    return __ret;
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // _REGEX_SET_TCC
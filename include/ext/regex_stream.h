@@ -0,0 +1,287 @@
+// Regular expression search over streams -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/regex_stream.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _REGEX_STREAM_H
+#define _REGEX_STREAM_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201103L
+
+#include <bitset>
+#include <ios>
+#include <memory>
+#include <regex>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /**
+   *  @brief  A match found by a basic_regex_stream_searcher.
+   *
+   *  Submatch 0 is the whole match.  Positions are offsets from the
+   *  beginning of the stream.
+   */
+  class regex_stream_match {
+  public:
+    typedef std::streamoff difference_type;
+    typedef size_t size_type;
+
+    /// One more than the number of marked subexpressions.
+    size_type
+    size() const noexcept { return _M_offsets.size() / 2; }
+
+    bool
+    matched(size_type __n = 0) const noexcept { return __n < size() && _M_offsets[2 * __n + 1] >= 0; }
+
+    /// Offset of the start of submatch @a __n, or -1 if it did not match.
+    difference_type
+    position(size_type __n = 0) const noexcept { return matched(__n) ? _M_offsets[2 * __n] : -1; }
+
+    difference_type
+    length(size_type __n = 0) const noexcept {
+      return matched(__n) ? _M_offsets[2 * __n + 1] - _M_offsets[2 * __n] : 0;
+    }
+
+  private:
+    template <typename, typename>
+    friend class basic_regex_stream_searcher;
+
+    // Start and end of each submatch, -1 if it did not match.
+    std::vector<std::streamoff> _M_offsets;
+  };
+
+  /**
+   *  @brief  Finds the matches of a regular expression in a stream.
+   *
+   *  The stream is fed in as chunks of any size, and the matches are,
+   *  but for the cases below, those std::regex_iterator would find over
+   *  the whole of it.  Each match is reported as soon as it is known to
+   *  be final, which may be a few chunks after it ends.  Only the
+   *  automaton state is carried from one chunk to the next, as in the
+   *  breadth-first simulation of std::regex_search; the input is not
+   *  kept, except for the text after the end of a match that may still
+   *  turn out longer or further left.
+   *
+   *  The flags apply to the stream as a whole: ^ and match_not_bol refer
+   *  to its beginning, $ and match_not_eol to its end.  With the POSIX
+   *  grammars the match is the leftmost longest one.
+   *
+   *  The matches can differ from std::regex_iterator's in three ways:
+   *  - The ECMAScript rules never repeat a subexpression once more when
+   *    that matches nothing, whereas std::regex_search does once, so
+   *    where a repeated subexpression can match the empty string the two
+   *    may differ.
+   *  - Until its first match, std::regex_iterator makes \\b fail under
+   *    match_not_bow at every position it tries a match from, not only at
+   *    the beginning; (\\Bba+) finds "ba" in " ba " there and not here.
+   *  - After an empty match, std::regex_iterator first tries a non-empty
+   *    one at the same position without match_prev_avail, so there ^ and
+   *    \\b take it for the beginning; (^a)|\\b finds both the empty match
+   *    and "a" at 1 in "\\na" there, and only the empty one here.
+   *
+   *  Back-references and lookaheads need the input to be kept, and are
+   *  not supported.
+   */
+  template <typename _CharT, typename _TraitsT = std::regex_traits<_CharT>>
+  class basic_regex_stream_searcher {
+  public:
+    typedef _CharT value_type;
+    typedef _TraitsT traits_type;
+    typedef typename traits_type::string_type string_type;
+    typedef std::regex_constants::syntax_option_type flag_type;
+    typedef std::regex_constants::match_flag_type match_flag_type;
+
+    /**
+     *  @brief  Compiles the pattern [__first, __last).
+     *  @throw  std::regex_error  If the pattern is not valid, or has
+     *                            back-references or lookaheads.
+     *
+     *  A back-reference is reported as error_backref, or as
+     *  error_complexity when __f has regex_constants::__polynomial, and a
+     *  lookahead as error_complexity.
+     */
+    template <typename _FwdIter>
+    basic_regex_stream_searcher(_FwdIter __first, _FwdIter __last, flag_type __f = std::regex_constants::ECMAScript,
+                                match_flag_type __m = std::regex_constants::match_default)
+        : _M_nfa(std::__detail::__compile_nfa<_TraitsT>(__first, __last, typename _TraitsT::locale_type(), __f)),
+          _M_flags(__m) { _M_init(); }
+
+    explicit basic_regex_stream_searcher(const string_type& __s, flag_type __f = std::regex_constants::ECMAScript,
+                                         match_flag_type __m = std::regex_constants::match_default)
+        : basic_regex_stream_searcher(__s.begin(), __s.end(), __f, __m) {}
+
+    explicit basic_regex_stream_searcher(const _CharT* __p, flag_type __f = std::regex_constants::ECMAScript,
+                                         match_flag_type __m = std::regex_constants::match_default)
+        : basic_regex_stream_searcher(__p, __p + _TraitsT::length(__p), __f, __m) {}
+
+    /// Number of marked subexpressions.
+    size_t
+    mark_count() const noexcept { return _M_nfa->_M_sub_count() - 1; }
+
+    /// Number of characters fed since the beginning of the stream.
+    std::streamoff
+    position() const noexcept { return _M_fed; }
+
+    /// Number of characters kept until a match is known to be final.
+    size_t
+    buffered() const noexcept { return _M_replay.size(); }
+
+    /**
+     *  @brief  Feeds the next characters [__first, __last) of the stream.
+     *
+     *  Calls __f(const regex_stream_match&) for each match that is now
+     *  known to be final.  If __f throws, the searcher must be reset
+     *  before it is used again.
+     */
+    template <typename _InIter, typename _Func>
+    void
+    feed(_InIter __first, _InIter __last, _Func __f);
+
+    /**
+     *  @brief  Ends the stream, calling __f for the matches left.
+     *
+     *  The searcher is then ready for a new stream.
+     */
+    template <typename _Func>
+    void
+    finish(_Func __f) {
+      while (_M_step(nullptr))
+        _M_report(__f);
+      reset();
+    }
+
+    /// Forgets the stream fed so far.
+    void
+    reset() noexcept;
+
+    /**
+     *  @brief  Searches the rest of __sb, calling __f for each match.
+     *  @return  The number of characters read.
+     *
+     *  Starts a new stream, and reads __sb to its end in chunks.
+     */
+    template <typename _ST, typename _Func>
+    std::streamoff
+    search(std::basic_streambuf<_CharT, _ST>& __sb, _Func __f);
+
+  private:
+    typedef std::__detail::_NFA<_TraitsT> _NFAT;
+    typedef std::__detail::_StateIdT _StateIdT;
+
+    // A state to follow, or with _M_id == _S_restore a submatch offset
+    // to put back once the states after it have been followed.
+    struct _Item {
+      _StateIdT _M_id;
+      size_t _M_index;
+      std::streamoff _M_offset;
+    };
+
+    enum : _StateIdT { _S_restore = -2 };
+    enum : size_t { _S_chunk_size = 4096 };
+
+    void
+    _M_init();
+
+    bool
+    _M_is_word(_CharT __c) const { return _M_nfa->_M_traits.isctype(__c, _M_word_class); }
+
+    bool
+    _M_can_start(_CharT __c) const {
+      if (sizeof(_CharT) == 1)
+        return _M_first_set[static_cast<unsigned char>(__c)];
+      for (auto __i : _M_first)
+        if ((*_M_nfa)[__i]._M_matches(__c))
+          return true;
+      return false;
+    }
+
+    // Moves past the character *__c, or the end of the stream if null.
+    // Returns whether the match found is now final.
+    bool
+    _M_step(const _CharT* __c);
+
+    // Reports the final match and feeds again what followed it, which
+    // may hold more matches.
+    template <typename _Func>
+    void
+    _M_report(_Func& __f);
+
+    std::shared_ptr<const _NFAT> _M_nfa;
+    match_flag_type _M_flags;
+    typename _TraitsT::char_class_type _M_word_class;
+    size_t _M_width; // Offsets per thread.
+    // The states matching the first character of a match, and for
+    // char-sized types the characters they match.
+    std::vector<_StateIdT> _M_first;
+    std::bitset<256> _M_first_set;
+    bool _M_nullable; // Whether a match can be empty.
+
+    std::streamoff _M_fed;
+    std::streamoff _M_pos; // Offset of the next character.
+    _CharT _M_prev;
+    bool _M_has_prev;
+    // Where the search for the next match started, and where it must not
+    // find an empty one, or -1.
+    std::streamoff _M_search_start;
+    std::streamoff _M_no_empty_at;
+
+    // The threads, in order of priority, and their submatch offsets.
+    std::vector<_StateIdT> _M_threads, _M_next_threads;
+    std::vector<std::streamoff> _M_offsets, _M_next_offsets;
+    std::vector<std::streamoff> _M_work;
+    std::vector<_Item> _M_stack;
+    std::vector<unsigned> _M_mark;
+    unsigned _M_generation;
+
+    // The best match so far, the character before its end, and the input
+    // from its end on.
+    bool _M_has_match;
+    std::vector<std::streamoff> _M_match;
+    _CharT _M_match_prev;
+    bool _M_match_has_prev;
+    std::basic_string<_CharT> _M_replay, _M_spare;
+    regex_stream_match _M_result;
+  };
+
+  typedef basic_regex_stream_searcher<char> regex_stream_searcher;
+#ifdef _GLIBCXX_USE_WCHAR_T
+  typedef basic_regex_stream_searcher<wchar_t> wregex_stream_searcher;
+#endif
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#include <ext/regex_stream.tcc>
+
+#endif // C++11
+
+#endif // _REGEX_STREAM_H
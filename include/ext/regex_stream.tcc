@@ -0,0 +1,338 @@
+// Regular expression search over streams implementation -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/regex_stream.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/regex_stream.h}
+ */
+
+#ifndef _REGEX_STREAM_TCC
+#define _REGEX_STREAM_TCC 1
+
+#include <algorithm>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template <typename _CharT, typename _TraitsT>
+  void
+  basic_regex_stream_searcher<_CharT, _TraitsT>::
+      _M_init() {
+    const _NFAT& __nfa = *_M_nfa;
+    if (__nfa._M_has_backref)
+      std::__throw_regex_error(std::regex_constants::error_backref,
+                               "Back-references cannot be matched over a stream.");
+    // No standard code says "unsupported"; error_complexity is the one
+    // std::regex already uses for what its matchers refuse to do.
+    for (const auto& __state : __nfa)
+      if (__state._M_opcode() == std::__detail::_S_opcode_subexpr_lookahead)
+        std::__throw_regex_error(std::regex_constants::error_complexity,
+                                 "Lookaheads cannot be matched over a stream.");
+
+    static const _CharT __w[2] = {'w'};
+    _M_word_class = __nfa._M_traits.lookup_classname(__w, __w + 1);
+    _M_width = 2 * __nfa._M_sub_count();
+    _M_work.resize(_M_width);
+    _M_mark.assign(__nfa.size(), 0);
+    _M_generation = 1;
+
+    // The states that can consume the first character of a match, taking
+    // every assertion to hold.
+    _M_nullable = false;
+    std::vector<_StateIdT> __stack(1, __nfa._M_start());
+    while (!__stack.empty()) {
+      const _StateIdT __i = __stack.back();
+      __stack.pop_back();
+      if (__i < 0 || _M_mark[__i])
+        continue;
+      _M_mark[__i] = 1;
+      const auto& __state = __nfa[__i];
+      if (__state._M_opcode() == std::__detail::_S_opcode_match)
+        _M_first.push_back(__i);
+      else if (__state._M_opcode() == std::__detail::_S_opcode_accept)
+        _M_nullable = true;
+      else {
+        __stack.push_back(__state._M_next);
+        if (__state._M_opcode() == std::__detail::_S_opcode_alternative
+            || __state._M_opcode() == std::__detail::_S_opcode_repeat)
+          __stack.push_back(__state._M_alt);
+      }
+    }
+    if (sizeof(_CharT) == 1)
+      for (unsigned __c = 0; __c < 256; ++__c)
+        for (auto __i : _M_first)
+          if (__nfa[__i]._M_matches(static_cast<_CharT>(__c)))
+            _M_first_set.set(__c);
+    reset();
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  void
+  basic_regex_stream_searcher<_CharT, _TraitsT>::
+      reset() noexcept {
+    _M_fed = 0;
+    _M_pos = 0;
+    _M_prev = _CharT();
+    _M_has_prev = false;
+    _M_search_start = 0;
+    _M_no_empty_at = -1;
+    _M_threads.clear();
+    _M_offsets.clear();
+    _M_has_match = false;
+    _M_match_prev = _CharT();
+    _M_match_has_prev = false;
+    _M_replay.clear();
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  bool
+  basic_regex_stream_searcher<_CharT, _TraitsT>::
+      _M_step(const _CharT* __c) {
+    using namespace std::regex_constants;
+    const _NFAT& __nfa = *_M_nfa;
+    // No match can start at a character none of _M_first matches.
+    if (__c && _M_threads.empty() && !_M_has_match && !_M_nullable && !_M_can_start(*__c)) {
+      _M_prev = *__c;
+      _M_has_prev = true;
+      ++_M_pos;
+      return false;
+    }
+    const bool __ecma = __nfa._M_flags & ECMAScript;
+    const bool __at_end = __c == nullptr;
+    const bool __at_begin = _M_pos == 0;
+    const bool __bol = __at_begin && !(_M_flags & (match_not_bol | match_prev_avail));
+    const bool __eol = __at_end && !(_M_flags & match_not_eol);
+    // Whether at a word boundary, worked out when first needed.
+    int __boundary = -1;
+    // A new thread starts here unless a match has been found.  After an
+    // empty match, std::regex_iterator looks for a longer one at the
+    // same place, then anywhere from the next character on.
+    bool __start = !_M_has_match;
+    if (__start && (_M_flags & match_continuous))
+      __start = _M_pos == _M_search_start || (_M_pos == _M_search_start + 1 && _M_no_empty_at == _M_search_start);
+
+    if (++_M_generation == 0) {
+      _M_mark.assign(_M_mark.size(), 0);
+      _M_generation = 1;
+    }
+    _M_next_threads.clear();
+    _M_next_offsets.clear();
+    bool __accepted = false;
+    bool __cut = false;
+    const size_t __n = _M_threads.size();
+    for (size_t __i = 0; __i <= __n && !__cut; ++__i) {
+      if (__i < __n) {
+        const auto __o = _M_offsets.begin() + __i * _M_width;
+        std::copy(__o, __o + _M_width, _M_work.begin());
+        _M_stack.push_back({_M_threads[__i], 0, 0});
+      } else if (__start) {
+        std::fill(_M_work.begin(), _M_work.end(), -1);
+        _M_stack.push_back({__nfa._M_start(), 0, 0});
+      }
+
+      // Follow the transitions that consume nothing, depth first so that
+      // the states are reached in order of priority.
+      while (!_M_stack.empty()) {
+        const _Item __item = _M_stack.back();
+        _M_stack.pop_back();
+        if (__item._M_id == _S_restore) {
+          _M_work[__item._M_index] = __item._M_offset;
+          continue;
+        }
+        if (__item._M_id < 0 || _M_mark[__item._M_id] == _M_generation)
+          continue;
+        _M_mark[__item._M_id] = _M_generation;
+        const auto& __state = __nfa[__item._M_id];
+        const _Item __next = {__state._M_next, 0, 0};
+        const _Item __alt = {__state._M_alt, 0, 0};
+        switch (__state._M_opcode()) {
+        case std::__detail::_S_opcode_alternative:
+          _M_stack.push_back(__next);
+          _M_stack.push_back(__alt);
+          break;
+        case std::__detail::_S_opcode_repeat:
+          // _M_alt is one more time, the greedy choice.
+          _M_stack.push_back(__state._M_neg ? __alt : __next);
+          _M_stack.push_back(__state._M_neg ? __next : __alt);
+          break;
+        case std::__detail::_S_opcode_subexpr_begin:
+        case std::__detail::_S_opcode_subexpr_end: {
+          const size_t __k = 2 * __state._M_subexpr + (__state._M_opcode() == std::__detail::_S_opcode_subexpr_end);
+          // Nothing left to follow would see the old offset.
+          if (!_M_stack.empty())
+            _M_stack.push_back({_S_restore, __k, _M_work[__k]});
+          _M_work[__k] = _M_pos;
+          _M_stack.push_back(__next);
+          break;
+        }
+        case std::__detail::_S_opcode_dummy:
+          _M_stack.push_back(__next);
+          break;
+        case std::__detail::_S_opcode_line_begin_assertion:
+          if (__bol)
+            _M_stack.push_back(__next);
+          break;
+        case std::__detail::_S_opcode_line_end_assertion:
+          if (__eol)
+            _M_stack.push_back(__next);
+          break;
+        case std::__detail::_S_opcode_word_boundary:
+          if (__boundary < 0)
+            __boundary = !(__at_begin && (_M_flags & match_not_bow)) && !(__at_end && (_M_flags & match_not_eow))
+                         && (_M_has_prev && _M_is_word(_M_prev)) != (!__at_end && _M_is_word(*__c));
+          if (__boundary == !__state._M_neg)
+            _M_stack.push_back(__next);
+          break;
+        case std::__detail::_S_opcode_match:
+          if (__at_end || !__state._M_matches(*__c))
+            break;
+          // With POSIX, only the threads starting no later than the
+          // match found can still beat it.
+          if (!__ecma && _M_has_match && _M_work[0] > _M_match[0])
+            break;
+          _M_next_threads.push_back(__state._M_next);
+          _M_next_offsets.resize(_M_next_offsets.size() + _M_width);
+          std::copy(_M_work.begin(), _M_work.end(), _M_next_offsets.end() - _M_width);
+          break;
+        case std::__detail::_S_opcode_accept: {
+          const bool __empty = _M_work[0] == _M_pos;
+          if (__empty && ((_M_flags & match_not_null) || _M_pos == _M_no_empty_at))
+            break;
+          if (__ecma) {
+            // The threads left have a lower priority.
+            __cut = true;
+            _M_stack.clear();
+          } else if (_M_has_match
+                     && (_M_work[0] > _M_match[0] || (_M_work[0] == _M_match[0] && _M_pos <= _M_match[1])))
+            break;
+          _M_match.assign(_M_work.begin(), _M_work.end());
+          _M_has_match = true;
+          __accepted = true;
+          break;
+        }
+        default:
+          break;
+        }
+      }
+    }
+
+    if (__accepted) {
+      _M_match_prev = _M_prev;
+      _M_match_has_prev = _M_has_prev;
+      _M_replay.clear();
+    }
+    if (__at_end)
+      return _M_has_match;
+    if (_M_has_match)
+      _M_replay.push_back(*__c);
+    _M_threads.swap(_M_next_threads);
+    _M_offsets.swap(_M_next_offsets);
+    _M_prev = *__c;
+    _M_has_prev = true;
+    ++_M_pos;
+    return _M_has_match && _M_threads.empty();
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  template <typename _InIter, typename _Func>
+  void
+  basic_regex_stream_searcher<_CharT, _TraitsT>::
+      feed(_InIter __first, _InIter __last, _Func __f) {
+    while (__first != __last) {
+      // Between matches, pass over the characters no match starts at.
+      if (_M_threads.empty() && !_M_has_match && !_M_nullable) {
+        std::streamoff __n = 0;
+        for (; __first != __last && !_M_can_start(*__first); ++__first, ++__n)
+          _M_prev = *__first;
+        if (__n) {
+          _M_fed += __n;
+          _M_pos += __n;
+          _M_has_prev = true;
+          continue;
+        }
+      }
+      const _CharT __c = *__first;
+      ++__first;
+      ++_M_fed;
+      if (_M_step(&__c))
+        _M_report(__f);
+    }
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  template <typename _Func>
+  void
+  basic_regex_stream_searcher<_CharT, _TraitsT>::
+      _M_report(_Func& __f) {
+    bool __again;
+    do {
+      _M_result._M_offsets.assign(_M_match.begin(), _M_match.end());
+
+      // Search again from the end of the match, as std::regex_iterator
+      // does, over the input kept since then.
+      _M_pos = _M_match[1];
+      _M_prev = _M_match_prev;
+      _M_has_prev = _M_match_has_prev;
+      _M_search_start = _M_pos;
+      _M_no_empty_at = _M_match[0] == _M_match[1] ? _M_pos : -1;
+      _M_threads.clear();
+      _M_offsets.clear();
+      _M_has_match = false;
+      _M_spare.swap(_M_replay);
+      _M_replay.clear();
+
+      const regex_stream_match& __m = _M_result;
+      __f(__m);
+
+      __again = false;
+      for (size_t __i = 0; __i < _M_spare.size() && !__again; ++__i)
+        if (_M_step(&_M_spare[__i])) {
+          _M_replay.append(_M_spare, __i + 1, string_type::npos);
+          __again = true;
+        }
+    } while (__again);
+  }
+
+  template <typename _CharT, typename _TraitsT>
+  template <typename _ST, typename _Func>
+  std::streamoff
+  basic_regex_stream_searcher<_CharT, _TraitsT>::
+      search(std::basic_streambuf<_CharT, _ST>& __sb, _Func __f) {
+    reset();
+    _CharT __buf[_S_chunk_size];
+    for (;;) {
+      const std::streamsize __len = __sb.sgetn(__buf, _S_chunk_size);
+      if (__len <= 0)
+        break;
+      feed(__buf, __buf + __len, __f);
+    }
+    const std::streamoff __read = _M_fed;
+    finish(__f);
+    return __read;
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // _REGEX_STREAM_TCC
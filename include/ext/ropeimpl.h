@@ -126,12 +126,12 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	  return;
 	}
       __curr_rope = __x._M_root;
-      if (0 != __curr_rope->_M_c_string)
+      if (__GC_CONST _CharT* __cstr = __curr_rope->_M_published_c_string())
 	{
 	  /* Treat the root as a leaf. */
-	  __x._M_buf_start = __curr_rope->_M_c_string;
-	  __x._M_buf_end = __curr_rope->_M_c_string + __curr_rope->_M_size;
-	  __x._M_buf_ptr = __curr_rope->_M_c_string + __pos;
+	  __x._M_buf_start = __cstr;
+	  __x._M_buf_end = __cstr + __curr_rope->_M_size;
+	  __x._M_buf_ptr = __cstr + __pos;
 	  __x._M_path_end[0] = __curr_rope;
 	  __x._M_leaf_index = 0;
 	  __x._M_leaf_pos = 0;
@@ -979,6 +979,185 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	}
     }
 
+  template<class _CharT, class _Alloc>
+    template<class _Function>
+      void
+      rope<_CharT, _Alloc>::
+      _S_for_each_chunk(const _RopeRep* __r, size_t __begin, size_t __end,
+			_Function& __f)
+      {
+	while (0 != __r && __begin < __end)
+	  {
+	    switch(__r->_M_tag)
+	      {
+	      case __detail::_S_concat:
+		{
+		  const _RopeConcatenation* __conc =
+		    (const _RopeConcatenation*)__r;
+		  const _RopeRep* __left = __conc->_M_left;
+		  size_t __left_len = __left->_M_size;
+		  if (__end <= __left_len)
+		    {
+		      __r = __left;
+		      continue;
+		    }
+		  if (__begin < __left_len)
+		    _S_for_each_chunk(__left, __begin, __left_len, __f);
+		  // Loop on the right child rather than recursing.
+		  __r = __conc->_M_right;
+		  __begin = __begin > __left_len ? __begin - __left_len : 0;
+		  __end -= __left_len;
+		  continue;
+		}
+	      case __detail::_S_leaf:
+		{
+		  const _RopeLeaf* __l = (const _RopeLeaf*)__r;
+		  __f((const _CharT*)__l->_M_data + __begin, __end - __begin);
+		  return;
+		}
+	      case __detail::_S_substringfn:
+		{
+		  // Substrings of leaves can be visited in place.
+		  const _RopeSubstring* __sub = (const _RopeSubstring*)__r;
+		  if (__detail::_S_leaf == __sub->_M_base->_M_tag)
+		    {
+		      __r = __sub->_M_base;
+		      __begin += __sub->_M_start;
+		      __end += __sub->_M_start;
+		      continue;
+		    }
+		}
+		// Fall through.
+	      case __detail::_S_function:
+		{
+		  const _RopeFunction* __fn = (const _RopeFunction*)__r;
+		  const size_t __buf_len = std::min(__end - __begin, size_t(4096));
+		  _CharT* __buffer = rope::_Data_allocate(__buf_len);
+		  __try
+		    {
+		      for (size_t __pos = __begin; __pos < __end; )
+			{
+			  size_t __n = std::min(__end - __pos, __buf_len);
+			  (*(__fn->_M_fn))(__pos, __n, __buffer);
+			  __f((const _CharT*)__buffer, __n);
+			  __pos += __n;
+			}
+		    }
+		  __catch(...)
+		    {
+		      rope::_Data_deallocate(__buffer, __buf_len);
+		      __throw_exception_again;
+		    }
+		  rope::_Data_deallocate(__buffer, __buf_len);
+		  return;
+		}
+	      default:
+		return;
+	      }
+	  }
+      }
+
+#if __cplusplus >= 201103L
+  template<class _CharT, class _Alloc>
+    bool
+    rope<_CharT, _Alloc>::
+    _S_is_plain(const _RopeRep* __r)
+    {
+      while (0 != __r)
+	{
+	  switch(__r->_M_tag)
+	    {
+	    case __detail::_S_concat:
+	      {
+		const _RopeConcatenation* __c = (const _RopeConcatenation*)__r;
+		if (!_S_is_plain(__c->_M_left))
+		  return false;
+		__r = __c->_M_right;
+		break;
+	      }
+	    case __detail::_S_leaf:
+	      return true;
+	    case __detail::_S_substringfn:
+	      return (__detail::_S_leaf
+		      == ((const _RopeSubstring*)__r)->_M_base->_M_tag);
+	    default:
+	      return false;
+	    }
+	}
+      return true;
+    }
+
+  template<class _CharT, class _Alloc>
+    void
+    rope<_CharT, _Alloc>::
+    _S_split_for_flatten(_RopeRep* __r, _CharT* __dest, size_t __grain,
+			 _Flatten_job& __job)
+    {
+      while (__detail::_S_concat == __r->_M_tag && __r->_M_size > __grain)
+	{
+	  _RopeConcatenation* __c = (_RopeConcatenation*)__r;
+	  _S_split_for_flatten(__c->_M_left, __dest, __grain, __job);
+	  __dest += __c->_M_left->_M_size;
+	  __r = __c->_M_right;
+	}
+      __job._M_nodes.push_back(__r);
+      __job._M_dest.push_back(__dest);
+    }
+
+  template<class _CharT, class _Alloc>
+    void*
+    rope<_CharT, _Alloc>::
+    _S_flatten_worker(void* __p)
+    {
+      _Flatten_job* __job = static_cast<_Flatten_job*>(__p);
+      const size_t __n = __job->_M_nodes.size();
+      for (;;)
+	{
+	  size_t __i = __atomic_fetch_add(&__job->_M_next, 1, __ATOMIC_RELAXED);
+	  if (__i >= __n)
+	    return 0;
+	  _S_flatten(__job->_M_nodes[__i], __job->_M_dest[__i]);
+	}
+    }
+
+  template<class _CharT, class _Alloc>
+    void
+    rope<_CharT, _Alloc>::
+    parallel_copy(_CharT* __buffer, unsigned __max_threads) const
+    {
+      const size_t __size = size();
+      size_t __threads = __max_threads;
+      if (__threads == 0)
+	__threads = std::min(__size / size_t(_S_parallel_copy_min), size_t(8));
+#ifdef _GLIBCXX_HAS_GTHREADS
+      if (__threads > 1 && __size >= size_t(_S_parallel_copy_min)
+	  && __is_trivial(_CharT) && __gthread_active_p()
+	  && _S_is_plain(this->_M_tree_ptr))
+	{
+	  // A few subtrees per thread, so uneven ones balance out.
+	  _Flatten_job __job;
+	  __job._M_next = 0;
+	  _S_split_for_flatten(this->_M_tree_ptr, __buffer,
+			       __size / (4 * __threads) + 1, __job);
+	  if (__threads > __job._M_nodes.size())
+	    __threads = __job._M_nodes.size();
+	  std::vector<__gthread_t> __ids(__threads - 1);
+	  size_t __started = 0;
+	  for (; __started < __ids.size(); ++__started)
+	    if (__gthread_create(&__ids[__started], &_S_flatten_worker,
+				 &__job) != 0)
+	      break;
+	  // Whatever the other threads leave is done here.
+	  _S_flatten_worker(&__job);
+	  for (size_t __i = 0; __i < __started; ++__i)
+	    __gthread_join(__ids[__i], 0);
+	  return;
+	}
+#endif
+      copy(__buffer);
+    }
+#endif
+
   template<class _CharT, class _Traits>
     inline void
     _Rope_fill(basic_ostream<_CharT, _Traits>& __o, size_t __n)
@@ -1130,7 +1309,7 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 #else
 	  printf("Concatenation %p (rc = %ld, depth = %d, "
 		 "len = %ld, %s balanced)\n",
-		 __r, __r->_M_ref_count, __r->_M_depth, __r->_M_size,
+		 __r, (long)__r->_M_ref_count, __r->_M_depth, __r->_M_size,
 		 __r->_M_is_balanced? "" : "not");
 #endif
 	  _S_dump(__left, __indent + 2);
@@ -1160,7 +1339,7 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 		 __kind, __r, __r->_M_depth, __r->_M_size);
 #else
 	  printf("%s %p (rc = %ld, depth = %d, len = %ld) ",
-		 __kind, __r, __r->_M_ref_count, __r->_M_depth, __r->_M_size);
+		 __kind, __r, (long)__r->_M_ref_count, __r->_M_depth, __r->_M_size);
 #endif
 	  if (_S_is_one_byte_char_type((_CharT*)0))
 	    {
@@ -1318,7 +1497,7 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
     rope<_CharT, _Alloc>::
     _S_fetch(_RopeRep* __r, size_type __i)
     {
-      __GC_CONST _CharT* __cstr = __r->_M_c_string;
+      __GC_CONST _CharT* __cstr = __r->_M_published_c_string();
       
       if (0 != __cstr)
 	return __cstr[__i];
@@ -1613,17 +1792,51 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 	                                           // but probably fast.
 	  return _S_empty_c_str;
 	}
-      __gthread_mutex_lock (&this->_M_tree_ptr->_M_c_string_lock);
-      __GC_CONST _CharT* __result = this->_M_tree_ptr->_M_c_string;
-      if (0 == __result)
+      // The first caller claims the node by swapping in the flattening
+      // tag; the others wait until it publishes its string, or gives up
+      // on an exception and leaves the node for the next one to claim.
+      __GC_CONST _CharT** const __slot = &this->_M_tree_ptr->_M_c_string;
+      __GC_CONST _CharT* const __flattening =
+	_RopeRep::_S_flattening_c_string();
+      __GC_CONST _CharT* __result = __atomic_load_n(__slot, __ATOMIC_ACQUIRE);
+      for (;;)
+	{
+	  if (0 == __result)
+	    {
+	      if (__atomic_compare_exchange_n(__slot, &__result, __flattening,
+					      false, __ATOMIC_ACQUIRE,
+					      __ATOMIC_ACQUIRE))
+		break;
+	    }
+	  else if (__flattening == __result)
+	    {
+	      __gthread_yield();
+	      __result = __atomic_load_n(__slot, __ATOMIC_ACQUIRE);
+	    }
+	  else
+	    return __result;
+	}
+      size_t __s = size();
+      __try
 	{
-	  size_t __s = size();
 	  __result = this->_Data_allocate(__s + 1);
-	  _S_flatten(this->_M_tree_ptr, __result);
-	  __result[__s] = _S_eos((_CharT*)0);
-	  this->_M_tree_ptr->_M_c_string = __result;
+	  __try
+	    {
+	      _S_flatten(this->_M_tree_ptr, __result);
+	    }
+	  __catch(...)
+	    {
+	      this->_Data_deallocate(__result, __s + 1);
+	      __throw_exception_again;
+	    }
 	}
-      __gthread_mutex_unlock (&this->_M_tree_ptr->_M_c_string_lock);
+      __catch(...)
+	{
+	  __atomic_store_n(__slot, (__GC_CONST _CharT*)0, __ATOMIC_RELEASE);
+	  __throw_exception_again;
+	}
+      __result[__s] = _S_eos((_CharT*)0);
+      __atomic_store_n(__slot, __result, __ATOMIC_RELEASE);
       return(__result);
     }
   
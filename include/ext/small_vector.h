@@ -0,0 +1,814 @@
+// Vector with inline storage -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/small_vector.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _SMALL_VECTOR_H
+#define _SMALL_VECTOR_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <bits/functexcept.h>
+#include <bits/stl_algobase.h>
+#include <bits/stl_construct.h>
+#include <bits/stl_iterator.h>
+#include <bits/stl_uninitialized.h>
+#include <ext/alloc_traits.h>
+#include <ext/numeric_traits.h>
+#include <initializer_list>
+#include <memory>
+
+#include <debug/assertions.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Storage for small_vector: the usual three pointers plus an inline
+  /// buffer of _Nm elements that is used until the contents outgrow it.
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  struct _Small_vector_base {
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Tp>::other _Tp_alloc_type;
+    typedef typename __alloc_traits<_Tp_alloc_type>::pointer pointer;
+
+    // The inline buffer can only be addressed through a plain _Tp*.
+    static_assert(std::is_pointer<pointer>::value,
+                  "__gnu_cxx::small_vector requires an allocator with raw pointers");
+
+    struct _Small_vector_impl : public _Tp_alloc_type {
+      pointer _M_start;
+      pointer _M_finish;
+      pointer _M_end_of_storage;
+      // Left uninitialized, elements are constructed on demand.
+      alignas(_Tp) unsigned char _M_storage[sizeof(_Tp) * (_Nm ? _Nm : 1)];
+
+      _Small_vector_impl() noexcept(
+          std::is_nothrow_default_constructible<_Tp_alloc_type>::value)
+          : _Tp_alloc_type() { _M_reset(); }
+
+      _Small_vector_impl(_Tp_alloc_type const& __a) noexcept
+          : _Tp_alloc_type(__a) { _M_reset(); }
+
+      _Small_vector_impl(_Tp_alloc_type&& __a) noexcept
+          : _Tp_alloc_type(std::move(__a)) { _M_reset(); }
+
+      // The pointers may refer to _M_storage, so never copy them.
+      _Small_vector_impl(const _Small_vector_impl&) = delete;
+
+      pointer
+      _M_inline() noexcept { return static_cast<pointer>(static_cast<void*>(_M_storage)); }
+
+      const _Tp*
+      _M_inline() const noexcept { return static_cast<const _Tp*>(static_cast<const void*>(_M_storage)); }
+
+      bool
+      _M_is_inline() const noexcept { return _M_start == _M_inline(); }
+
+      void
+      _M_reset() noexcept {
+        _M_start = _M_finish = _M_inline();
+        _M_end_of_storage = _M_start + _Nm;
+      }
+    };
+    // _Small_vector_impl ==================================================
+
+  public:
+    typedef _Alloc allocator_type;
+
+    _Tp_alloc_type&
+    _M_get_Tp_allocator() noexcept { return this->_M_impl; }
+
+    const _Tp_alloc_type&
+    _M_get_Tp_allocator() const noexcept { return this->_M_impl; }
+
+    allocator_type
+    get_allocator() const noexcept { return allocator_type(_M_get_Tp_allocator()); }
+
+    _Small_vector_base() = default;
+
+    _Small_vector_base(const allocator_type& __a) noexcept
+        : _M_impl(_Tp_alloc_type(__a)) {}
+
+    _Small_vector_base(_Tp_alloc_type&& __a) noexcept
+        : _M_impl(std::move(__a)) {}
+
+    _Small_vector_base(size_t __n, const allocator_type& __a)
+        : _M_impl(_Tp_alloc_type(__a)) { _M_create_storage(__n); }
+
+    ~_Small_vector_base() noexcept {
+      _M_deallocate(_M_impl._M_start,
+                    _M_impl._M_end_of_storage - _M_impl._M_start);
+    }
+
+  public:
+    _Small_vector_impl _M_impl;
+
+    pointer
+    _M_allocate(size_t __n) {
+      typedef __alloc_traits<_Tp_alloc_type> _Tr;
+      return __n != 0 ? _Tr::allocate(_M_impl, __n) : pointer();
+    }
+
+    // Unlike _Vector_base::_M_deallocate this must be handed the inline
+    // buffer too, it simply does nothing for it.
+    void
+    _M_deallocate(pointer __p, size_t __n) {
+      typedef __alloc_traits<_Tp_alloc_type> _Tr;
+      if (__p && __p != _M_impl._M_inline())
+        _Tr::deallocate(_M_impl, __p, __n);
+    }
+
+  protected:
+    void
+    _M_create_storage(size_t __n) {
+      if (__n > _Nm) {
+        this->_M_impl._M_start = this->_M_allocate(__n);
+        this->_M_impl._M_finish = this->_M_impl._M_start;
+        this->_M_impl._M_end_of_storage = this->_M_impl._M_start + __n;
+      }
+    }
+  };
+
+  /**
+   *  @brief A sequence container with the interface of std::vector that
+   *  keeps up to @a _Nm elements inside the object itself.
+   *
+   *  @tparam _Tp  Type of element.
+   *  @tparam _Nm  Number of elements stored inline.
+   *  @tparam _Alloc  Allocator type, used once the inline buffer is full.
+   *
+   *  Growth beyond the inline capacity follows std::vector: the capacity
+   *  doubles and elements are relocated when that is noexcept, otherwise
+   *  moved if noexcept or copied.  Going back to inline storage only
+   *  happens on shrink_to_fit().
+   *
+   *  Unlike std::vector, moving or swapping a %small_vector whose
+   *  elements are inline moves the elements themselves, so it is linear
+   *  in size() and invalidates iterators into the inline buffer.
+  */
+  template <typename _Tp, std::size_t _Nm, typename _Alloc = std::allocator<_Tp>>
+  class small_vector : protected _Small_vector_base<_Tp, _Nm, _Alloc> {
+    static_assert(std::is_same<typename std::remove_cv<_Tp>::type, _Tp>::value,
+                  "__gnu_cxx::small_vector must have a non-const, non-volatile value_type");
+
+    typedef _Small_vector_base<_Tp, _Nm, _Alloc> _Base;
+    typedef typename _Base::_Tp_alloc_type _Tp_alloc_type;
+    typedef __alloc_traits<_Tp_alloc_type> _Alloc_traits;
+
+  public:
+    typedef _Tp value_type;
+    typedef typename _Base::pointer pointer;
+    typedef typename _Alloc_traits::const_pointer const_pointer;
+    typedef typename _Alloc_traits::reference reference;
+    typedef typename _Alloc_traits::const_reference const_reference;
+    typedef __normal_iterator<pointer, small_vector> iterator;
+    typedef __normal_iterator<const_pointer, small_vector>
+        const_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef _Alloc allocator_type;
+
+  private:
+    static constexpr bool
+    _S_nothrow_relocate(std::true_type) {
+      return noexcept(std::__relocate_a(std::declval<pointer>(),
+                                        std::declval<pointer>(),
+                                        std::declval<pointer>(),
+                                        std::declval<_Tp_alloc_type&>()));
+    }
+
+    static constexpr bool
+    _S_nothrow_relocate(std::false_type) { return false; }
+
+    static constexpr bool
+    _S_use_relocate() {
+      // See std::vector::_S_use_relocate.
+      return _S_nothrow_relocate(std::__is_move_insertable<_Tp_alloc_type>{});
+    }
+
+    static pointer
+    _S_relocate(pointer __first, pointer __last, pointer __result, _Tp_alloc_type& __alloc) noexcept {
+      return std::__relocate_a(__first, __last, __result, __alloc);
+    }
+
+  protected:
+    using _Base::_M_allocate;
+    using _Base::_M_deallocate;
+    using _Base::_M_get_Tp_allocator;
+    using _Base::_M_impl;
+
+  public:
+    small_vector() = default;
+
+    explicit small_vector(const allocator_type& __a) noexcept
+        : _Base(__a) {}
+
+    explicit small_vector(size_type __n, const allocator_type& __a = allocator_type())
+        : _Base(_S_check_init_len(__n, __a), __a) { _M_default_initialize(__n); }
+
+    small_vector(size_type __n, const value_type& __value,
+                 const allocator_type& __a = allocator_type())
+        : _Base(_S_check_init_len(__n, __a), __a) { _M_fill_initialize(__n, __value); }
+
+    small_vector(const small_vector& __x)
+        : _Base(__x.size(),
+                _Alloc_traits::_S_select_on_copy(__x._M_get_Tp_allocator())) {
+      this->_M_impl._M_finish =
+          std::__uninitialized_copy_a(__x.begin(), __x.end(),
+                                      this->_M_impl._M_start,
+                                      _M_get_Tp_allocator());
+    }
+
+    small_vector(const small_vector& __x, const allocator_type& __a)
+        : _Base(__x.size(), __a) {
+      this->_M_impl._M_finish =
+          std::__uninitialized_copy_a(__x.begin(), __x.end(),
+                                      this->_M_impl._M_start,
+                                      _M_get_Tp_allocator());
+    }
+
+    /**
+       *  @brief  %small_vector move constructor.
+       *
+       *  Heap storage is taken over in constant time, inline elements are
+       *  relocated one by one.  The moved-from object is left empty.
+       */
+    small_vector(small_vector&& __x) noexcept(std::is_nothrow_move_constructible<_Tp>::value)
+        : _Base(_Tp_alloc_type(std::move(__x._M_get_Tp_allocator()))) { _M_take_from(__x); }
+
+    small_vector(small_vector&& __x, const allocator_type& __a)
+        : _Base(__a) {
+      if (_Alloc_traits::_S_always_equal() || __x._M_get_Tp_allocator() == this->_M_get_Tp_allocator())
+        _M_take_from(__x);
+      else if (!__x.empty()) {
+        this->_M_create_storage(__x.size());
+        this->_M_impl._M_finish =
+            std::__uninitialized_move_a(__x.begin(), __x.end(),
+                                        this->_M_impl._M_start,
+                                        _M_get_Tp_allocator());
+        __x.clear();
+      }
+    }
+
+    small_vector(std::initializer_list<value_type> __l,
+                 const allocator_type& __a = allocator_type())
+        : _Base(__a) {
+      _M_range_initialize(__l.begin(), __l.end(),
+                          std::random_access_iterator_tag());
+    }
+
+    template <typename _InputIterator,
+              typename = std::_RequireInputIter<_InputIterator>>
+    small_vector(_InputIterator __first, _InputIterator __last,
+                 const allocator_type& __a = allocator_type())
+        : _Base(__a) {
+      _M_range_initialize(__first, __last,
+                          std::__iterator_category(__first));
+    }
+
+    ~small_vector() noexcept {
+      std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                    _M_get_Tp_allocator());
+    }
+
+    small_vector&
+    operator=(const small_vector& __x);
+
+    small_vector&
+    operator=(small_vector&& __x) noexcept(_Alloc_traits::_S_nothrow_move() && std::is_nothrow_move_constructible<_Tp>::value) {
+      constexpr bool __move_storage =
+          _Alloc_traits::_S_propagate_on_move_assign() || _Alloc_traits::_S_always_equal();
+      _M_move_assign(std::move(__x), std::__bool_constant<__move_storage>());
+      return *this;
+    }
+
+    small_vector&
+    operator=(std::initializer_list<value_type> __l) {
+      this->_M_assign_aux(__l.begin(), __l.end(),
+                          std::random_access_iterator_tag());
+      return *this;
+    }
+
+    void
+    assign(size_type __n, const value_type& __val) { _M_fill_assign(__n, __val); }
+
+    template <typename _InputIterator,
+              typename = std::_RequireInputIter<_InputIterator>>
+    void
+    assign(_InputIterator __first, _InputIterator __last) { _M_assign_aux(__first, __last, std::__iterator_category(__first)); }
+
+    void
+    assign(std::initializer_list<value_type> __l) {
+      this->_M_assign_aux(__l.begin(), __l.end(),
+                          std::random_access_iterator_tag());
+    }
+
+    /// Get a copy of the memory allocation object.
+    using _Base::get_allocator;
+
+    // iterators
+    iterator
+    begin() noexcept { return iterator(this->_M_impl._M_start); }
+
+    const_iterator
+    begin() const noexcept { return const_iterator(this->_M_impl._M_start); }
+
+    iterator
+    end() noexcept { return iterator(this->_M_impl._M_finish); }
+
+    const_iterator
+    end() const noexcept { return const_iterator(this->_M_impl._M_finish); }
+
+    reverse_iterator
+    rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator
+    rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator
+    rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator
+    rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator
+    cbegin() const noexcept { return const_iterator(this->_M_impl._M_start); }
+
+    const_iterator
+    cend() const noexcept { return const_iterator(this->_M_impl._M_finish); }
+
+    const_reverse_iterator
+    crbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    const_reverse_iterator
+    crend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // capacity
+    size_type
+    size() const noexcept { return size_type(this->_M_impl._M_finish - this->_M_impl._M_start); }
+
+    size_type
+    max_size() const noexcept { return _S_max_size(_M_get_Tp_allocator()); }
+
+    void
+    resize(size_type __new_size) {
+      if (__new_size > size())
+        _M_default_append(__new_size - size());
+      else if (__new_size < size())
+        _M_erase_at_end(this->_M_impl._M_start + __new_size);
+    }
+
+    void
+    resize(size_type __new_size, const value_type& __x) {
+      if (__new_size > size())
+        _M_fill_insert(end(), __new_size - size(), __x);
+      else if (__new_size < size())
+        _M_erase_at_end(this->_M_impl._M_start + __new_size);
+    }
+
+    /**
+       *  Releases unused heap capacity.  If the elements fit in the
+       *  inline buffer they are moved back into it.
+       */
+    void
+    shrink_to_fit() { _M_shrink_to_fit(); }
+
+    size_type
+    capacity() const noexcept { return size_type(this->_M_impl._M_end_of_storage - this->_M_impl._M_start); }
+
+    /// Number of elements that fit without allocating.
+    static constexpr size_type
+    inline_capacity() noexcept { return _Nm; }
+
+    /// True while the elements live in the inline buffer.
+    bool
+    is_inline() const noexcept { return this->_M_impl._M_is_inline(); }
+
+    _GLIBCXX_NODISCARD bool
+    empty() const noexcept { return begin() == end(); }
+
+    void
+    reserve(size_type __n);
+
+    // element access
+    reference
+    operator[](size_type __n) noexcept {
+      __glibcxx_requires_subscript(__n);
+      return *(this->_M_impl._M_start + __n);
+    }
+
+    const_reference
+    operator[](size_type __n) const noexcept {
+      __glibcxx_requires_subscript(__n);
+      return *(this->_M_impl._M_start + __n);
+    }
+
+  protected:
+    /// Safety check used only from at().
+    void
+    _M_range_check(size_type __n) const {
+      if (__n >= this->size())
+        std::__throw_out_of_range_fmt(__N("small_vector::_M_range_check: __n "
+                                          "(which is %zu) >= this->size() "
+                                          "(which is %zu)"),
+                                      __n, this->size());
+    }
+
+  public:
+    reference
+    at(size_type __n) {
+      _M_range_check(__n);
+      return (*this)[__n];
+    }
+
+    const_reference
+    at(size_type __n) const {
+      _M_range_check(__n);
+      return (*this)[__n];
+    }
+
+    reference
+    front() noexcept {
+      __glibcxx_requires_nonempty();
+      return *begin();
+    }
+
+    const_reference
+    front() const noexcept {
+      __glibcxx_requires_nonempty();
+      return *begin();
+    }
+
+    reference
+    back() noexcept {
+      __glibcxx_requires_nonempty();
+      return *(end() - 1);
+    }
+
+    const_reference
+    back() const noexcept {
+      __glibcxx_requires_nonempty();
+      return *(end() - 1);
+    }
+
+    _Tp*
+    data() noexcept { return this->_M_impl._M_start; }
+
+    const _Tp*
+    data() const noexcept { return this->_M_impl._M_start; }
+
+    // modifiers
+    void
+    push_back(const value_type& __x) {
+      if (this->_M_impl._M_finish != this->_M_impl._M_end_of_storage) {
+        _Alloc_traits::construct(this->_M_impl, this->_M_impl._M_finish,
+                                 __x);
+        ++this->_M_impl._M_finish;
+      } else
+        _M_realloc_insert(end(), __x);
+    }
+
+    void
+    push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+    template <typename... _Args>
+    reference
+    emplace_back(_Args&&... __args);
+
+    void
+    pop_back() noexcept {
+      __glibcxx_requires_nonempty();
+      --this->_M_impl._M_finish;
+      _Alloc_traits::destroy(this->_M_impl, this->_M_impl._M_finish);
+    }
+
+    template <typename... _Args>
+    iterator
+    emplace(const_iterator __position, _Args&&... __args) { return _M_emplace_aux(__position, std::forward<_Args>(__args)...); }
+
+    iterator
+    insert(const_iterator __position, const value_type& __x);
+
+    iterator
+    insert(const_iterator __position, value_type&& __x) { return _M_insert_rval(__position, std::move(__x)); }
+
+    iterator
+    insert(const_iterator __position, std::initializer_list<value_type> __l) {
+      auto __offset = __position - cbegin();
+      _M_range_insert(begin() + __offset, __l.begin(), __l.end(),
+                      std::random_access_iterator_tag());
+      return begin() + __offset;
+    }
+
+    iterator
+    insert(const_iterator __position, size_type __n, const value_type& __x) {
+      difference_type __offset = __position - cbegin();
+      _M_fill_insert(begin() + __offset, __n, __x);
+      return begin() + __offset;
+    }
+
+    template <typename _InputIterator,
+              typename = std::_RequireInputIter<_InputIterator>>
+    iterator
+    insert(const_iterator __position, _InputIterator __first,
+           _InputIterator __last) {
+      difference_type __offset = __position - cbegin();
+      _M_range_insert(begin() + __offset, __first, __last,
+                      std::__iterator_category(__first));
+      return begin() + __offset;
+    }
+
+    iterator
+    erase(const_iterator __position) { return _M_erase(begin() + (__position - cbegin())); }
+
+    iterator
+    erase(const_iterator __first, const_iterator __last) {
+      const auto __beg = begin();
+      const auto __cbeg = cbegin();
+      return _M_erase(__beg + (__first - __cbeg), __beg + (__last - __cbeg));
+    }
+
+    /**
+       *  Constant time when both objects are on the heap.  Otherwise the
+       *  inline elements are exchanged one by one.
+       */
+    void
+    swap(small_vector& __x) noexcept(std::__is_nothrow_swappable<_Tp>::value && std::is_nothrow_move_constructible<_Tp>::value);
+
+    void
+    clear() noexcept { _M_erase_at_end(this->_M_impl._M_start); }
+
+  protected:
+    template <typename _ForwardIterator>
+    pointer
+    _M_allocate_and_copy(size_type __n,
+                         _ForwardIterator __first, _ForwardIterator __last) {
+      pointer __result = this->_M_allocate(__n);
+      try {
+        std::__uninitialized_copy_a(__first, __last, __result,
+                                    _M_get_Tp_allocator());
+        return __result;
+      }
+      catch(...) {
+        _M_deallocate(__result, __n);
+        throw;
+      }
+    }
+
+    // Take over the contents of __x, whose allocator compares equal.
+    void
+    _M_take_from(small_vector& __x) noexcept(std::is_nothrow_move_constructible<_Tp>::value);
+
+    // Move the elements into a new buffer of capacity __len (which may be
+    // the inline one) and release the old buffer.
+    void
+    _M_reallocate(size_type __len);
+
+    template <typename _InputIterator>
+    void
+    _M_range_initialize(_InputIterator __first, _InputIterator __last,
+                        std::input_iterator_tag) {
+      try {
+        for (; __first != __last; ++__first)
+          emplace_back(*__first);
+      }
+      catch(...) {
+        clear();
+        throw;
+      }
+    }
+
+    template <typename _ForwardIterator>
+    void
+    _M_range_initialize(_ForwardIterator __first, _ForwardIterator __last,
+                        std::forward_iterator_tag) {
+      const size_type __n = std::distance(__first, __last);
+      this->_M_create_storage(_S_check_init_len(__n, _M_get_Tp_allocator()));
+      this->_M_impl._M_finish =
+          std::__uninitialized_copy_a(__first, __last,
+                                      this->_M_impl._M_start,
+                                      _M_get_Tp_allocator());
+    }
+
+    void
+    _M_fill_initialize(size_type __n, const value_type& __value) {
+      this->_M_impl._M_finish =
+          std::__uninitialized_fill_n_a(this->_M_impl._M_start, __n, __value,
+                                        _M_get_Tp_allocator());
+    }
+
+    void
+    _M_default_initialize(size_type __n) {
+      this->_M_impl._M_finish =
+          std::__uninitialized_default_n_a(this->_M_impl._M_start, __n,
+                                           _M_get_Tp_allocator());
+    }
+
+    template <typename _InputIterator>
+    void
+    _M_assign_aux(_InputIterator __first, _InputIterator __last,
+                  std::input_iterator_tag);
+
+    template <typename _ForwardIterator>
+    void
+    _M_assign_aux(_ForwardIterator __first, _ForwardIterator __last,
+                  std::forward_iterator_tag);
+
+    void
+    _M_fill_assign(size_type __n, const value_type& __val);
+
+    template <typename _InputIterator>
+    void
+    _M_range_insert(iterator __pos, _InputIterator __first,
+                    _InputIterator __last, std::input_iterator_tag);
+
+    template <typename _ForwardIterator>
+    void
+    _M_range_insert(iterator __pos, _ForwardIterator __first,
+                    _ForwardIterator __last, std::forward_iterator_tag);
+
+    void
+    _M_fill_insert(iterator __pos, size_type __n, const value_type& __x);
+
+    void
+    _M_default_append(size_type __n);
+
+    bool
+    _M_shrink_to_fit();
+
+    // See std::vector::_Temporary_value.
+    struct _Temporary_value {
+      template <typename... _Args>
+      explicit _Temporary_value(small_vector* __vec, _Args&&... __args) : _M_this(__vec) {
+        _Alloc_traits::construct(_M_this->_M_impl, _M_ptr(),
+                                 std::forward<_Args>(__args)...);
+      }
+
+      ~_Temporary_value() { _Alloc_traits::destroy(_M_this->_M_impl, _M_ptr()); }
+
+      value_type&
+      _M_val() { return *_M_ptr(); }
+
+    private:
+      _Tp*
+      _M_ptr() { return reinterpret_cast<_Tp*>(&__buf); }
+
+      small_vector* _M_this;
+      typename std::aligned_storage<sizeof(_Tp), alignof(_Tp)>::type __buf;
+    };
+
+    template <typename _Arg>
+    void
+    _M_insert_aux(iterator __position, _Arg&& __arg);
+
+    template <typename... _Args>
+    void
+    _M_realloc_insert(iterator __position, _Args&&... __args);
+
+    iterator
+    _M_insert_rval(const_iterator __position, value_type&& __v);
+
+    template <typename... _Args>
+    iterator
+    _M_emplace_aux(const_iterator __position, _Args&&... __args);
+
+    iterator
+    _M_emplace_aux(const_iterator __position, value_type&& __v) { return _M_insert_rval(__position, std::move(__v)); }
+
+    // Same growth policy as std::vector.
+    size_type
+    _M_check_len(size_type __n, const char* __s) const {
+      if (max_size() - size() < __n)
+        std::__throw_length_error(__N(__s));
+
+      const size_type __len = size() + (std::max)(size(), __n);
+      return (__len < size() || __len > max_size()) ? max_size() : __len;
+    }
+
+    static size_type
+    _S_check_init_len(size_type __n, const allocator_type& __a) {
+      if (__n > _S_max_size(_Tp_alloc_type(__a)))
+        std::__throw_length_error(
+            __N("cannot create __gnu_cxx::small_vector larger than max_size()"));
+      return __n;
+    }
+
+    static size_type
+    _S_max_size(const _Tp_alloc_type& __a) noexcept {
+      const size_t __diffmax = __numeric_traits<ptrdiff_t>::__max / sizeof(_Tp);
+      const size_t __allocmax = _Alloc_traits::max_size(__a);
+      return (std::min)(__diffmax, __allocmax);
+    }
+
+    void
+    _M_erase_at_end(pointer __pos) noexcept {
+      if (this->_M_impl._M_finish != __pos) {
+        std::_Destroy(__pos, this->_M_impl._M_finish,
+                      _M_get_Tp_allocator());
+        this->_M_impl._M_finish = __pos;
+      }
+    }
+
+    iterator
+    _M_erase(iterator __position);
+
+    iterator
+    _M_erase(iterator __first, iterator __last);
+
+  private:
+    // The source's heap buffer (if any) can be taken over.
+    void
+    _M_move_assign(small_vector&& __x, std::true_type) noexcept(std::is_nothrow_move_constructible<_Tp>::value) {
+      clear();
+      _M_deallocate(this->_M_impl._M_start,
+                    this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+      this->_M_impl._M_reset();
+      std::__alloc_on_move(_M_get_Tp_allocator(), __x._M_get_Tp_allocator());
+      _M_take_from(__x);
+    }
+
+    void
+    _M_move_assign(small_vector&& __x, std::false_type) {
+      if (__x._M_get_Tp_allocator() == this->_M_get_Tp_allocator())
+        _M_move_assign(std::move(__x), std::true_type());
+      else {
+        // The rvalue's allocator cannot be moved and is not equal,
+        // so we need to individually move each element.
+        this->assign(std::__make_move_if_noexcept_iterator(__x.begin()),
+                     std::__make_move_if_noexcept_iterator(__x.end()));
+        __x.clear();
+      }
+    }
+  };
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  inline bool
+  operator==(const small_vector<_Tp, _Nm, _Alloc>& __x, const small_vector<_Tp, _Nm, _Alloc>& __y) { return (__x.size() == __y.size() && std::equal(__x.begin(), __x.end(), __y.begin())); }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  inline bool
+  operator<(const small_vector<_Tp, _Nm, _Alloc>& __x, const small_vector<_Tp, _Nm, _Alloc>& __y) { return std::lexicographical_compare(__x.begin(), __x.end(),
+                                                                                                                                      __y.begin(), __y.end()); }
+
+  /// Based on operator==
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  inline bool
+  operator!=(const small_vector<_Tp, _Nm, _Alloc>& __x, const small_vector<_Tp, _Nm, _Alloc>& __y) { return !(__x == __y); }
+
+  /// Based on operator<
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  inline bool
+  operator>(const small_vector<_Tp, _Nm, _Alloc>& __x, const small_vector<_Tp, _Nm, _Alloc>& __y) { return __y < __x; }
+
+  /// Based on operator<
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  inline bool
+  operator<=(const small_vector<_Tp, _Nm, _Alloc>& __x, const small_vector<_Tp, _Nm, _Alloc>& __y) { return !(__y < __x); }
+
+  /// Based on operator<
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  inline bool
+  operator>=(const small_vector<_Tp, _Nm, _Alloc>& __x, const small_vector<_Tp, _Nm, _Alloc>& __y) { return !(__x < __y); }
+
+  /// See __gnu_cxx::small_vector::swap().
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  inline void
+  swap(small_vector<_Tp, _Nm, _Alloc> & __x, small_vector<_Tp, _Nm, _Alloc> & __y)
+      noexcept(noexcept(__x.swap(__y))) { __x.swap(__y); }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#include <ext/small_vector.tcc>
+
+#endif // C++11
+
+#endif /* _SMALL_VECTOR_H */
@@ -0,0 +1,673 @@
+// Vector with inline storage -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/small_vector.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/small_vector.h}
+ */
+
+#ifndef _SMALL_VECTOR_TCC
+#define _SMALL_VECTOR_TCC 1
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_take_from(small_vector& __x) noexcept(std::is_nothrow_move_constructible<_Tp>::value) {
+    if (!__x._M_impl._M_is_inline()) {
+      this->_M_impl._M_start = __x._M_impl._M_start;
+      this->_M_impl._M_finish = __x._M_impl._M_finish;
+      this->_M_impl._M_end_of_storage = __x._M_impl._M_end_of_storage;
+      __x._M_impl._M_reset();
+    } else if constexpr (_S_use_relocate()) {
+      this->_M_impl._M_finish = _S_relocate(__x._M_impl._M_start, __x._M_impl._M_finish,
+                                            this->_M_impl._M_start, _M_get_Tp_allocator());
+      __x._M_impl._M_finish = __x._M_impl._M_start;
+    } else {
+      this->_M_impl._M_finish =
+          std::__uninitialized_move_a(__x.begin(), __x.end(),
+                                      this->_M_impl._M_start,
+                                      _M_get_Tp_allocator());
+      __x.clear();
+    }
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_reallocate(size_type __len) {
+    const size_type __old_size = size();
+    const bool __to_inline = __len <= _Nm;
+    pointer __tmp;
+    if (__to_inline) {
+      __tmp = this->_M_impl._M_inline();
+      __len = _Nm;
+    } else
+      __tmp = this->_M_allocate(__len);
+    if constexpr (_S_use_relocate()) {
+      _S_relocate(this->_M_impl._M_start, this->_M_impl._M_finish,
+                  __tmp, _M_get_Tp_allocator());
+    } else {
+      try {
+        std::__uninitialized_move_if_noexcept_a(this->_M_impl._M_start, this->_M_impl._M_finish,
+                                                __tmp, _M_get_Tp_allocator());
+      }
+      catch(...) {
+        _M_deallocate(__tmp, __len);
+        throw;
+      }
+      std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                    _M_get_Tp_allocator());
+    }
+    _M_deallocate(this->_M_impl._M_start,
+                  this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+    this->_M_impl._M_start = __tmp;
+    this->_M_impl._M_finish = __tmp + __old_size;
+    this->_M_impl._M_end_of_storage = __tmp + __len;
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::reserve(size_type __n) {
+    if (__n > this->max_size())
+      std::__throw_length_error(__N("small_vector::reserve"));
+    // capacity() is never below _Nm, so this always goes to the heap.
+    if (this->capacity() < __n)
+      _M_reallocate(__n);
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  typename small_vector<_Tp, _Nm, _Alloc>::reference
+  small_vector<_Tp, _Nm, _Alloc>::emplace_back(_Args && ... __args) {
+    if (this->_M_impl._M_finish != this->_M_impl._M_end_of_storage) {
+      _Alloc_traits::construct(this->_M_impl, this->_M_impl._M_finish,
+                               std::forward<_Args>(__args)...);
+      ++this->_M_impl._M_finish;
+    } else {
+      _M_realloc_insert(end(), std::forward<_Args>(__args)...);
+    }
+    return back();
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  typename small_vector<_Tp, _Nm, _Alloc>::iterator
+  small_vector<_Tp, _Nm, _Alloc>::insert(const_iterator __position, const value_type& __x) {
+    const size_type __n = __position - begin();
+
+    if (this->_M_impl._M_finish != this->_M_impl._M_end_of_storage) {
+      if (__position == end()) {
+        _Alloc_traits::construct(this->_M_impl, this->_M_impl._M_finish, __x);
+        ++this->_M_impl._M_finish;
+      } else {
+        const auto __pos = begin() + (__position - cbegin());
+        // __x could be an existing element of this container, so make a
+        // copy of it before _M_insert_aux moves elements around.
+        _Temporary_value __x_copy(this, __x);
+        _M_insert_aux(__pos, std::move(__x_copy._M_val()));
+      }
+    } else {
+      _M_realloc_insert(begin() + (__position - cbegin()), __x);
+    }
+
+    return iterator(this->_M_impl._M_start + __n);
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  typename small_vector<_Tp, _Nm, _Alloc>::iterator
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_erase(iterator __position) {
+    if (__position + 1 != end())
+      _GLIBCXX_MOVE3(__position + 1, end(), __position);
+    --this->_M_impl._M_finish;
+    _Alloc_traits::destroy(this->_M_impl, this->_M_impl._M_finish);
+    return __position;
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  typename small_vector<_Tp, _Nm, _Alloc>::iterator
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_erase(iterator __first, iterator __last) {
+    if (__first != __last) {
+      if (__last != end())
+        _GLIBCXX_MOVE3(__last, end(), __first);
+      _M_erase_at_end(__first.base() + (end() - __last));
+    }
+    return __first;
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  small_vector<_Tp, _Nm, _Alloc>&
+  small_vector<_Tp, _Nm, _Alloc>::
+  operator=(const small_vector<_Tp, _Nm, _Alloc>& __x) {
+    if (&__x != this) {
+      if (_Alloc_traits::_S_propagate_on_copy_assign()) {
+        if (!_Alloc_traits::_S_always_equal() && _M_get_Tp_allocator() != __x._M_get_Tp_allocator()) {
+          // replacement allocator cannot free existing storage
+          this->clear();
+          _M_deallocate(this->_M_impl._M_start,
+                        this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+          this->_M_impl._M_reset();
+        }
+        std::__alloc_on_copy(_M_get_Tp_allocator(),
+                             __x._M_get_Tp_allocator());
+      }
+      const size_type __xlen = __x.size();
+      if (__xlen > capacity()) {
+        pointer __tmp = _M_allocate_and_copy(__xlen, __x.begin(),
+                                             __x.end());
+        std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                      _M_get_Tp_allocator());
+        _M_deallocate(this->_M_impl._M_start,
+                      this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+        this->_M_impl._M_start = __tmp;
+        this->_M_impl._M_end_of_storage = this->_M_impl._M_start + __xlen;
+      } else if (size() >= __xlen) {
+        std::_Destroy(std::copy(__x.begin(), __x.end(), begin()),
+                      end(), _M_get_Tp_allocator());
+      } else {
+        std::copy(__x._M_impl._M_start, __x._M_impl._M_start + size(),
+                  this->_M_impl._M_start);
+        std::__uninitialized_copy_a(__x._M_impl._M_start + size(),
+                                    __x._M_impl._M_finish,
+                                    this->_M_impl._M_finish,
+                                    _M_get_Tp_allocator());
+      }
+      this->_M_impl._M_finish = this->_M_impl._M_start + __xlen;
+    }
+    return *this;
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_fill_assign(size_t __n, const value_type& __val) {
+    if (__n > capacity()) {
+      _S_check_init_len(__n, _M_get_Tp_allocator());
+      pointer __tmp = this->_M_allocate(__n);
+      try {
+        std::__uninitialized_fill_n_a(__tmp, __n, __val, _M_get_Tp_allocator());
+      }
+      catch(...) {
+        _M_deallocate(__tmp, __n);
+        throw;
+      }
+      std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                    _M_get_Tp_allocator());
+      _M_deallocate(this->_M_impl._M_start,
+                    this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+      this->_M_impl._M_start = __tmp;
+      this->_M_impl._M_finish = __tmp + __n;
+      this->_M_impl._M_end_of_storage = __tmp + __n;
+    } else if (__n > size()) {
+      std::fill(begin(), end(), __val);
+      const size_type __add = __n - size();
+      this->_M_impl._M_finish =
+          std::__uninitialized_fill_n_a(this->_M_impl._M_finish,
+                                        __add, __val, _M_get_Tp_allocator());
+    } else
+      _M_erase_at_end(std::fill_n(this->_M_impl._M_start, __n, __val));
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename _InputIterator>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_assign_aux(_InputIterator __first, _InputIterator __last,
+                    std::input_iterator_tag) {
+    pointer __cur(this->_M_impl._M_start);
+    for (; __first != __last && __cur != this->_M_impl._M_finish;
+         ++__cur, (void)++__first)
+      *__cur = *__first;
+    if (__first == __last)
+      _M_erase_at_end(__cur);
+    else
+      _M_range_insert(end(), __first, __last,
+                      std::__iterator_category(__first));
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename _ForwardIterator>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_assign_aux(_ForwardIterator __first, _ForwardIterator __last,
+                    std::forward_iterator_tag) {
+    const size_type __len = std::distance(__first, __last);
+
+    if (__len > capacity()) {
+      _S_check_init_len(__len, _M_get_Tp_allocator());
+      pointer __tmp(_M_allocate_and_copy(__len, __first, __last));
+      std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                    _M_get_Tp_allocator());
+      _M_deallocate(this->_M_impl._M_start,
+                    this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+      this->_M_impl._M_start = __tmp;
+      this->_M_impl._M_finish = this->_M_impl._M_start + __len;
+      this->_M_impl._M_end_of_storage = this->_M_impl._M_finish;
+    } else if (size() >= __len)
+      _M_erase_at_end(std::copy(__first, __last, this->_M_impl._M_start));
+    else {
+      _ForwardIterator __mid = __first;
+      std::advance(__mid, size());
+      std::copy(__first, __mid, this->_M_impl._M_start);
+      this->_M_impl._M_finish =
+          std::__uninitialized_copy_a(__mid, __last,
+                                      this->_M_impl._M_finish,
+                                      _M_get_Tp_allocator());
+    }
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  auto
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_insert_rval(const_iterator __position, value_type && __v)
+          ->iterator {
+    const auto __n = __position - cbegin();
+    if (this->_M_impl._M_finish != this->_M_impl._M_end_of_storage)
+      if (__position == cend()) {
+        _Alloc_traits::construct(this->_M_impl, this->_M_impl._M_finish,
+                                 std::move(__v));
+        ++this->_M_impl._M_finish;
+      } else
+        _M_insert_aux(begin() + __n, std::move(__v));
+    else
+      _M_realloc_insert(begin() + __n, std::move(__v));
+
+    return iterator(this->_M_impl._M_start + __n);
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  auto
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_emplace_aux(const_iterator __position, _Args && ... __args)
+          ->iterator {
+    const auto __n = __position - cbegin();
+    if (this->_M_impl._M_finish != this->_M_impl._M_end_of_storage)
+      if (__position == cend()) {
+        _Alloc_traits::construct(this->_M_impl, this->_M_impl._M_finish,
+                                 std::forward<_Args>(__args)...);
+        ++this->_M_impl._M_finish;
+      } else {
+        // We need to construct a temporary because something in __args...
+        // could alias one of the elements of the container.
+        _Temporary_value __tmp(this, std::forward<_Args>(__args)...);
+        _M_insert_aux(begin() + __n, std::move(__tmp._M_val()));
+      }
+    else
+      _M_realloc_insert(begin() + __n, std::forward<_Args>(__args)...);
+
+    return iterator(this->_M_impl._M_start + __n);
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename _Arg>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_insert_aux(iterator __position, _Arg && __arg) {
+    _Alloc_traits::construct(this->_M_impl, this->_M_impl._M_finish,
+                             _GLIBCXX_MOVE(*(this->_M_impl._M_finish - 1)));
+    ++this->_M_impl._M_finish;
+    _GLIBCXX_MOVE_BACKWARD3(__position.base(),
+                            this->_M_impl._M_finish - 2,
+                            this->_M_impl._M_finish - 1);
+    *__position = std::forward<_Arg>(__arg);
+  }
+
+  // Same as vector::_M_realloc_insert, except that the old buffer may be
+  // the inline one, which _M_deallocate leaves alone.
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::_M_realloc_insert(iterator __position, _Args && ... __args) {
+    const size_type __len = _M_check_len(size_type(1), "small_vector::_M_realloc_insert");
+    pointer __old_start = this->_M_impl._M_start;
+    pointer __old_finish = this->_M_impl._M_finish;
+    const size_type __elems_before = __position - begin();
+    pointer __new_start(this->_M_allocate(__len));
+    pointer __new_finish(__new_start);
+    try {
+      // The new element is constructed first because __args may refer to
+      // an element that is about to be moved.
+      _Alloc_traits::construct(this->_M_impl,
+                               __new_start + __elems_before,
+                               std::forward<_Args>(__args)...);
+      __new_finish = pointer();
+
+      if constexpr (_S_use_relocate()) {
+        __new_finish = _S_relocate(__old_start, __position.base(), __new_start, _M_get_Tp_allocator());
+        ++__new_finish;
+        __new_finish = _S_relocate(__position.base(), __old_finish, __new_finish, _M_get_Tp_allocator());
+      } else {
+        __new_finish = std::__uninitialized_move_if_noexcept_a(__old_start, __position.base(), __new_start, _M_get_Tp_allocator());
+        ++__new_finish;
+        __new_finish = std::__uninitialized_move_if_noexcept_a(__position.base(), __old_finish, __new_finish, _M_get_Tp_allocator());
+      }
+    }
+    catch(...) {
+      if (!__new_finish)
+        _Alloc_traits::destroy(this->_M_impl, __new_start + __elems_before);
+      else
+        std::_Destroy(__new_start, __new_finish, _M_get_Tp_allocator());
+      _M_deallocate(__new_start, __len);
+      throw;
+    }
+    if constexpr (!_S_use_relocate()) {
+      std::_Destroy(__old_start, __old_finish, _M_get_Tp_allocator());
+    }
+    _M_deallocate(__old_start, this->_M_impl._M_end_of_storage - __old_start);
+    this->_M_impl._M_start = __new_start;
+    this->_M_impl._M_finish = __new_finish;
+    this->_M_impl._M_end_of_storage = __new_start + __len;
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::_M_fill_insert(iterator __position, size_type __n, const value_type& __x) {
+    if (__n != 0) {
+      if (size_type(this->_M_impl._M_end_of_storage - this->_M_impl._M_finish) >= __n) {
+        _Temporary_value __tmp(this, __x);
+        value_type& __x_copy = __tmp._M_val();
+        const size_type __elems_after = end() - __position;
+        pointer __old_finish(this->_M_impl._M_finish);
+        if (__elems_after > __n) {
+          std::__uninitialized_move_a(this->_M_impl._M_finish - __n,
+                                      this->_M_impl._M_finish,
+                                      this->_M_impl._M_finish,
+                                      _M_get_Tp_allocator());
+          this->_M_impl._M_finish += __n;
+          _GLIBCXX_MOVE_BACKWARD3(__position.base(),
+                                  __old_finish - __n, __old_finish);
+          std::fill(__position.base(), __position.base() + __n,
+                    __x_copy);
+        } else {
+          this->_M_impl._M_finish =
+              std::__uninitialized_fill_n_a(this->_M_impl._M_finish,
+                                            __n - __elems_after,
+                                            __x_copy,
+                                            _M_get_Tp_allocator());
+          std::__uninitialized_move_a(__position.base(), __old_finish,
+                                      this->_M_impl._M_finish,
+                                      _M_get_Tp_allocator());
+          this->_M_impl._M_finish += __elems_after;
+          std::fill(__position.base(), __old_finish, __x_copy);
+        }
+      } else {
+        const size_type __len =
+            _M_check_len(__n, "small_vector::_M_fill_insert");
+        const size_type __elems_before = __position - begin();
+        pointer __new_start(this->_M_allocate(__len));
+        pointer __new_finish(__new_start);
+        try {
+          // See _M_realloc_insert above.
+          std::__uninitialized_fill_n_a(__new_start + __elems_before,
+                                        __n, __x,
+                                        _M_get_Tp_allocator());
+          __new_finish = pointer();
+
+          __new_finish = std::__uninitialized_move_if_noexcept_a(this->_M_impl._M_start, __position.base(),
+                                                                 __new_start, _M_get_Tp_allocator());
+
+          __new_finish += __n;
+
+          __new_finish = std::__uninitialized_move_if_noexcept_a(__position.base(), this->_M_impl._M_finish,
+                                                                 __new_finish, _M_get_Tp_allocator());
+        }
+        catch(...) {
+          if (!__new_finish)
+            std::_Destroy(__new_start + __elems_before,
+                          __new_start + __elems_before + __n,
+                          _M_get_Tp_allocator());
+          else
+            std::_Destroy(__new_start, __new_finish,
+                          _M_get_Tp_allocator());
+          _M_deallocate(__new_start, __len);
+          throw;
+        }
+        std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                      _M_get_Tp_allocator());
+        _M_deallocate(this->_M_impl._M_start,
+                      this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+        this->_M_impl._M_start = __new_start;
+        this->_M_impl._M_finish = __new_finish;
+        this->_M_impl._M_end_of_storage = __new_start + __len;
+      }
+    }
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_default_append(size_type __n) {
+    if (__n != 0) {
+      const size_type __size = size();
+      size_type __navail = size_type(this->_M_impl._M_end_of_storage - this->_M_impl._M_finish);
+
+      if (__navail >= __n) {
+        this->_M_impl._M_finish =
+            std::__uninitialized_default_n_a(this->_M_impl._M_finish,
+                                             __n, _M_get_Tp_allocator());
+      } else {
+        const size_type __len =
+            _M_check_len(__n, "small_vector::_M_default_append");
+        pointer __new_start(this->_M_allocate(__len));
+        if constexpr (_S_use_relocate()) {
+          try {
+            std::__uninitialized_default_n_a(__new_start + __size,
+                                             __n, _M_get_Tp_allocator());
+          }
+          catch(...) {
+            _M_deallocate(__new_start, __len);
+            throw;
+          }
+          _S_relocate(this->_M_impl._M_start, this->_M_impl._M_finish,
+                      __new_start, _M_get_Tp_allocator());
+        } else {
+          pointer __destroy_from = pointer();
+          try {
+            std::__uninitialized_default_n_a(__new_start + __size,
+                                             __n, _M_get_Tp_allocator());
+            __destroy_from = __new_start + __size;
+            std::__uninitialized_move_if_noexcept_a(
+                this->_M_impl._M_start, this->_M_impl._M_finish,
+                __new_start, _M_get_Tp_allocator());
+          }
+          catch(...) {
+            if (__destroy_from)
+              std::_Destroy(__destroy_from, __destroy_from + __n,
+                            _M_get_Tp_allocator());
+            _M_deallocate(__new_start, __len);
+            throw;
+          }
+          std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                        _M_get_Tp_allocator());
+        }
+        _M_deallocate(this->_M_impl._M_start,
+                      this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+        this->_M_impl._M_start = __new_start;
+        this->_M_impl._M_finish = __new_start + __size + __n;
+        this->_M_impl._M_end_of_storage = __new_start + __len;
+      }
+    }
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  bool
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_shrink_to_fit() {
+    if (this->_M_impl._M_is_inline() || capacity() == size())
+      return false;
+    try {
+      // Falls back to the inline buffer when size() <= _Nm.
+      _M_reallocate(size());
+      return true;
+    }
+    catch(...) {
+      return false;
+    }
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename _InputIterator>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_range_insert(iterator __pos, _InputIterator __first,
+                      _InputIterator __last, std::input_iterator_tag) {
+    if (__pos == end()) {
+      for (; __first != __last; ++__first)
+        insert(end(), *__first);
+    } else if (__first != __last) {
+      small_vector __tmp(__first, __last, _M_get_Tp_allocator());
+      insert(__pos,
+             _GLIBCXX_MAKE_MOVE_ITERATOR(__tmp.begin()),
+             _GLIBCXX_MAKE_MOVE_ITERATOR(__tmp.end()));
+    }
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  template <typename _ForwardIterator>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      _M_range_insert(iterator __position, _ForwardIterator __first,
+                      _ForwardIterator __last, std::forward_iterator_tag) {
+    if (__first != __last) {
+      const size_type __n = std::distance(__first, __last);
+      if (size_type(this->_M_impl._M_end_of_storage - this->_M_impl._M_finish) >= __n) {
+        const size_type __elems_after = end() - __position;
+        pointer __old_finish(this->_M_impl._M_finish);
+        if (__elems_after > __n) {
+          std::__uninitialized_move_a(this->_M_impl._M_finish - __n,
+                                      this->_M_impl._M_finish,
+                                      this->_M_impl._M_finish,
+                                      _M_get_Tp_allocator());
+          this->_M_impl._M_finish += __n;
+          _GLIBCXX_MOVE_BACKWARD3(__position.base(),
+                                  __old_finish - __n, __old_finish);
+          std::copy(__first, __last, __position);
+        } else {
+          _ForwardIterator __mid = __first;
+          std::advance(__mid, __elems_after);
+          std::__uninitialized_copy_a(__mid, __last,
+                                      this->_M_impl._M_finish,
+                                      _M_get_Tp_allocator());
+          this->_M_impl._M_finish += __n - __elems_after;
+          std::__uninitialized_move_a(__position.base(),
+                                      __old_finish,
+                                      this->_M_impl._M_finish,
+                                      _M_get_Tp_allocator());
+          this->_M_impl._M_finish += __elems_after;
+          std::copy(__first, __mid, __position);
+        }
+      } else {
+        const size_type __len =
+            _M_check_len(__n, "small_vector::_M_range_insert");
+        pointer __new_start(this->_M_allocate(__len));
+        pointer __new_finish(__new_start);
+        try {
+          __new_finish = std::__uninitialized_move_if_noexcept_a(this->_M_impl._M_start, __position.base(),
+                                                                 __new_start, _M_get_Tp_allocator());
+          __new_finish = std::__uninitialized_copy_a(__first, __last,
+                                                     __new_finish,
+                                                     _M_get_Tp_allocator());
+          __new_finish = std::__uninitialized_move_if_noexcept_a(__position.base(), this->_M_impl._M_finish,
+                                                                 __new_finish, _M_get_Tp_allocator());
+        }
+        catch(...) {
+          std::_Destroy(__new_start, __new_finish,
+                        _M_get_Tp_allocator());
+          _M_deallocate(__new_start, __len);
+          throw;
+        }
+        std::_Destroy(this->_M_impl._M_start, this->_M_impl._M_finish,
+                      _M_get_Tp_allocator());
+        _M_deallocate(this->_M_impl._M_start,
+                      this->_M_impl._M_end_of_storage - this->_M_impl._M_start);
+        this->_M_impl._M_start = __new_start;
+        this->_M_impl._M_finish = __new_finish;
+        this->_M_impl._M_end_of_storage = __new_start + __len;
+      }
+    }
+  }
+
+  template <typename _Tp, std::size_t _Nm, typename _Alloc>
+  void
+  small_vector<_Tp, _Nm, _Alloc>::
+      swap(small_vector& __x) noexcept(std::__is_nothrow_swappable<_Tp>::value && std::is_nothrow_move_constructible<_Tp>::value) {
+    __glibcxx_assert(_Alloc_traits::propagate_on_container_swap::value || _M_get_Tp_allocator() == __x._M_get_Tp_allocator());
+    if (this == &__x)
+      return;
+    if (!this->_M_impl._M_is_inline() && !__x._M_impl._M_is_inline()) {
+      std::swap(this->_M_impl._M_start, __x._M_impl._M_start);
+      std::swap(this->_M_impl._M_finish, __x._M_impl._M_finish);
+      std::swap(this->_M_impl._M_end_of_storage, __x._M_impl._M_end_of_storage);
+    } else if (this->_M_impl._M_is_inline() && __x._M_impl._M_is_inline()) {
+      // Swap the common prefix, then move the excess of the longer one.
+      small_vector* __shorter = this;
+      small_vector* __longer = &__x;
+      if (size() > __x.size())
+        std::swap(__shorter, __longer);
+      pointer __mid = __longer->_M_impl._M_start + __shorter->size();
+      std::swap_ranges(__shorter->_M_impl._M_start, __shorter->_M_impl._M_finish,
+                       __longer->_M_impl._M_start);
+      __shorter->_M_impl._M_finish =
+          std::__uninitialized_move_a(__mid, __longer->_M_impl._M_finish,
+                                      __shorter->_M_impl._M_finish,
+                                      _M_get_Tp_allocator());
+      __longer->_M_erase_at_end(__mid);
+    } else {
+      // One side owns a heap buffer: hand it over and move the inline
+      // elements of the other side into the freed inline buffer.
+      small_vector& __heap = this->_M_impl._M_is_inline() ? __x : *this;
+      small_vector& __inl = this->_M_impl._M_is_inline() ? *this : __x;
+      pointer __start = __heap._M_impl._M_start;
+      pointer __finish = __heap._M_impl._M_finish;
+      pointer __end_of_storage = __heap._M_impl._M_end_of_storage;
+      __heap._M_impl._M_reset();
+      try {
+        __heap._M_impl._M_finish =
+            std::__uninitialized_move_a(__inl._M_impl._M_start, __inl._M_impl._M_finish,
+                                        __heap._M_impl._M_start,
+                                        _M_get_Tp_allocator());
+      }
+      catch(...) {
+        __heap._M_impl._M_start = __start;
+        __heap._M_impl._M_finish = __finish;
+        __heap._M_impl._M_end_of_storage = __end_of_storage;
+        throw;
+      }
+      __inl.clear();
+      __inl._M_impl._M_start = __start;
+      __inl._M_impl._M_finish = __finish;
+      __inl._M_impl._M_end_of_storage = __end_of_storage;
+    }
+    _Alloc_traits::_S_on_swap(_M_get_Tp_allocator(),
+                              __x._M_get_Tp_allocator());
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif /* _SMALL_VECTOR_TCC */
@@ -0,0 +1,172 @@
+// Single-allocation string concatenation -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/str_cat.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _STR_CAT_H
+#define _STR_CAT_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus >= 201703L
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Views the pieces str_cat and str_append accept as characters of
+  /// type _CharT: strings, string views, null-terminated strings and
+  /// single characters.
+  template <typename _CharT, typename _Traits>
+  struct _Str_cat_piece {
+    typedef std::basic_string_view<_CharT, _Traits> _View;
+
+    static _View
+    _S_view(_View __v) noexcept { return __v; }
+
+    static _View
+    _S_view(const _CharT* __s) noexcept { return _View(__s); }
+
+    template <typename _Alloc>
+    static _View
+    _S_view(const std::basic_string<_CharT, _Traits, _Alloc>& __s) noexcept { return _View(__s.data(), __s.size()); }
+
+    // Exactly _CharT, so the view never refers to a converted temporary.
+    template <typename _Up, typename = typename std::enable_if<std::is_same<_Up, _CharT>::value>::type>
+    static _View
+    _S_view(const _Up& __c) noexcept { return _View(&__c, 1); }
+  };
+
+  template <typename _Tp>
+  struct __str_cat_is_char : std::false_type {};
+
+  template <>
+  struct __str_cat_is_char<char> : std::true_type {};
+
+  template <>
+  struct __str_cat_is_char<wchar_t> : std::true_type {};
+
+#ifdef _GLIBCXX_USE_CHAR8_T
+  template <>
+  struct __str_cat_is_char<char8_t> : std::true_type {};
+#endif
+
+  template <>
+  struct __str_cat_is_char<char16_t> : std::true_type {};
+
+  template <>
+  struct __str_cat_is_char<char32_t> : std::true_type {};
+
+  /// Character and traits type of a piece, used to pick the result type
+  /// of str_cat from its first argument.
+  template <typename _Tp, typename = void>
+  struct __str_cat_traits {};
+
+  template <typename _CharT, typename _Traits, typename _Alloc>
+  struct __str_cat_traits<std::basic_string<_CharT, _Traits, _Alloc>> {
+    typedef _CharT char_type;
+    typedef _Traits traits_type;
+  };
+
+  template <typename _CharT, typename _Traits>
+  struct __str_cat_traits<std::basic_string_view<_CharT, _Traits>> {
+    typedef _CharT char_type;
+    typedef _Traits traits_type;
+  };
+
+  template <typename _CharT>
+  struct __str_cat_traits<_CharT*, typename std::enable_if<__str_cat_is_char<typename std::remove_const<_CharT>::type>::value>::type> {
+    typedef typename std::remove_const<_CharT>::type char_type;
+    typedef std::char_traits<char_type> traits_type;
+  };
+
+  template <typename _CharT>
+  struct __str_cat_traits<_CharT, typename std::enable_if<__str_cat_is_char<_CharT>::value>::type> {
+    typedef _CharT char_type;
+    typedef std::char_traits<_CharT> traits_type;
+  };
+
+  /**
+   *  @brief Appends all of @a __pieces to @a __str.
+   *
+   *  The total length is computed first, so @a __str grows at most once
+   *  and every piece is copied once.  Pieces may refer to @a __str.
+  */
+  template <typename _CharT, typename _Traits, typename _Alloc, typename... _Pieces>
+  std::basic_string<_CharT, _Traits, _Alloc>&
+  str_append(std::basic_string<_CharT, _Traits, _Alloc>& __str, const _Pieces&... __pieces) {
+    typedef _Str_cat_piece<_CharT, _Traits> _Piece;
+    typedef typename _Piece::_View _View;
+    const _View __views[] = {_View(), _Piece::_S_view(__pieces)...};
+
+    typename std::basic_string<_CharT, _Traits, _Alloc>::size_type __len = __str.size();
+    for (const _View& __v : __views)
+      __len += __v.size();
+
+    if (__len > __str.capacity()) {
+      // Growing would invalidate pieces that refer to __str, so build
+      // the result separately.
+      std::basic_string<_CharT, _Traits, _Alloc> __tmp(__str.get_allocator());
+      __tmp.reserve(__len);
+      __tmp.append(__str.data(), __str.size());
+      for (const _View& __v : __views)
+        __tmp.append(__v.data(), __v.size());
+      __str.swap(__tmp);
+    } else
+      for (const _View& __v : __views)
+        __str.append(__v.data(), __v.size());
+    return __str;
+  }
+
+  /**
+   *  @brief Concatenates @a __pieces into a new string with a single
+   *  allocation.
+   *
+   *  Accepts strings, string views, null-terminated strings and
+   *  characters, all of one character type; the result is a
+   *  std::basic_string of the character and traits type of the first
+   *  piece, with the default allocator.
+  */
+  template <typename _First, typename... _Pieces>
+  std::basic_string<typename __str_cat_traits<typename std::decay<_First>::type>::char_type,
+                    typename __str_cat_traits<typename std::decay<_First>::type>::traits_type>
+  str_cat(const _First& __first, const _Pieces&... __pieces) {
+    std::basic_string<typename __str_cat_traits<typename std::decay<_First>::type>::char_type,
+                      typename __str_cat_traits<typename std::decay<_First>::type>::traits_type>
+        __str;
+    str_append(__str, __first, __pieces...);
+    return __str;
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // C++17
+
+#endif // _STR_CAT_H
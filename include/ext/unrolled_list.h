@@ -0,0 +1,609 @@
+// Unrolled linked list -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/unrolled_list.h
+ *  This file is a GNU extension to the Standard C++ Library.
+ */
+
+#ifndef _UNROLLED_LIST_H
+#define _UNROLLED_LIST_H 1
+
+#pragma GCC system_header
+
+#if __cplusplus < 201103L
+#include <bits/c++0x_warning.h>
+#else
+
+#include <bits/stl_algobase.h>
+#include <bits/stl_construct.h>
+#include <bits/stl_iterator.h>
+#include <bits/stl_uninitialized.h>
+#include <ext/alloc_traits.h>
+#include <initializer_list>
+#include <memory>
+
+#include <debug/assertions.h>
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  /// Links and element count of an unrolled_list node.  The list header
+  /// is a bare _Unrolled_node_base with a count of zero.
+  struct _Unrolled_node_base {
+    _Unrolled_node_base* _M_next;
+    _Unrolled_node_base* _M_prev;
+    size_t _M_count;
+
+    void
+    _M_init() noexcept {
+      _M_next = _M_prev = this;
+      _M_count = 0;
+    }
+
+    // Links this node in before __position.
+    void
+    _M_hook(_Unrolled_node_base* __position) noexcept {
+      _M_next = __position;
+      _M_prev = __position->_M_prev;
+      __position->_M_prev->_M_next = this;
+      __position->_M_prev = this;
+    }
+
+    void
+    _M_unhook() noexcept {
+      _M_prev->_M_next = _M_next;
+      _M_next->_M_prev = _M_prev;
+    }
+  };
+
+  /// A node holding up to _Nm elements, constructed in [0, _M_count).
+  template <typename _Tp, size_t _Nm>
+  struct _Unrolled_node : public _Unrolled_node_base {
+    alignas(_Tp) unsigned char _M_storage[sizeof(_Tp) * _Nm];
+
+    _Tp*
+    _M_valptr(size_t __i) noexcept { return static_cast<_Tp*>(static_cast<void*>(_M_storage)) + __i; }
+
+    const _Tp*
+    _M_valptr(size_t __i) const noexcept { return static_cast<const _Tp*>(static_cast<const void*>(_M_storage)) + __i; }
+  };
+
+  /// Default number of elements per node: about four cache lines' worth.
+  template <typename _Tp>
+  constexpr size_t
+  __unrolled_list_node_size() noexcept { return sizeof(_Tp) < 64 ? 256 / sizeof(_Tp) : 4; }
+
+  /// Bidirectional iterator over the elements of an unrolled_list.
+  template <typename _Tp, size_t _Nm, bool _Const>
+  struct _Unrolled_list_iterator {
+    typedef _Unrolled_node<_Tp, _Nm> _Node;
+
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef _Tp value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::conditional<_Const, const _Tp*, _Tp*>::type pointer;
+    typedef typename std::conditional<_Const, const _Tp&, _Tp&>::type reference;
+
+    _Unrolled_node_base* _M_node;
+    size_t _M_idx;
+
+    _Unrolled_list_iterator() noexcept
+        : _M_node(), _M_idx() {}
+
+    _Unrolled_list_iterator(_Unrolled_node_base* __n, size_t __i) noexcept
+        : _M_node(__n), _M_idx(__i) {}
+
+    // iterator to const_iterator conversion
+    template <bool _C2, typename = typename std::enable_if<_Const && !_C2>::type>
+    _Unrolled_list_iterator(const _Unrolled_list_iterator<_Tp, _Nm, _C2>& __it) noexcept
+        : _M_node(__it._M_node), _M_idx(__it._M_idx) {}
+
+    reference
+    operator*() const noexcept { return *static_cast<_Node*>(_M_node)->_M_valptr(_M_idx); }
+
+    pointer
+    operator->() const noexcept { return static_cast<_Node*>(_M_node)->_M_valptr(_M_idx); }
+
+    _Unrolled_list_iterator&
+    operator++() noexcept {
+      if (++_M_idx == _M_node->_M_count) {
+        _M_node = _M_node->_M_next;
+        _M_idx = 0;
+      }
+      return *this;
+    }
+
+    _Unrolled_list_iterator
+    operator++(int) noexcept {
+      _Unrolled_list_iterator __tmp = *this;
+      ++*this;
+      return __tmp;
+    }
+
+    _Unrolled_list_iterator&
+    operator--() noexcept {
+      if (_M_idx == 0) {
+        _M_node = _M_node->_M_prev;
+        _M_idx = _M_node->_M_count;
+      }
+      --_M_idx;
+      return *this;
+    }
+
+    _Unrolled_list_iterator
+    operator--(int) noexcept {
+      _Unrolled_list_iterator __tmp = *this;
+      --*this;
+      return __tmp;
+    }
+
+    friend bool
+    operator==(const _Unrolled_list_iterator& __x, const _Unrolled_list_iterator& __y) noexcept { return __x._M_node == __y._M_node && __x._M_idx == __y._M_idx; }
+
+    friend bool
+    operator!=(const _Unrolled_list_iterator& __x, const _Unrolled_list_iterator& __y) noexcept { return !(__x == __y); }
+  };
+
+  /// Node allocation and the list header for unrolled_list.
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  struct _Unrolled_list_base {
+    typedef _Unrolled_node<_Tp, _Nm> _Node;
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Tp>::other _Tp_alloc_type;
+    typedef typename __alloc_traits<_Alloc>::template rebind<_Node>::other _Node_alloc_type;
+    typedef __alloc_traits<_Node_alloc_type> _Node_alloc_traits;
+
+    static_assert(std::is_pointer<typename _Node_alloc_traits::pointer>::value,
+                  "__gnu_cxx::unrolled_list requires an allocator with raw pointers");
+
+    struct _Unrolled_list_impl : public _Node_alloc_type {
+      _Unrolled_node_base _M_header;
+      size_t _M_size;
+
+      _Unrolled_list_impl() noexcept(std::is_nothrow_default_constructible<_Node_alloc_type>::value)
+          : _Node_alloc_type() { _M_reset(); }
+
+      _Unrolled_list_impl(const _Node_alloc_type& __a) noexcept
+          : _Node_alloc_type(__a) { _M_reset(); }
+
+      _Unrolled_list_impl(_Unrolled_list_impl&& __x) noexcept
+          : _Node_alloc_type(std::move(__x)) { _M_steal(__x); }
+
+      void
+      _M_reset() noexcept {
+        _M_header._M_init();
+        _M_size = 0;
+      }
+
+      // The first and last node point back at the header, so the links
+      // have to be redirected rather than copied.
+      void
+      _M_steal(_Unrolled_list_impl& __x) noexcept {
+        _Unrolled_node_base* const __xh = &__x._M_header;
+        if (__xh->_M_next == __xh)
+          _M_reset();
+        else {
+          _M_header = *__xh;
+          _M_header._M_next->_M_prev = _M_header._M_prev->_M_next = &_M_header;
+          _M_size = __x._M_size;
+          __x._M_reset();
+        }
+      }
+
+      void
+      _M_swap_data(_Unrolled_list_impl& __x) noexcept {
+        _Unrolled_list_impl __tmp(static_cast<_Node_alloc_type&>(*this));
+        __tmp._M_steal(__x);
+        __x._M_steal(*this);
+        _M_steal(__tmp);
+      }
+    };
+    // _Unrolled_list_impl =================================================
+
+    _Unrolled_list_impl _M_impl;
+
+    _Unrolled_list_base() = default;
+
+    _Unrolled_list_base(const _Node_alloc_type& __a) noexcept
+        : _M_impl(__a) {}
+
+    _Unrolled_list_base(_Unrolled_list_base&&) = default;
+
+    ~_Unrolled_list_base() noexcept { _M_deallocate_nodes(); }
+
+    _Node_alloc_type&
+    _M_get_Node_allocator() noexcept { return _M_impl; }
+
+    const _Node_alloc_type&
+    _M_get_Node_allocator() const noexcept { return _M_impl; }
+
+    // Allocates an empty node and links it in before __position.
+    _Node*
+    _M_create_node(_Unrolled_node_base* __position) {
+      _Node* __n = _Node_alloc_traits::allocate(_M_impl, 1);
+      __n->_M_count = 0;
+      __n->_M_hook(__position);
+      return __n;
+    }
+
+    void
+    _M_destroy_node(_Unrolled_node_base* __n) noexcept {
+      __n->_M_unhook();
+      _Node_alloc_traits::deallocate(_M_impl, static_cast<_Node*>(__n), 1);
+    }
+
+    void
+    _M_deallocate_nodes() noexcept {
+      _Unrolled_node_base* const __h = &_M_impl._M_header;
+      for (_Unrolled_node_base* __n = __h->_M_next; __n != __h;) {
+        _Unrolled_node_base* __next = __n->_M_next;
+        _Node_alloc_traits::deallocate(_M_impl, static_cast<_Node*>(__n), 1);
+        __n = __next;
+      }
+      _M_impl._M_reset();
+    }
+  };
+
+  /**
+   *  @brief A doubly linked list of nodes that each hold up to _Nm
+   *  elements in an array.
+   *
+   *  @tparam _Tp  Type of element.
+   *  @tparam _Nm  Maximum number of elements per node.
+   *  @tparam _Alloc  Allocator type.
+   *
+   *  Traversal touches one node, and usually one cache miss, per _Nm
+   *  elements instead of per element as std::list does, and the per
+   *  element overhead drops from two pointers to a fraction of one.
+   *  Insertion and erasure stay constant time: they shift at most _Nm
+   *  elements within a node, splitting a full node in two and merging a
+   *  node that drops below half full into its successor when they fit.
+   *
+   *  The price is weaker iterator stability: insertion and erasure
+   *  invalidate iterators, pointers and references to the elements of
+   *  the nodes they touch, which are the node of the position and its
+   *  neighbours.  Elements elsewhere in the list are not affected.
+  */
+  template <typename _Tp, size_t _Nm = __unrolled_list_node_size<_Tp>(), typename _Alloc = std::allocator<_Tp>>
+  class unrolled_list : protected _Unrolled_list_base<_Tp, _Nm, _Alloc> {
+    static_assert(_Nm >= 2, "__gnu_cxx::unrolled_list needs at least two elements per node");
+    static_assert(std::is_same<typename std::remove_cv<_Tp>::type, _Tp>::value,
+                  "__gnu_cxx::unrolled_list must have a non-const, non-volatile value_type");
+
+    typedef _Unrolled_list_base<_Tp, _Nm, _Alloc> _Base;
+    typedef typename _Base::_Node _Node;
+    typedef typename _Base::_Tp_alloc_type _Tp_alloc_type;
+    typedef typename _Base::_Node_alloc_type _Node_alloc_type;
+    typedef typename _Base::_Node_alloc_traits _Node_alloc_traits;
+    typedef __alloc_traits<_Tp_alloc_type> _Tp_alloc_traits;
+
+  public:
+    typedef _Tp value_type;
+    typedef _Tp* pointer;
+    typedef const _Tp* const_pointer;
+    typedef _Tp& reference;
+    typedef const _Tp& const_reference;
+    typedef _Unrolled_list_iterator<_Tp, _Nm, false> iterator;
+    typedef _Unrolled_list_iterator<_Tp, _Nm, true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef _Alloc allocator_type;
+
+  protected:
+    using _Base::_M_get_Node_allocator;
+    using _Base::_M_impl;
+
+  public:
+    unrolled_list() = default;
+
+    explicit unrolled_list(const allocator_type& __a) noexcept
+        : _Base(_Node_alloc_type(__a)) {}
+
+    explicit unrolled_list(size_type __n, const allocator_type& __a = allocator_type())
+        : _Base(_Node_alloc_type(__a)) {
+      for (; __n; --__n)
+        emplace_back();
+    }
+
+    unrolled_list(size_type __n, const value_type& __value,
+                  const allocator_type& __a = allocator_type())
+        : _Base(_Node_alloc_type(__a)) {
+      for (; __n; --__n)
+        emplace_back(__value);
+    }
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    unrolled_list(_InputIterator __first, _InputIterator __last,
+                  const allocator_type& __a = allocator_type())
+        : _Base(_Node_alloc_type(__a)) {
+      for (; __first != __last; ++__first)
+        emplace_back(*__first);
+    }
+
+    unrolled_list(std::initializer_list<value_type> __l,
+                  const allocator_type& __a = allocator_type())
+        : unrolled_list(__l.begin(), __l.end(), __a) {}
+
+    unrolled_list(const unrolled_list& __x)
+        : unrolled_list(__x.begin(), __x.end(),
+                        _Node_alloc_traits::_S_select_on_copy(__x._M_get_Node_allocator())) {}
+
+    unrolled_list(const unrolled_list& __x, const allocator_type& __a)
+        : unrolled_list(__x.begin(), __x.end(), __a) {}
+
+    unrolled_list(unrolled_list&&) noexcept = default;
+
+    unrolled_list(unrolled_list&& __x, const allocator_type& __a)
+        : _Base(_Node_alloc_type(__a)) {
+      if (_M_get_Node_allocator() == __x._M_get_Node_allocator())
+        _M_impl._M_steal(__x._M_impl);
+      else
+        for (iterator __i = __x.begin(); __i != __x.end(); ++__i)
+          emplace_back(std::move(*__i));
+    }
+
+    ~unrolled_list() noexcept { _M_destroy_elements(); }
+
+    unrolled_list&
+    operator=(const unrolled_list& __x);
+
+    unrolled_list&
+    operator=(unrolled_list&& __x) noexcept(_Node_alloc_traits::_S_nothrow_move());
+
+    unrolled_list&
+    operator=(std::initializer_list<value_type> __l) {
+      assign(__l.begin(), __l.end());
+      return *this;
+    }
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    void
+    assign(_InputIterator __first, _InputIterator __last) {
+      clear();
+      for (; __first != __last; ++__first)
+        emplace_back(*__first);
+    }
+
+    void
+    assign(size_type __n, const value_type& __value) {
+      clear();
+      for (; __n; --__n)
+        emplace_back(__value);
+    }
+
+    void
+    assign(std::initializer_list<value_type> __l) { assign(__l.begin(), __l.end()); }
+
+    allocator_type
+    get_allocator() const noexcept { return allocator_type(_M_get_Node_allocator()); }
+
+    // iterators
+    iterator
+    begin() noexcept { return iterator(_M_impl._M_header._M_next, 0); }
+
+    const_iterator
+    begin() const noexcept { return const_iterator(_M_impl._M_header._M_next, 0); }
+
+    iterator
+    end() noexcept { return iterator(&_M_impl._M_header, 0); }
+
+    const_iterator
+    end() const noexcept { return const_iterator(const_cast<_Unrolled_node_base*>(&_M_impl._M_header), 0); }
+
+    reverse_iterator
+    rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator
+    rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator
+    rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator
+    rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator
+    cbegin() const noexcept { return begin(); }
+
+    const_iterator
+    cend() const noexcept { return end(); }
+
+    const_reverse_iterator
+    crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator
+    crend() const noexcept { return rend(); }
+
+    // capacity
+    bool
+    empty() const noexcept { return _M_impl._M_size == 0; }
+
+    size_type
+    size() const noexcept { return _M_impl._M_size; }
+
+    size_type
+    max_size() const noexcept {
+      return std::min<size_type>(_Node_alloc_traits::max_size(_M_get_Node_allocator()), size_type(-1) / _Nm) * _Nm;
+    }
+
+    // element access
+    reference
+    front() noexcept {
+      __glibcxx_requires_nonempty();
+      return *begin();
+    }
+
+    const_reference
+    front() const noexcept {
+      __glibcxx_requires_nonempty();
+      return *begin();
+    }
+
+    reference
+    back() noexcept {
+      __glibcxx_requires_nonempty();
+      return *--end();
+    }
+
+    const_reference
+    back() const noexcept {
+      __glibcxx_requires_nonempty();
+      return *--end();
+    }
+
+    // modifiers
+    template <typename... _Args>
+    reference
+    emplace_front(_Args&&... __args) { return *emplace(cbegin(), std::forward<_Args>(__args)...); }
+
+    void
+    push_front(const value_type& __x) { emplace(cbegin(), __x); }
+
+    void
+    push_front(value_type&& __x) { emplace(cbegin(), std::move(__x)); }
+
+    template <typename... _Args>
+    reference
+    emplace_back(_Args&&... __args);
+
+    void
+    push_back(const value_type& __x) { emplace_back(__x); }
+
+    void
+    push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+    void
+    pop_front() {
+      __glibcxx_requires_nonempty();
+      erase(cbegin());
+    }
+
+    void
+    pop_back() {
+      __glibcxx_requires_nonempty();
+      erase(--cend());
+    }
+
+    template <typename... _Args>
+    iterator
+    emplace(const_iterator __position, _Args&&... __args);
+
+    iterator
+    insert(const_iterator __position, const value_type& __x) { return emplace(__position, __x); }
+
+    iterator
+    insert(const_iterator __position, value_type&& __x) { return emplace(__position, std::move(__x)); }
+
+    iterator
+    insert(const_iterator __position, size_type __n, const value_type& __x) {
+      for (size_type __i = 0; __i < __n; ++__i)
+        __position = ++emplace(__position, __x);
+      return _M_rewind(__position, __n);
+    }
+
+    template <typename _InputIterator, typename = std::_RequireInputIter<_InputIterator>>
+    iterator
+    insert(const_iterator __position, _InputIterator __first, _InputIterator __last) {
+      size_type __n = 0;
+      for (; __first != __last; ++__first, ++__n)
+        __position = ++emplace(__position, *__first);
+      return _M_rewind(__position, __n);
+    }
+
+    iterator
+    insert(const_iterator __position, std::initializer_list<value_type> __l) { return insert(__position, __l.begin(), __l.end()); }
+
+    iterator
+    erase(const_iterator __position);
+
+    iterator
+    erase(const_iterator __first, const_iterator __last) {
+      // Erasing can merge nodes, which moves the elements of [first, last)
+      // about, so count them instead of comparing against __last.
+      size_type __n = 0;
+      for (const_iterator __i = __first; __i != __last; ++__i)
+        ++__n;
+      iterator __ret(__first._M_node, __first._M_idx);
+      for (; __n; --__n)
+        __ret = erase(__ret);
+      return __ret;
+    }
+
+    void
+    swap(unrolled_list& __x) noexcept {
+      __glibcxx_assert(_Node_alloc_traits::propagate_on_container_swap::value || _M_get_Node_allocator() == __x._M_get_Node_allocator());
+      _M_impl._M_swap_data(__x._M_impl);
+      _Node_alloc_traits::_S_on_swap(_M_get_Node_allocator(), __x._M_get_Node_allocator());
+    }
+
+    void
+    clear() noexcept {
+      _M_destroy_elements();
+      this->_M_deallocate_nodes();
+    }
+
+  private:
+    void
+    _M_destroy_elements() noexcept {
+      if (!std::is_trivially_destructible<_Tp>::value)
+        for (iterator __i = begin(); __i != end(); ++__i)
+          _Node_alloc_traits::destroy(_M_impl, std::__addressof(*__i));
+    }
+
+    // Steps back __n elements from the end of an inserted range.
+    iterator
+    _M_rewind(const_iterator __position, size_type __n) noexcept {
+      for (; __n; --__n)
+        --__position;
+      return iterator(__position._M_node, __position._M_idx);
+    }
+
+    // Moves the upper half of the full node __n into a new node after it.
+    _Node*
+    _M_split(_Node* __n);
+  };
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator==(const unrolled_list<_Tp, _Nm, _Alloc>& __x, const unrolled_list<_Tp, _Nm, _Alloc>& __y) {
+    return __x.size() == __y.size() && std::equal(__x.begin(), __x.end(), __y.begin());
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline bool
+  operator!=(const unrolled_list<_Tp, _Nm, _Alloc>& __x, const unrolled_list<_Tp, _Nm, _Alloc>& __y) { return !(__x == __y); }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  inline void
+  swap(unrolled_list<_Tp, _Nm, _Alloc>& __x, unrolled_list<_Tp, _Nm, _Alloc>& __y) noexcept { __x.swap(__y); }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#include <ext/unrolled_list.tcc>
+
+#endif // C++11
+
+#endif // _UNROLLED_LIST_H
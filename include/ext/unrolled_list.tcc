@@ -0,0 +1,203 @@
+// Unrolled linked list -*- C++ -*-
+
+// Copyright (C) 2019 Free Software Foundation, Inc.
+//
+// This file is part of the GNU ISO C++ Library.  This library is free
+// software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the
+// Free Software Foundation; either version 3, or (at your option)
+// any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// Under Section 7 of GPL version 3, you are granted additional
+// permissions described in the GCC Runtime Library Exception, version
+// 3.1, as published by the Free Software Foundation.
+
+// You should have received a copy of the GNU General Public License and
+// a copy of the GCC Runtime Library Exception along with this program;
+// see the files COPYING3 and COPYING.RUNTIME respectively.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+/** @file ext/unrolled_list.tcc
+ *  This is an internal header file, included by other library headers.
+ *  Do not attempt to use it directly. @headername{ext/unrolled_list.h}
+ */
+
+#ifndef _UNROLLED_LIST_TCC
+#define _UNROLLED_LIST_TCC 1
+
+namespace __gnu_cxx _GLIBCXX_VISIBILITY(default) {
+  _GLIBCXX_BEGIN_NAMESPACE_VERSION
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  unrolled_list<_Tp, _Nm, _Alloc>&
+  unrolled_list<_Tp, _Nm, _Alloc>::
+  operator=(const unrolled_list& __x) {
+    if (&__x == this)
+      return *this;
+    clear();
+    if (_Node_alloc_traits::_S_propagate_on_copy_assign())
+      std::__alloc_on_copy(_M_get_Node_allocator(), __x._M_get_Node_allocator());
+    for (const_iterator __i = __x.begin(); __i != __x.end(); ++__i)
+      emplace_back(*__i);
+    return *this;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  unrolled_list<_Tp, _Nm, _Alloc>&
+  unrolled_list<_Tp, _Nm, _Alloc>::
+  operator=(unrolled_list&& __x) noexcept(_Node_alloc_traits::_S_nothrow_move()) {
+    if (&__x == this)
+      return *this;
+    clear();
+    if (_Node_alloc_traits::_S_propagate_on_move_assign() || _M_get_Node_allocator() == __x._M_get_Node_allocator()) {
+      std::__alloc_on_move(_M_get_Node_allocator(), __x._M_get_Node_allocator());
+      _M_impl._M_steal(__x._M_impl);
+    } else {
+      for (iterator __i = __x.begin(); __i != __x.end(); ++__i)
+        emplace_back(std::move(*__i));
+      __x.clear();
+    }
+    return *this;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  typename unrolled_list<_Tp, _Nm, _Alloc>::reference
+  unrolled_list<_Tp, _Nm, _Alloc>::
+      emplace_back(_Args&&... __args) {
+    _Unrolled_node_base* const __h = &_M_impl._M_header;
+    _Node* __n = static_cast<_Node*>(__h->_M_prev);
+    if (__n == __h || __n->_M_count == _Nm)
+      __n = this->_M_create_node(__h);
+    _Tp* const __p = __n->_M_valptr(__n->_M_count);
+    try {
+      _Node_alloc_traits::construct(_M_impl, __p, std::forward<_Args>(__args)...);
+    } catch (...) {
+      if (__n->_M_count == 0)
+        this->_M_destroy_node(__n);
+      throw;
+    }
+    ++__n->_M_count;
+    ++_M_impl._M_size;
+    return *__p;
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  template <typename... _Args>
+  typename unrolled_list<_Tp, _Nm, _Alloc>::iterator
+  unrolled_list<_Tp, _Nm, _Alloc>::
+      emplace(const_iterator __position, _Args&&... __args) {
+    _Unrolled_node_base* const __h = &_M_impl._M_header;
+    _Unrolled_node_base* __b = __position._M_node;
+    size_t __i = __position._M_idx;
+    // At the start of a node, appending to the previous one saves the
+    // shift; this is also how insertion at end() reaches the last node.
+    if (__i == 0 && __b->_M_prev != __h && __b->_M_prev->_M_count < _Nm) {
+      __b = __b->_M_prev;
+      __i = __b->_M_count;
+    } else if (__b == __h) {
+      emplace_back(std::forward<_Args>(__args)...);
+      return iterator(__h->_M_prev, __h->_M_prev->_M_count - 1);
+    }
+
+    _Node* __n = static_cast<_Node*>(__b);
+    if (__i == __n->_M_count && __i < _Nm) {
+      _Node_alloc_traits::construct(_M_impl, __n->_M_valptr(__i), std::forward<_Args>(__args)...);
+      ++__n->_M_count;
+      ++_M_impl._M_size;
+      return iterator(__n, __i);
+    }
+
+    // The arguments may refer to an element of the node, which the split
+    // and the shift below move, so build the new value first.
+    _Tp __tmp(std::forward<_Args>(__args)...);
+    if (__n->_M_count == _Nm) {
+      _Node* __m = _M_split(__n);
+      if (__i > __n->_M_count) {
+        __i -= __n->_M_count;
+        __n = __m;
+      }
+    }
+
+    _Tp* const __p = __n->_M_valptr(0);
+    const size_t __count = __n->_M_count;
+    if (__i == __count)
+      _Node_alloc_traits::construct(_M_impl, __p + __i, std::move(__tmp));
+    else {
+      _Node_alloc_traits::construct(_M_impl, __p + __count, std::move(__p[__count - 1]));
+      try {
+        std::move_backward(__p + __i, __p + __count - 1, __p + __count);
+        __p[__i] = std::move(__tmp);
+      } catch (...) {
+        _Node_alloc_traits::destroy(_M_impl, __p + __count);
+        throw;
+      }
+    }
+    ++__n->_M_count;
+    ++_M_impl._M_size;
+    return iterator(__n, __i);
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  typename unrolled_list<_Tp, _Nm, _Alloc>::iterator
+  unrolled_list<_Tp, _Nm, _Alloc>::
+      erase(const_iterator __position) {
+    _Unrolled_node_base* const __h = &_M_impl._M_header;
+    _Node* const __n = static_cast<_Node*>(__position._M_node);
+    const size_t __i = __position._M_idx;
+    _Tp* const __p = __n->_M_valptr(0);
+    std::move(__p + __i + 1, __p + __n->_M_count, __p + __i);
+    --__n->_M_count;
+    --_M_impl._M_size;
+    _Node_alloc_traits::destroy(_M_impl, __p + __n->_M_count);
+
+    if (__n->_M_count == 0) {
+      _Unrolled_node_base* const __next = __n->_M_next;
+      this->_M_destroy_node(__n);
+      return iterator(__next, 0);
+    }
+
+    // Keep nodes at least half full where possible by pulling in the
+    // next node, unless moving its elements could throw halfway.
+    _Unrolled_node_base* const __next = __n->_M_next;
+    if (std::is_nothrow_move_constructible<_Tp>::value && __n->_M_count < _Nm / 2 && __next != __h && __n->_M_count + __next->_M_count <= _Nm) {
+      _Node* const __m = static_cast<_Node*>(__next);
+      _Tp* const __q = __m->_M_valptr(0);
+      std::__uninitialized_move_a(__q, __q + __m->_M_count, __p + __n->_M_count, _M_get_Node_allocator());
+      std::_Destroy(__q, __q + __m->_M_count, _M_get_Node_allocator());
+      __n->_M_count += __m->_M_count;
+      this->_M_destroy_node(__m);
+    }
+    if (__i == __n->_M_count)
+      return iterator(__n->_M_next, 0);
+    return iterator(__n, __i);
+  }
+
+  template <typename _Tp, size_t _Nm, typename _Alloc>
+  typename unrolled_list<_Tp, _Nm, _Alloc>::_Node*
+  unrolled_list<_Tp, _Nm, _Alloc>::
+      _M_split(_Node* __n) {
+    const size_t __keep = _Nm - _Nm / 2;
+    _Node* const __m = this->_M_create_node(__n->_M_next);
+    _Tp* const __p = __n->_M_valptr(0);
+    try {
+      std::__uninitialized_move_if_noexcept_a(__p + __keep, __p + _Nm, __m->_M_valptr(0), _M_get_Node_allocator());
+    } catch (...) {
+      this->_M_destroy_node(__m);
+      throw;
+    }
+    std::_Destroy(__p + __keep, __p + _Nm, _M_get_Node_allocator());
+    __m->_M_count = _Nm - __keep;
+    __n->_M_count = __keep;
+    return __m;
+  }
+
+  _GLIBCXX_END_NAMESPACE_VERSION
+} // namespace )
+
+#endif // _UNROLLED_LIST_TCC
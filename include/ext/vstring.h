@@ -38,6 +38,7 @@
 #include <ext/vstring_util.h>
 #include <ext/rc_string_base.h>
 #include <ext/sso_string_base.h>
+#include <ext/compact_string_base.h>
 
 namespace __gnu_cxx _GLIBCXX_VISIBILITY(default)
 {
@@ -2955,6 +2956,16 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
                                      __s.length() * sizeof(char32_t)); }
     };
 
+  /// std::hash specialization for __compact_string.
+  template<>
+    struct hash<__gnu_cxx::__compact_string>
+    : public __hash_base<size_t, __gnu_cxx::__compact_string>
+    {
+      size_t
+      operator()(const __gnu_cxx::__compact_string& __s) const noexcept
+      { return std::_Hash_impl::hash(__s.data(), __s.length()); }
+    };
+
 _GLIBCXX_END_NAMESPACE_VERSION
 } // namespace
 
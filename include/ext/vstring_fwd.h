@@ -46,6 +46,9 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
   template<typename _CharT, typename _Traits, typename _Alloc>
     class __rc_string_base;
 
+  template<typename _CharT, typename _Traits, typename _Alloc>
+    class __compact_string_base;
+
   template<typename _CharT, typename _Traits = std::char_traits<_CharT>,
            typename _Alloc = std::allocator<_CharT>,
 	   template
@@ -57,6 +60,9 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
   typedef 
   __versa_string<char, std::char_traits<char>,
 		 std::allocator<char>, __rc_string_base>    __rc_string;
+  typedef
+  __versa_string<char, std::char_traits<char>,
+		 std::allocator<char>, __compact_string_base> __compact_string;
 
 #ifdef _GLIBCXX_USE_WCHAR_T
   typedef __versa_string<wchar_t>                           __wvstring;
@@ -64,6 +70,10 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
   typedef
   __versa_string<wchar_t, std::char_traits<wchar_t>,
 		 std::allocator<wchar_t>, __rc_string_base> __wrc_string;
+  typedef
+  __versa_string<wchar_t, std::char_traits<wchar_t>,
+		 std::allocator<wchar_t>, __compact_string_base>
+							    __wcompact_string;
 #endif  
 
 #if __cplusplus >= 201103L
@@ -72,12 +82,20 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
   typedef 
   __versa_string<char16_t, std::char_traits<char16_t>,
 		 std::allocator<char16_t>, __rc_string_base> __u16rc_string;
+  typedef
+  __versa_string<char16_t, std::char_traits<char16_t>,
+		 std::allocator<char16_t>, __compact_string_base>
+							    __u16compact_string;
 
   typedef __versa_string<char32_t>                          __u32vstring;
   typedef __u32vstring                                      __u32sso_string;
   typedef 
   __versa_string<char32_t, std::char_traits<char32_t>,
 		 std::allocator<char32_t>, __rc_string_base> __u32rc_string;
+  typedef
+  __versa_string<char32_t, std::char_traits<char32_t>,
+		 std::allocator<char32_t>, __compact_string_base>
+							    __u32compact_string;
 #endif // C++11
 
 _GLIBCXX_END_NAMESPACE_VERSION